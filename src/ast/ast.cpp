@@ -1,9 +1,225 @@
 #include "ast/ast.h"
 
+#include "ast/traversal.h"
+
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <memory>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace soul::ast
 {
+	namespace
+	{
+		/**
+		 * @brief Constructs a node in the current ASTArena or, if there is none, on the heap, and counts the errors
+		 * in its (sub-) tree.
+		 */
+		template <NodeKind Node, typename... Args>
+		ASTNode::Dependency create_node(Args&&... args)
+		{
+			ASTNode::Dependency node{};
+			if (const auto& arena = ASTArena::current()) {
+				node = ASTNode::Dependency{ arena->create<Node>(std::forward<Args>(args)...) };
+			} else {
+				node = ASTNode::Dependency{ new Node(std::forward<Args>(args)...) };
+			}
+			node->update_errors();
+			return node;
+		}
+
+		constexpr std::size_t k_hash_multiplier = 0x9E3779B97F4A7C15ULL;
+
+		/** @brief Mixes the value into the hash. */
+		constexpr void combine(std::size_t& hash, std::size_t value) noexcept
+		{
+			hash = (std::rotl(hash, 29) ^ value) * k_hash_multiplier;
+		}
+
+		std::size_t hash_of(const Symbol& symbol) noexcept
+		{
+			// NOTE: Hashes the name (instead of the id), thus the hash does not depend on the order of interning.
+			return std::hash<std::string_view>{}(symbol.view());
+		}
+
+		std::size_t hash_of(const Value& value) noexcept
+		{
+			std::size_t result = 0;
+			if (value.is<bool>()) {
+				combine(result, 1);
+				combine(result, static_cast<std::size_t>(value.get<bool>()));
+			} else if (value.is<i64>()) {
+				combine(result, 2);
+				combine(result, static_cast<std::size_t>(value.get<i64>()));
+			} else if (value.is<f64>()) {
+				combine(result, 3);
+				combine(result, std::hash<f64>{}(value.get<f64>()));
+			} else if (value.is<std::string>()) {
+				combine(result, 4);
+				combine(result, std::hash<std::string>{}(value.get<std::string>()));
+			} else if (value.is<char>()) {
+				combine(result, 5);
+				combine(result, static_cast<std::size_t>(value.get<char>()));
+			} else if (value.is<Symbol>()) {
+				combine(result, 6);
+				combine(result, hash_of(value.get<Symbol>()));
+			}
+			return result;
+		}
+
+		std::size_t hash_of(const types::Type& type) noexcept
+		{
+			std::size_t result = 0;
+			if (type.is<types::ArrayType>()) {
+				combine(result, 1);
+				combine(result, hash_of(type.as<types::ArrayType>().data_type()));
+			} else if (type.is<types::StructType>()) {
+				combine(result, 2);
+				for (const auto& contained_type : type.as<types::StructType>().types) {
+					combine(result, hash_of(contained_type));
+				}
+			} else {
+				combine(result, static_cast<std::size_t>(type.as<types::PrimitiveType>().type));
+			}
+			return result;
+		}
+
+		/** @brief Returns the hash of the node itself, i.e. excluding its dependencies (but not their count). */
+		std::size_t hash_of(const ASTNode& node) noexcept
+		{
+			std::size_t result = 0;
+			combine(result, static_cast<std::size_t>(node.kind()));
+			combine(result, hash_of(node.type));
+			switch (node.kind()) {
+				case ASTNode::Kind::BinaryNode:
+					combine(result, static_cast<std::size_t>(node.as<BinaryNode>().op));
+					break;
+				case ASTNode::Kind::BlockNode:
+					combine(result, node.as<BlockNode>().statements.size());
+					break;
+				case ASTNode::Kind::CastNode:
+					combine(result, hash_of(node.as<CastNode>().type_identifier));
+					break;
+				case ASTNode::Kind::ErrorNode:
+					combine(result, std::hash<std::string>{}(node.as<ErrorNode>().message));
+					break;
+				case ASTNode::Kind::ForLoopNode:
+				case ASTNode::Kind::ForeachLoopNode:
+				case ASTNode::Kind::IfNode:
+				case ASTNode::Kind::ReturnNode:
+				case ASTNode::Kind::WhileNode:
+					break;
+				case ASTNode::Kind::FunctionCallNode: {
+					const auto& function_call = node.as<FunctionCallNode>();
+					combine(result, hash_of(function_call.name));
+					combine(result, function_call.parameters.size());
+					break;
+				}
+				case ASTNode::Kind::FunctionDeclarationNode: {
+					const auto& function_declaration = node.as<FunctionDeclarationNode>();
+					combine(result, hash_of(function_declaration.name));
+					combine(result, hash_of(function_declaration.type_identifier));
+					combine(result, function_declaration.parameters.size());
+					break;
+				}
+				case ASTNode::Kind::LiteralNode: {
+					const auto& literal = node.as<LiteralNode>();
+					combine(result, static_cast<std::size_t>(literal.literal_type));
+					combine(result, hash_of(literal.value));
+					break;
+				}
+				case ASTNode::Kind::LoopControlNode:
+					combine(result, static_cast<std::size_t>(node.as<LoopControlNode>().control_type));
+					break;
+				case ASTNode::Kind::ModuleNode: {
+					const auto& module = node.as<ModuleNode>();
+					combine(result, hash_of(module.name));
+					combine(result, module.statements.size());
+					break;
+				}
+				case ASTNode::Kind::StructDeclarationNode: {
+					const auto& struct_declaration = node.as<StructDeclarationNode>();
+					combine(result, hash_of(struct_declaration.name));
+					combine(result, struct_declaration.parameters.size());
+					break;
+				}
+				case ASTNode::Kind::UnaryNode:
+					combine(result, static_cast<std::size_t>(node.as<UnaryNode>().op));
+					break;
+				case ASTNode::Kind::VariableDeclarationNode: {
+					const auto& variable_declaration = node.as<VariableDeclarationNode>();
+					combine(result, hash_of(variable_declaration.name));
+					combine(result, hash_of(variable_declaration.type_identifier));
+					combine(result, static_cast<std::size_t>(variable_declaration.is_mutable));
+					break;
+				}
+			}
+			return result;
+		}
+	}  // namespace
+
+	void ASTNode::Deleter::operator()(ASTNode* node) const noexcept
+	{
+		if (node->_is_arena_allocated
+		    || std::atomic_ref{ node->_references }.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+			return;
+		}
+
+		// NOTE: Deleting the node releases its dependencies (through this deleter), which are only queued up, thus
+		// the outermost call deletes the whole tree without recursing into it.
+		thread_local std::vector<ASTNode*> t_pending{};
+		thread_local bool                  t_is_deleting = false;
+		t_pending.push_back(node);
+		if (t_is_deleting) {
+			return;
+		}
+
+		t_is_deleting = true;
+		while (!t_pending.empty()) {
+			auto* pending = t_pending.back();
+			t_pending.pop_back();
+			delete pending;
+		}
+		t_is_deleting = false;
+	}
+
+	std::size_t ASTNode::hash() const
+	{
+		if (_hash != 0) {
+			return _hash;
+		}
+
+		// NOTE: Subtrees which were hashed already are skipped, thus only the modified part of the tree is rehashed.
+		thread_local TraversalStack t_traversal{};
+		t_traversal.traverse(
+			const_cast<ASTNode*>(this),
+			[](const ASTNode& node) { return node._hash == 0; },
+			[](ASTNode& node) {
+				auto result = hash_of(node);
+				for_each_dependency(node, [&result](const Dependency& dependency) {
+					combine(result, dependency ? dependency->_hash : 0);
+				});
+				// Zero is reserved for the hashes which were not computed yet.
+				node._hash = result != 0 ? result : 1;
+			});
+		return _hash;
+	}
+
+	void ASTNode::update_errors() noexcept
+	{
+		u32 errors = is<ErrorNode>() ? 1 : 0;
+		for_each_dependency(*this, [&errors](const Dependency& dependency) {
+			if (dependency) {
+				errors += dependency->_errors;
+			}
+		});
+		_errors = errors;
+	}
+
 	std::string_view ASTNode::name(const ASTNode::Operator op) noexcept
 	{
 		using namespace std::string_view_literals;
@@ -105,14 +321,14 @@ namespace soul::ast
 
 	BinaryNode::Dependency BinaryNode::create(Dependency lhs, Dependency rhs, Operator op)
 	{
-		return std::make_unique<BinaryNode>(std::move(lhs), std::move(rhs), op);
+		return create_node<BinaryNode>(std::move(lhs), std::move(rhs), op);
 	}
 
 	BlockNode::BlockNode(Dependencies dependencies) : statements(std::move(dependencies)) {}
 
 	BlockNode::Dependency BlockNode::create(BlockNode::Dependencies statements)
 	{
-		return std::make_unique<BlockNode>(std::move(statements));
+		return create_node<BlockNode>(std::move(statements));
 	}
 
 	CastNode::CastNode(Dependency expression, Identifier type_identifier)
@@ -122,14 +338,14 @@ namespace soul::ast
 
 	CastNode::Dependency CastNode::create(Dependency expression, Identifier type_identifier)
 	{
-		return std::make_unique<CastNode>(std::move(expression), std::move(type_identifier));
+		return create_node<CastNode>(std::move(expression), std::move(type_identifier));
 	}
 
 	ErrorNode::ErrorNode(ErrorNode::Message message) : message(std::move(message)) {}
 
 	ASTNode::Dependency ErrorNode::create(ErrorNode::Message message)
 	{
-		return std::make_unique<ErrorNode>(std::move(message));
+		return create_node<ErrorNode>(std::move(message));
 	}
 
 	ForLoopNode::ForLoopNode(Dependency initialization,
@@ -148,7 +364,7 @@ namespace soul::ast
 	                                            Dependency update,
 	                                            ScopeBlock statements)
 	{
-		return std::make_unique<ForLoopNode>(
+		return create_node<ForLoopNode>(
 			std::move(initialization), std::move(condition), std::move(update), std::move(statements));
 	}
 
@@ -161,7 +377,7 @@ namespace soul::ast
 	                                                    Dependency in_expression,
 	                                                    ScopeBlock statements)
 	{
-		return std::make_unique<ForeachLoopNode>(std::move(variable), std::move(in_expression), std::move(statements));
+		return create_node<ForeachLoopNode>(std::move(variable), std::move(in_expression), std::move(statements));
 	}
 
 	FunctionCallNode::FunctionCallNode(Identifier name, Dependencies parameters)
@@ -171,7 +387,7 @@ namespace soul::ast
 
 	FunctionCallNode::Dependency FunctionCallNode::create(Identifier name, Dependencies parameters)
 	{
-		return std::make_unique<FunctionCallNode>(std::move(name), std::move(parameters));
+		return create_node<FunctionCallNode>(std::move(name), std::move(parameters));
 	}
 
 	FunctionDeclarationNode::FunctionDeclarationNode(Identifier   identifier,
@@ -190,7 +406,7 @@ namespace soul::ast
 	                                                                    Dependencies parameters,
 	                                                                    ScopeBlock   statements)
 	{
-		return std::make_unique<FunctionDeclarationNode>(
+		return create_node<FunctionDeclarationNode>(
 			std::move(name), std::move(return_type), std::move(parameters), std::move(statements));
 	}
 
@@ -203,14 +419,14 @@ namespace soul::ast
 
 	IfNode::Dependency IfNode::create(Dependency condition, ScopeBlock then_statements, ScopeBlock else_statements)
 	{
-		return std::make_unique<IfNode>(std::move(condition), std::move(then_statements), std::move(else_statements));
+		return create_node<IfNode>(std::move(condition), std::move(then_statements), std::move(else_statements));
 	}
 
 	LiteralNode::LiteralNode(Value value, Type literal_type) : value(std::move(value)), literal_type(literal_type) {}
 
 	LiteralNode::Dependency LiteralNode::create(Value value, Type literal_type)
 	{
-		return std::make_unique<LiteralNode>(std::move(value), literal_type);
+		return create_node<LiteralNode>(std::move(value), literal_type);
 	}
 
 	LiteralNode::operator std::string() const noexcept { return std::string(value); }
@@ -240,24 +456,28 @@ namespace soul::ast
 
 	LoopControlNode::Dependency LoopControlNode::create(Type control_type)
 	{
-		return std::make_unique<LoopControlNode>(control_type);
+		return create_node<LoopControlNode>(control_type);
 	}
 
-	ModuleNode::ModuleNode(Identifier module_name, Dependencies statements) noexcept
-		: name(std::move(module_name)), statements(std::move(statements))
+	ModuleNode::ModuleNode(Identifier module_name, Dependencies statements, SourceBuffer::Handle source) noexcept
+		: name(std::move(module_name)), statements(std::move(statements)), source(std::move(source))
 	{
 	}
 
-	ASTNode::Dependency ModuleNode::create(Identifier module_name, Dependencies statements)
+	ASTNode::Dependency ModuleNode::create(Identifier module_name, Dependencies statements, SourceBuffer::Handle source)
 	{
-		return std::make_unique<ModuleNode>(std::move(module_name), std::move(statements));
+		// NOTE: Module itself is always allocated on the heap, as it (shares) ownership of the arena.
+		auto module   = std::make_unique<ModuleNode>(std::move(module_name), std::move(statements), std::move(source));
+		module->arena = ASTArena::current();
+		module->update_errors();
+		return Dependency{ module.release() };
 	}
 
 	ReturnNode::ReturnNode(Dependency expression) : expression(std::move(expression)) {}
 
 	ReturnNode::Dependency ReturnNode::create(Dependency expression)
 	{
-		return std::make_unique<ReturnNode>(std::move(expression));
+		return create_node<ReturnNode>(std::move(expression));
 	}
 
 	StructDeclarationNode::StructDeclarationNode(Identifier name, Dependencies parameters)
@@ -267,14 +487,14 @@ namespace soul::ast
 
 	StructDeclarationNode::Dependency StructDeclarationNode::create(Identifier name, Dependencies parameters)
 	{
-		return std::make_unique<StructDeclarationNode>(std::move(name), std::move(parameters));
+		return create_node<StructDeclarationNode>(std::move(name), std::move(parameters));
 	}
 
 	UnaryNode::UnaryNode(Dependency expr, Operator op) : op(op), expression(std::move(expr)) {}
 
 	UnaryNode::Dependency UnaryNode::create(Dependency expr, Operator op)
 	{
-		return std::make_unique<UnaryNode>(std::move(expr), op);
+		return create_node<UnaryNode>(std::move(expr), op);
 	}
 
 	VariableDeclarationNode::VariableDeclarationNode(Identifier name, Identifier type, Dependency expr, bool is_mutable)
@@ -287,7 +507,7 @@ namespace soul::ast
 	                                                                    Dependency expr,
 	                                                                    bool       is_mutable)
 	{
-		return std::make_unique<VariableDeclarationNode>(std::move(name), std::move(type), std::move(expr), is_mutable);
+		return create_node<VariableDeclarationNode>(std::move(name), std::move(type), std::move(expr), is_mutable);
 	}
 
 	WhileNode::WhileNode(ASTNode::Dependency condition, ASTNode::ScopeBlock statements) noexcept
@@ -297,6 +517,6 @@ namespace soul::ast
 
 	ASTNode::Dependency WhileNode::create(ASTNode::Dependency condition, ASTNode::ScopeBlock statements)
 	{
-		return std::make_unique<WhileNode>(std::move(condition), std::move(statements));
+		return create_node<WhileNode>(std::move(condition), std::move(statements));
 	}
 }  // namespace soul::ast
@@ -1,15 +1,20 @@
 #pragma once
 
+#include "ast/ast_arena.h"
 #include "ast/ast_fwd.h"
 #include "ast/visitors/visitor.h"
+#include "common/source_buffer.h"
+#include "common/symbol.h"
 #include "common/types/type.h"
 #include "common/value.h"
 #include "core/types.h"
 #include "lexer/token.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace soul::ast
@@ -34,24 +39,133 @@ namespace soul::ast
 	class ASTNode : public IVisitable
 	{
 		public:
-		using Dependency   = std::unique_ptr<ASTNode>;
-		using Dependencies = std::vector<Dependency>;
+		struct Deleter;
+		using Dependency   = std::unique_ptr<ASTNode, Deleter>;
+		using Dependencies = std::vector<Dependency, ArenaAllocator<Dependency>>;
 		using Reference    = ASTNode*;
-		using Identifier   = std::string;
+		using Identifier   = Symbol;
 		using ScopeBlock   = Dependency;
 		enum class Operator : u8;
 
+		/**
+		 * @brief Tag identifying the concrete type of a node, which is set once (by VisitorAcceptor) on construction.
+		 */
+		enum class Kind : u8
+		{
+#define SOUL_AST_NODE(name) name,
+			SOUL_AST_NODES
+#undef SOUL_AST_NODE
+		};
+
+		/**
+		 * @brief Deletes nodes allocated on the heap once their last reference is released (see ASTNode::share); nodes
+		 * owned by an ASTArena are released alongside it instead.
+		 * @details Dependencies of the deleted node are deleted in a loop (instead of recursively), thus trees of any
+		 * depth can be released.
+		 */
+		struct Deleter
+		{
+			void operator()(ASTNode* node) const noexcept;
+		};
+
 		public:
 		types::Type type = {};
 
+		private:
+		Kind                _kind;
+		bool                _is_arena_allocated = false;
+		mutable u32         _references         = 1;  // Number of trees referring to the node (counted atomically).
+		u32                 _errors             = 0;  // Number of ErrorNodes in the (sub-) tree, see ASTNode::errors.
+		mutable std::size_t _hash               = 0;  // Cached structural hash (see ASTNode::hash), or zero.
+
+		protected:
+		explicit constexpr ASTNode(Kind kind) noexcept : _kind(kind) {}
+
 		public:
 		virtual ~ASTNode() = default;
 
+		/** @brief Returns tag identifying the concrete type of the node. */
+		[[nodiscard]] constexpr Kind kind() const noexcept { return _kind; }
+
+		/** @brief Returns tag identifying a given type of the node. */
+		template <NodeKind Node>
+		[[nodiscard]] static consteval Kind kind_of() noexcept
+		{
+#define SOUL_AST_NODE(name)                   \
+	if constexpr (std::same_as<Node, name>) { \
+		return Kind::name;                    \
+	} else
+			SOUL_AST_NODES
+#undef SOUL_AST_NODE
+			{
+				std::unreachable();
+			}
+		}
+
+		/** @brief Verifies if node is owned by an ASTArena (instead of its parent). */
+		[[nodiscard]] bool is_arena_allocated() const noexcept { return _is_arena_allocated; }
+
+		/**
+		 * @brief Returns another reference to the node, thus the node (alongside its dependencies) becomes shared
+		 * between the trees, instead of being copied.
+		 * @details References are counted atomically, thus trees sharing their nodes might be released (and rewritten,
+		 * see RewriteVisitor) on separate threads. Any other state of the shared nodes is not synchronized, e.g. their
+		 * cached hashes (see ASTNode::hash) must be computed before these are used concurrently.
+		 * @important Shared nodes must not be modified, see ASTNode::is_shared.
+		 */
+		[[nodiscard]] Dependency share() const noexcept
+		{
+			std::atomic_ref{ _references }.fetch_add(1, std::memory_order_relaxed);
+			return Dependency{ const_cast<ASTNode*>(this) };
+		}
+
+		/**
+		 * @brief Verifies if the node is referred to by more than one tree, i.e. must be copied before being modified.
+		 * @note References to nodes owned by an ASTArena are not released, thus these remain shared once they were.
+		 */
+		[[nodiscard]] bool is_shared() const noexcept
+		{
+			return std::atomic_ref{ _references }.load(std::memory_order_acquire) > 1;
+		}
+
+		/**
+		 * @brief Returns the structural hash of the (sub-) tree, i.e. of the kinds, operators, values, identifiers and
+		 * types of the node and its dependencies, thus structurally equal trees have equal hashes.
+		 * @details Hash is computed bottom-up (without recursion) on the first call, and is cached in each node of the
+		 * tree afterwards, thus subsequent calls (for the node or any of its dependencies) are O(1).
+		 */
+		[[nodiscard]] std::size_t hash() const;
+
+		/**
+		 * @brief Discards the cached hash of the node, which has to be done whenever the node is modified.
+		 * @note RewriteVisitor does so for each node it visits, but the ancestors of a modified node (if these were
+		 * not visited) have to be invalidated by the caller.
+		 */
+		void invalidate_hash() const noexcept { _hash = 0; }
+
+		/**
+		 * @brief Returns number of ErrorNodes in the (sub-) tree, i.e. the node itself and its dependencies.
+		 * @details Count is propagated upwards as the nodes are created (and rewritten, see ASTNode::update_errors),
+		 * thus checking if the tree is well formed does not require traversing it.
+		 */
+		[[nodiscard]] u32 errors() const noexcept { return _errors; }
+
+		/** @brief Verifies if the (sub-) tree contains any ErrorNodes, see ASTNode::errors. */
+		[[nodiscard]] bool has_errors() const noexcept { return _errors != 0; }
+
+		/**
+		 * @brief Recounts the ErrorNodes in the (sub-) tree from the (already counted) dependencies, which has to be
+		 * done whenever any of them is replaced.
+		 * @note RewriteVisitor does so for each node it visits, but the ancestors of a modified node (if these were
+		 * not visited) have to be updated by the caller, from the bottom up.
+		 */
+		void update_errors() noexcept;
+
 		/** @brief Verifies if node is of a given type. */
 		template <NodeKind Node>
 		constexpr bool is() const noexcept
 		{
-			return dynamic_cast<const Node*>(this) != nullptr;
+			return _kind == kind_of<Node>();
 		}
 
 		/**
@@ -62,12 +176,25 @@ namespace soul::ast
 		template <NodeKind Node>
 		constexpr Node& as() noexcept
 		{
-			return dynamic_cast<Node&>(*this);
+			return static_cast<Node&>(*this);
+		}
+
+		/**
+		 * @brief Returns the underlying node.
+		 * @important Does not perform any validation - assumes that ASTNode::is<T> was used first.
+		 * @tparam T Type satisfying the NodeKind concept.
+		 */
+		template <NodeKind Node>
+		constexpr const Node& as() const noexcept
+		{
+			return static_cast<const Node&>(*this);
 		}
 
 		static std::string_view name(const Operator op) noexcept;
 		static std::string_view internal_name(const Operator op) noexcept;
 		static Operator         as_operator(Token::Type) noexcept;
+
+		friend ASTArena;
 	};
 
 	/**
@@ -78,6 +205,9 @@ namespace soul::ast
 	template <NodeKind Node>
 	class VisitorAcceptor : public ASTNode
 	{
+		protected:
+		constexpr VisitorAcceptor() noexcept : ASTNode(kind_of<Node>()) {}
+
 		private:
 		void accept(visitors::IVisitor& visitor) override { visitor.visit(static_cast<Node&>(*this)); }
 		void accept(visitors::IVisitor& visitor) const override { visitor.visit(static_cast<const Node&>(*this)); }
@@ -431,20 +561,23 @@ namespace soul::ast
 	class ModuleNode : public VisitorAcceptor<ModuleNode>
 	{
 		public:
-		Identifier   name;
-		Dependencies statements;
+		ASTArena::Handle     arena;  // Arena owning the nodes of the module (if any); declared first, thus outlives them.
+		Identifier           name;
+		Dependencies         statements;
+		SourceBuffer::Handle source;  // Script the module was compiled from; kept alive for as long as the module.
 
 		public:
-		explicit ModuleNode(Identifier module_name, Dependencies statements) noexcept;
+		explicit ModuleNode(Identifier module_name, Dependencies statements, SourceBuffer::Handle source) noexcept;
 		~ModuleNode() override = default;
 
 		/**
 		 * @brief Construct new Module node.
 		 * @param module_name Name of the module.
 		 * @param statements All the statements making up the module.
-		 * @return new 'Module' node.
+		 * @param source [Optional] Script the module was compiled from.
+		 * @return new 'Module' node, which shares the ownership of the current ASTArena (if any).
 		 */
-		static Dependency create(Identifier module_name, Dependencies statements);
+		static Dependency create(Identifier module_name, Dependencies statements, SourceBuffer::Handle source = {});
 	};
 
 	/**
@@ -0,0 +1,55 @@
+#include "ast/ast_arena.h"
+
+#include "ast/ast.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace soul::ast
+{
+	namespace
+	{
+		thread_local ASTArena::Handle t_current_arena = nullptr;
+	}  // namespace
+
+	ASTArena::~ASTArena()
+	{
+		// Dependencies owned by the arena are never destroyed by their parents, thus each node is destroyed exactly
+		// once, without recursing into the tree.
+		for (auto* node : _nodes) {
+			std::destroy_at(node);
+		}
+	}
+
+	void ASTArena::retain(Handle arena)
+	{
+		if (arena && arena.get() != this) {
+			_retained.push_back(std::move(arena));
+		}
+	}
+
+	const ASTArena::Handle& ASTArena::current() noexcept { return t_current_arena; }
+
+	void* ASTArena::allocate(std::size_t size, std::size_t alignment)
+	{
+		const auto padding = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(_current) & (alignment - 1));
+		if (_current == nullptr || padding + size > _remaining) {
+			const auto chunk_size = std::max(k_chunk_size, size + alignment);
+			_current              = _chunks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(chunk_size)).get();
+			_remaining            = chunk_size;
+			return allocate(size, alignment);
+		}
+
+		auto* result = _current + padding;
+		_current += padding + size;
+		_remaining -= padding + size;
+		_allocated += size;
+		return result;
+	}
+
+	ASTArena::Scope::Scope(Handle arena) : _previous(std::exchange(t_current_arena, std::move(arena))) {}
+
+	ASTArena::Scope::~Scope() { t_current_arena = std::move(_previous); }
+}  // namespace soul::ast
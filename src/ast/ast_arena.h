@@ -0,0 +1,154 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soul::ast
+{
+	class ASTNode;
+
+	/**
+	 * @brief ASTArena is a bump allocator for the nodes of a single module (and for their lists of dependencies),
+	 * which releases the whole tree in a single operation.
+	 * @details Arena is selected for the current thread with ASTArena::Scope; while it is active, node factories
+	 * (e.g. BinaryNode::create) and newly constructed ASTNode::Dependencies allocate from it, and ModuleNode::create
+	 * makes the module share its ownership. Destroying nodes owned by the arena is a no-op, thus the arena (instead of
+	 * the tree) runs their destructors, in a single flat pass, once the last owner releases it.
+	 * @important Nodes must not outlive their arena, i.e. must not be moved into trees other than their module's,
+	 * unless the arena is retained by the other tree as well (see ASTArena::retain).
+	 */
+	class ASTArena
+	{
+		public:
+		using Handle = std::shared_ptr<ASTArena>;
+		class Scope;
+
+		/** @brief Size of a single chunk; larger allocations receive a chunk of their own. */
+		static constexpr std::size_t k_chunk_size = 64 * 1024;
+
+		private:
+		std::vector<std::unique_ptr<std::byte[]>> _chunks    = {};
+		std::byte*                                _current   = nullptr;
+		std::size_t                               _remaining = 0;
+		std::size_t                               _allocated = 0;
+		std::vector<ASTNode*>                     _nodes     = {};
+		std::vector<Handle>                       _retained  = {};
+
+		public:
+		ASTArena() = default;
+		ASTArena(const ASTArena&)                = delete;
+		ASTArena(ASTArena&&) noexcept            = delete;
+		~ASTArena();
+		ASTArena& operator=(const ASTArena&)     = delete;
+		ASTArena& operator=(ASTArena&&) noexcept = delete;
+
+		/** @brief Returns arena active for the current thread, or nullptr if nodes are allocated on the heap. */
+		[[nodiscard]] static const Handle& current() noexcept;
+
+		/**
+		 * @brief Allocates uninitialized memory, which is released only alongside the whole arena.
+		 */
+		[[nodiscard]] void* allocate(std::size_t size, std::size_t alignment);
+
+		/**
+		 * @brief Constructs a node in the arena.
+		 * @tparam Node Type of the node.
+		 * @return Node owned by the arena.
+		 */
+		template <typename Node, typename... Args>
+		[[nodiscard]] Node* create(Args&&... args);
+
+		/**
+		 * @brief Keeps the other arena alive for as long as this one, e.g. when the nodes of this arena's module share
+		 * (see ASTNode::share) the nodes owned by the other arena.
+		 */
+		void retain(Handle arena);
+
+		/** @brief Returns number of bytes allocated so far (excluding the unused tails of the chunks). */
+		[[nodiscard]] std::size_t allocated() const noexcept { return _allocated; }
+
+		/** @brief Returns number of nodes owned by the arena. */
+		[[nodiscard]] std::size_t node_count() const noexcept { return _nodes.size(); }
+	};
+
+	/**
+	 * @brief Scope makes an arena active for the current thread for its lifetime, restoring the previous one afterwards.
+	 */
+	class ASTArena::Scope
+	{
+		private:
+		Handle _previous = nullptr;
+
+		public:
+		explicit Scope(Handle arena);
+		Scope(const Scope&)                = delete;
+		Scope(Scope&&) noexcept            = delete;
+		~Scope();
+		Scope& operator=(const Scope&)     = delete;
+		Scope& operator=(Scope&&) noexcept = delete;
+	};
+
+	/**
+	 * @brief ArenaAllocator allocates from the arena that was active when it was constructed, or from the heap if none
+	 * was. Deallocating from the arena is a no-op.
+	 */
+	template <typename T>
+	class ArenaAllocator
+	{
+		public:
+		using value_type                             = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap            = std::true_type;
+
+		private:
+		ASTArena* _arena = nullptr;
+
+		public:
+		ArenaAllocator() noexcept : _arena(ASTArena::current().get()) {}
+		explicit ArenaAllocator(ASTArena* arena) noexcept : _arena(arena) {}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.arena())
+		{
+		}
+
+		[[nodiscard]] T* allocate(std::size_t count)
+		{
+			if (_arena) {
+				return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+			}
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* pointer, std::size_t count) noexcept
+		{
+			if (!_arena) {
+				std::allocator<T>{}.deallocate(pointer, count);
+			}
+		}
+
+		[[nodiscard]] ASTArena* arena() const noexcept { return _arena; }
+
+		template <typename U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept
+		{
+			return _arena == other.arena();
+		}
+	};
+
+	template <typename Node, typename... Args>
+	Node* ASTArena::create(Args&&... args)
+	{
+		_nodes.reserve(_nodes.size() + 1);  // Ensures that the node is never left untracked.
+		auto* node                = ::new (allocate(sizeof(Node), alignof(Node))) Node(std::forward<Args>(args)...);
+		node->_is_arena_allocated = true;
+		_nodes.push_back(node);
+		return node;
+	}
+}  // namespace soul::ast
@@ -0,0 +1,355 @@
+#include "ast/flat_ast.h"
+
+#include "ast/visitors/visitor.h"
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace soul::ast
+{
+	/**
+	 * @brief FlatASTBuilder traverses the AST and appends each node (in pre-order) into the FlatAST.
+	 */
+	class FlatASTBuilder final : public visitors::IVisitor
+	{
+		private:
+		FlatAST&  _flat;
+		FlatIndex _current = k_flat_null;
+
+		public:
+		explicit FlatASTBuilder(FlatAST& flat) : _flat(flat) {}
+
+		FlatIndex convert(ASTNode::Reference node)
+		{
+			if (!node) {
+				return k_flat_null;
+			}
+			std::as_const(*node).accept(*this);
+			return _current;
+		}
+
+		FlatRange convert(const ASTNode::Dependencies& dependencies)
+		{
+			// NOTE: Dependencies append ranges of their own, thus the indices are gathered first.
+			std::vector<FlatIndex> indices{};
+			indices.reserve(dependencies.size());
+			for (const auto& dependency : dependencies) {
+				indices.push_back(convert(dependency.get()));
+			}
+			const FlatRange range{ .first = static_cast<u32>(_flat._children.size()),
+				                   .count = static_cast<u32>(indices.size()) };
+			_flat._children.insert(std::end(_flat._children), std::begin(indices), std::end(indices));
+			return range;
+		}
+
+		protected:
+		using IVisitor::visit;
+
+		void visit(const BinaryNode& node) override
+		{
+			const auto [index, slot] = push<BinaryNode>(node);
+			finish<BinaryNode>(index,
+			                   slot,
+			                   { .op = node.op, .lhs = convert(node.lhs.get()), .rhs = convert(node.rhs.get()) });
+		}
+
+		void visit(const BlockNode& node) override
+		{
+			const auto [index, slot] = push<BlockNode>(node);
+			finish<BlockNode>(index, slot, { .statements = convert(node.statements) });
+		}
+
+		void visit(const CastNode& node) override
+		{
+			const auto [index, slot] = push<CastNode>(node);
+			finish<CastNode>(
+				index, slot, { .expression = convert(node.expression.get()), .type_identifier = node.type_identifier });
+		}
+
+		void visit(const ErrorNode& node) override
+		{
+			const auto [index, slot] = push<ErrorNode>(node);
+			finish<ErrorNode>(index, slot, { .message = node.message });
+		}
+
+		void visit(const ForLoopNode& node) override
+		{
+			const auto [index, slot] = push<ForLoopNode>(node);
+			finish<ForLoopNode>(index,
+			                    slot,
+			                    { .initialization = convert(node.initialization.get()),
+			                      .condition      = convert(node.condition.get()),
+			                      .update         = convert(node.update.get()),
+			                      .statements     = convert(node.statements.get()) });
+		}
+
+		void visit(const ForeachLoopNode& node) override
+		{
+			const auto [index, slot] = push<ForeachLoopNode>(node);
+			finish<ForeachLoopNode>(index,
+			                        slot,
+			                        { .variable      = convert(node.variable.get()),
+			                          .in_expression = convert(node.in_expression.get()),
+			                          .statements    = convert(node.statements.get()) });
+		}
+
+		void visit(const FunctionCallNode& node) override
+		{
+			const auto [index, slot] = push<FunctionCallNode>(node);
+			finish<FunctionCallNode>(index, slot, { .name = node.name, .parameters = convert(node.parameters) });
+		}
+
+		void visit(const FunctionDeclarationNode& node) override
+		{
+			const auto [index, slot] = push<FunctionDeclarationNode>(node);
+			finish<FunctionDeclarationNode>(index,
+			                                slot,
+			                                { .name            = node.name,
+			                                  .type_identifier = node.type_identifier,
+			                                  .parameters      = convert(node.parameters),
+			                                  .statements      = convert(node.statements.get()) });
+		}
+
+		void visit(const IfNode& node) override
+		{
+			const auto [index, slot] = push<IfNode>(node);
+			finish<IfNode>(index,
+			               slot,
+			               { .condition       = convert(node.condition.get()),
+			                 .then_statements = convert(node.then_statements.get()),
+			                 .else_statements = convert(node.else_statements.get()) });
+		}
+
+		void visit(const LiteralNode& node) override
+		{
+			const auto [index, slot] = push<LiteralNode>(node);
+			finish<LiteralNode>(index, slot, { .value = node.value, .literal_type = node.literal_type });
+		}
+
+		void visit(const LoopControlNode& node) override
+		{
+			const auto [index, slot] = push<LoopControlNode>(node);
+			finish<LoopControlNode>(index, slot, { .control_type = node.control_type });
+		}
+
+		void visit(const ModuleNode& node) override
+		{
+			if (!_flat._source) {
+				_flat._source = node.source;
+			}
+			const auto [index, slot] = push<ModuleNode>(node);
+			finish<ModuleNode>(index, slot, { .name = node.name, .statements = convert(node.statements) });
+		}
+
+		void visit(const ReturnNode& node) override
+		{
+			const auto [index, slot] = push<ReturnNode>(node);
+			finish<ReturnNode>(index, slot, { .expression = convert(node.expression.get()) });
+		}
+
+		void visit(const StructDeclarationNode& node) override
+		{
+			const auto [index, slot] = push<StructDeclarationNode>(node);
+			finish<StructDeclarationNode>(index, slot, { .name = node.name, .parameters = convert(node.parameters) });
+		}
+
+		void visit(const UnaryNode& node) override
+		{
+			const auto [index, slot] = push<UnaryNode>(node);
+			finish<UnaryNode>(index, slot, { .op = node.op, .expression = convert(node.expression.get()) });
+		}
+
+		void visit(const VariableDeclarationNode& node) override
+		{
+			const auto [index, slot] = push<VariableDeclarationNode>(node);
+			finish<VariableDeclarationNode>(index,
+			                                slot,
+			                                { .name            = node.name,
+			                                  .type_identifier = node.type_identifier,
+			                                  .expression      = convert(node.expression.get()),
+			                                  .is_mutable      = node.is_mutable });
+		}
+
+		void visit(const WhileNode& node) override
+		{
+			const auto [index, slot] = push<WhileNode>(node);
+			finish<WhileNode>(index,
+			                  slot,
+			                  { .condition  = convert(node.condition.get()),
+			                    .statements = convert(node.statements.get()) });
+		}
+
+		private:
+		/** @brief Reserves the index of the node (before its dependencies), thus the indices are in pre-order. */
+		template <NodeKind Node>
+		std::pair<FlatIndex, u32> push(const Node& node)
+		{
+			auto&      nodes = std::get<std::vector<FlatNode<Node>>>(_flat._nodes);
+			const auto index = static_cast<FlatIndex>(_flat._kinds.size());
+			const auto slot  = static_cast<u32>(nodes.size());
+			nodes.emplace_back();
+			_flat._kinds.push_back(node.kind());
+			_flat._slots.push_back(slot);
+			_flat._ends.push_back(k_flat_null);
+			_flat._types.push_back(node.type);
+			return { index, slot };
+		}
+
+		template <NodeKind Node>
+		void finish(FlatIndex index, u32 slot, FlatNode<Node> fields)
+		{
+			// NOTE: Converting the dependencies might have reallocated the array, thus it is accessed by the slot.
+			std::get<std::vector<FlatNode<Node>>>(_flat._nodes)[slot] = std::move(fields);
+			_flat._ends[index]                                        = static_cast<FlatIndex>(_flat._kinds.size());
+			_current                                                  = index;
+		}
+	};
+
+	namespace
+	{
+		/**
+		 * @brief TreeBuilder converts the FlatAST back into a tree of (owning) nodes.
+		 */
+		class TreeBuilder
+		{
+			private:
+			const FlatAST& _flat;
+
+			public:
+			explicit TreeBuilder(const FlatAST& flat) : _flat(flat) {}
+
+			ASTNode::Dependency build(FlatIndex index) const
+			{
+				if (index == k_flat_null) {
+					return nullptr;
+				}
+				auto node  = _flat.visit(index, [this](FlatIndex, const auto& fields) { return create(fields); });
+				node->type = _flat.type(index);
+				return node;
+			}
+
+			ASTNode::Dependencies build(FlatRange range) const
+			{
+				ASTNode::Dependencies dependencies{};
+				dependencies.reserve(range.count);
+				for (const auto index : _flat.children(range)) {
+					dependencies.emplace_back(build(index));
+				}
+				return dependencies;
+			}
+
+			private:
+			// NOTE: Order of evaluation of function arguments is unspecified, thus the results are independent of it.
+			ASTNode::Dependency create(const FlatNode<BinaryNode>& fields) const
+			{
+				return BinaryNode::create(build(fields.lhs), build(fields.rhs), fields.op);
+			}
+
+			ASTNode::Dependency create(const FlatNode<BlockNode>& fields) const
+			{
+				return BlockNode::create(build(fields.statements));
+			}
+
+			ASTNode::Dependency create(const FlatNode<CastNode>& fields) const
+			{
+				return CastNode::create(build(fields.expression), fields.type_identifier);
+			}
+
+			ASTNode::Dependency create(const FlatNode<ErrorNode>& fields) const
+			{
+				return ErrorNode::create(fields.message);
+			}
+
+			ASTNode::Dependency create(const FlatNode<ForLoopNode>& fields) const
+			{
+				return ForLoopNode::create(build(fields.initialization),
+				                           build(fields.condition),
+				                           build(fields.update),
+				                           build(fields.statements));
+			}
+
+			ASTNode::Dependency create(const FlatNode<ForeachLoopNode>& fields) const
+			{
+				return ForeachLoopNode::create(
+					build(fields.variable), build(fields.in_expression), build(fields.statements));
+			}
+
+			ASTNode::Dependency create(const FlatNode<FunctionCallNode>& fields) const
+			{
+				return FunctionCallNode::create(fields.name, build(fields.parameters));
+			}
+
+			ASTNode::Dependency create(const FlatNode<FunctionDeclarationNode>& fields) const
+			{
+				return FunctionDeclarationNode::create(
+					fields.name, fields.type_identifier, build(fields.parameters), build(fields.statements));
+			}
+
+			ASTNode::Dependency create(const FlatNode<IfNode>& fields) const
+			{
+				return IfNode::create(
+					build(fields.condition), build(fields.then_statements), build(fields.else_statements));
+			}
+
+			ASTNode::Dependency create(const FlatNode<LiteralNode>& fields) const
+			{
+				return LiteralNode::create(fields.value, fields.literal_type);
+			}
+
+			ASTNode::Dependency create(const FlatNode<LoopControlNode>& fields) const
+			{
+				return LoopControlNode::create(fields.control_type);
+			}
+
+			ASTNode::Dependency create(const FlatNode<ModuleNode>& fields) const
+			{
+				return ModuleNode::create(fields.name, build(fields.statements), _flat.source());
+			}
+
+			ASTNode::Dependency create(const FlatNode<ReturnNode>& fields) const
+			{
+				return ReturnNode::create(build(fields.expression));
+			}
+
+			ASTNode::Dependency create(const FlatNode<StructDeclarationNode>& fields) const
+			{
+				return StructDeclarationNode::create(fields.name, build(fields.parameters));
+			}
+
+			ASTNode::Dependency create(const FlatNode<UnaryNode>& fields) const
+			{
+				return UnaryNode::create(build(fields.expression), fields.op);
+			}
+
+			ASTNode::Dependency create(const FlatNode<VariableDeclarationNode>& fields) const
+			{
+				return VariableDeclarationNode::create(
+					fields.name, fields.type_identifier, build(fields.expression), fields.is_mutable);
+			}
+
+			ASTNode::Dependency create(const FlatNode<WhileNode>& fields) const
+			{
+				return WhileNode::create(build(fields.condition), build(fields.statements));
+			}
+		};
+	}  // namespace
+
+	FlatAST FlatAST::from_tree(ASTNode::Reference root)
+	{
+		FlatAST        flat{};
+		FlatASTBuilder builder{ flat };
+		builder.convert(root);
+		return flat;
+	}
+
+	ASTNode::Dependency FlatAST::to_tree() const { return TreeBuilder{ *this }.build(root()); }
+
+	std::size_t FlatAST::allocated() const noexcept
+	{
+		const auto bytes = []<typename T>(const std::vector<T>& elements) { return elements.capacity() * sizeof(T); };
+		return bytes(_kinds) + bytes(_slots) + bytes(_ends) + bytes(_types) + bytes(_children)
+		     + std::apply([&](const auto&... nodes) { return (bytes(nodes) + ...); }, _nodes);
+	}
+}  // namespace soul::ast
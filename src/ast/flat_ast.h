@@ -0,0 +1,308 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+#include "common/source_buffer.h"
+#include "common/symbol.h"
+#include "common/types/type.h"
+#include "common/value.h"
+#include "core/types.h"
+
+#include <cassert>
+#include <limits>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace soul::ast
+{
+	/**
+	 * @brief Index of a node in the FlatAST.
+	 */
+	using FlatIndex = u32;
+
+	/** @brief Index denoting an absent (optional) node. */
+	inline constexpr FlatIndex k_flat_null = std::numeric_limits<FlatIndex>::max();
+
+	/**
+	 * @brief Range of (indices of) nodes, i.e. the flat counterpart of ASTNode::Dependencies.
+	 */
+	struct FlatRange
+	{
+		public:
+		u32 first = 0;
+		u32 count = 0;
+	};
+
+	/**
+	 * @brief FlatNode is the flat counterpart of a given node, i.e. its fields, with dependencies referred to by
+	 * their indices (instead of owning pointers).
+	 * @tparam Node Type satisfying the NodeKind concept.
+	 */
+	template <NodeKind Node>
+	struct FlatNode;
+
+	template <>
+	struct FlatNode<BinaryNode>
+	{
+		ASTNode::Operator op  = ASTNode::Operator::Unknown;
+		FlatIndex         lhs = k_flat_null;
+		FlatIndex         rhs = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<BlockNode>
+	{
+		FlatRange statements = {};
+	};
+
+	template <>
+	struct FlatNode<CastNode>
+	{
+		FlatIndex           expression      = k_flat_null;
+		ASTNode::Identifier type_identifier = {};
+	};
+
+	template <>
+	struct FlatNode<ErrorNode>
+	{
+		ErrorNode::Message message = {};
+	};
+
+	template <>
+	struct FlatNode<ForLoopNode>
+	{
+		FlatIndex initialization = k_flat_null;
+		FlatIndex condition      = k_flat_null;
+		FlatIndex update         = k_flat_null;
+		FlatIndex statements     = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<ForeachLoopNode>
+	{
+		FlatIndex variable      = k_flat_null;
+		FlatIndex in_expression = k_flat_null;
+		FlatIndex statements    = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<FunctionCallNode>
+	{
+		ASTNode::Identifier name       = {};
+		FlatRange           parameters = {};
+	};
+
+	template <>
+	struct FlatNode<FunctionDeclarationNode>
+	{
+		ASTNode::Identifier name            = {};
+		ASTNode::Identifier type_identifier = {};
+		FlatRange           parameters      = {};
+		FlatIndex           statements      = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<IfNode>
+	{
+		FlatIndex condition       = k_flat_null;
+		FlatIndex then_statements = k_flat_null;
+		FlatIndex else_statements = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<LiteralNode>
+	{
+		Value             value        = {};
+		LiteralNode::Type literal_type = LiteralNode::Type::Unknown;
+	};
+
+	template <>
+	struct FlatNode<LoopControlNode>
+	{
+		LoopControlNode::Type control_type = LoopControlNode::Type::Break;
+	};
+
+	template <>
+	struct FlatNode<ModuleNode>
+	{
+		ASTNode::Identifier name       = {};
+		FlatRange           statements = {};
+	};
+
+	template <>
+	struct FlatNode<ReturnNode>
+	{
+		FlatIndex expression = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<StructDeclarationNode>
+	{
+		ASTNode::Identifier name       = {};
+		FlatRange           parameters = {};
+	};
+
+	template <>
+	struct FlatNode<UnaryNode>
+	{
+		ASTNode::Operator op         = ASTNode::Operator::Unknown;
+		FlatIndex         expression = k_flat_null;
+	};
+
+	template <>
+	struct FlatNode<VariableDeclarationNode>
+	{
+		ASTNode::Identifier name            = {};
+		ASTNode::Identifier type_identifier = {};
+		FlatIndex           expression      = k_flat_null;
+		bool                is_mutable      = false;
+	};
+
+	template <>
+	struct FlatNode<WhileNode>
+	{
+		FlatIndex condition  = k_flat_null;
+		FlatIndex statements = k_flat_null;
+	};
+
+	/**
+	 * @brief FlatAST is a data-oriented representation of the Abstract Syntax Tree (AST): nodes are stored by their
+	 * kind in contiguous arrays and refer to their dependencies by (u32) indices, while the kind and type of each node
+	 * are stored in arrays parallel to them.
+	 * @details Nodes are indexed in pre-order, thus iterating over the indices visits the whole tree (parents before
+	 * their dependencies), and the descendants of each node occupy the indices up to FlatAST::subtree_end.
+	 * Passes which do not depend on the structure of the tree (e.g. looking for ErrorNodes) can iterate over the nodes
+	 * of a single kind directly, see FlatAST::nodes.
+	 */
+	class FlatAST
+	{
+		private:
+		template <typename... Nodes>
+		using Storage = std::tuple<std::vector<FlatNode<Nodes>>...>;
+
+		// NOLINTNEXTLINE(bugprone-macro-parentheses)
+#define SOUL_AST_NODE(name) , name
+		// NOTE: Leading comma is consumed by the (unused) first parameter.
+		template <typename, typename... Nodes>
+		using StorageOf = Storage<Nodes...>;
+		using NodeStorage = StorageOf<void SOUL_AST_NODES>;
+#undef SOUL_AST_NODE
+
+		private:
+		std::vector<ASTNode::Kind> _kinds    = {};
+		std::vector<u32>           _slots    = {};  // Index of each node in the array of its kind.
+		std::vector<FlatIndex>     _ends     = {};  // One past the last descendant of each node.
+		std::vector<types::Type>   _types    = {};
+		std::vector<FlatIndex>     _children = {};  // Elements of all FlatRanges.
+		NodeStorage                _nodes    = {};
+		SourceBuffer::Handle       _source   = {};
+
+		public:
+		/**
+		 * @brief Converts the (sub-) tree into its flat representation.
+		 * @param root Root of the tree, whose index is always 0.
+		 */
+		[[nodiscard]] static FlatAST from_tree(ASTNode::Reference root);
+
+		/**
+		 * @brief Converts the flat representation back into a tree, e.g. for the passes which were not adopted yet.
+		 * @return Root of the tree, or nullptr if the representation is empty.
+		 */
+		[[nodiscard]] ASTNode::Dependency to_tree() const;
+
+		/** @brief Returns number of nodes. */
+		[[nodiscard]] std::size_t size() const noexcept { return _kinds.size(); }
+
+		[[nodiscard]] bool empty() const noexcept { return _kinds.empty(); }
+
+		/** @brief Returns number of bytes allocated by the arrays of nodes (including their unused capacity). */
+		[[nodiscard]] std::size_t allocated() const noexcept;
+
+		/** @brief Returns index of the root node, or k_flat_null if there are no nodes. */
+		[[nodiscard]] FlatIndex root() const noexcept { return empty() ? k_flat_null : 0; }
+
+		/** @brief Returns script the module was compiled from (if the tree was converted from a module). */
+		[[nodiscard]] const SourceBuffer::Handle& source() const noexcept { return _source; }
+
+		[[nodiscard]] ASTNode::Kind kind(FlatIndex index) const noexcept { return _kinds[index]; }
+
+		[[nodiscard]] const types::Type& type(FlatIndex index) const noexcept { return _types[index]; }
+		[[nodiscard]] types::Type&       type(FlatIndex index) noexcept { return _types[index]; }
+
+		/** @brief Returns index one past the last descendant of a given node, i.e. the next index outside of it. */
+		[[nodiscard]] FlatIndex subtree_end(FlatIndex index) const noexcept { return _ends[index]; }
+
+		/** @brief Returns indices of the nodes in a given range. */
+		[[nodiscard]] std::span<const FlatIndex> children(FlatRange range) const noexcept
+		{
+			return std::span{ _children }.subspan(range.first, range.count);
+		}
+
+		/** @brief Verifies if node is of a given type. */
+		template <NodeKind Node>
+		[[nodiscard]] bool is(FlatIndex index) const noexcept
+		{
+			return index != k_flat_null && _kinds[index] == ASTNode::kind_of<Node>();
+		}
+
+		/**
+		 * @brief Returns the fields of a given node.
+		 * @important Does not perform any validation - assumes that FlatAST::is<T> was used first.
+		 */
+		template <NodeKind Node>
+		[[nodiscard]] const FlatNode<Node>& as(FlatIndex index) const noexcept
+		{
+			assert(is<Node>(index) && "node is of a different kind");
+			return nodes<Node>()[_slots[index]];
+		}
+
+		template <NodeKind Node>
+		[[nodiscard]] FlatNode<Node>& as(FlatIndex index) noexcept
+		{
+			assert(is<Node>(index) && "node is of a different kind");
+			return std::get<std::vector<FlatNode<Node>>>(_nodes)[_slots[index]];
+		}
+
+		/** @brief Returns (contiguous) fields of all the nodes of a given type, in pre-order. */
+		template <NodeKind Node>
+		[[nodiscard]] std::span<const FlatNode<Node>> nodes() const noexcept
+		{
+			return std::get<std::vector<FlatNode<Node>>>(_nodes);
+		}
+
+		/**
+		 * @brief Calls the visitor with the index and the fields of a given node, i.e. `visitor(index, as<T>(index))`.
+		 */
+		template <typename Visitor>
+		decltype(auto) visit(FlatIndex index, Visitor&& visitor) const
+		{
+			switch (_kinds[index]) {
+#define SOUL_AST_NODE(name)    \
+	case ASTNode::Kind::name: \
+		return std::forward<Visitor>(visitor)(index, as<name>(index));
+				SOUL_AST_NODES
+#undef SOUL_AST_NODE
+			}
+			std::unreachable();
+		}
+
+		/**
+		 * @brief Calls the function with the index of each (present) direct dependency of a given node, in order.
+		 */
+		template <typename Function>
+		void for_each_child(FlatIndex index, Function&& function) const
+		{
+			// Dependencies are converted in order and before the following siblings, thus each is the next index
+			// past the subtree of the previous one.
+			for (auto child = index + 1; child < _ends[index]; child = _ends[child]) {
+				function(child);
+			}
+		}
+
+		private:
+		friend class FlatASTBuilder;
+	};
+}  // namespace soul::ast
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soul::ast
+{
+	/**
+	 * @brief Calls the function with each dependency of a given node (including the absent ones), in order.
+	 */
+	template <typename Function>
+	void for_each_dependency(ASTNode& node, Function&& function)
+	{
+		switch (node.kind()) {
+			case ASTNode::Kind::BinaryNode: {
+				auto& binary_node = node.as<BinaryNode>();
+				function(binary_node.lhs);
+				function(binary_node.rhs);
+				return;
+			}
+			case ASTNode::Kind::BlockNode:
+				for (auto& statement : node.as<BlockNode>().statements) {
+					function(statement);
+				}
+				return;
+			case ASTNode::Kind::CastNode:
+				function(node.as<CastNode>().expression);
+				return;
+			case ASTNode::Kind::ErrorNode:
+				return;
+			case ASTNode::Kind::ForLoopNode: {
+				auto& for_loop = node.as<ForLoopNode>();
+				function(for_loop.initialization);
+				function(for_loop.condition);
+				function(for_loop.update);
+				function(for_loop.statements);
+				return;
+			}
+			case ASTNode::Kind::ForeachLoopNode: {
+				auto& foreach_loop = node.as<ForeachLoopNode>();
+				function(foreach_loop.variable);
+				function(foreach_loop.in_expression);
+				function(foreach_loop.statements);
+				return;
+			}
+			case ASTNode::Kind::FunctionCallNode:
+				for (auto& parameter : node.as<FunctionCallNode>().parameters) {
+					function(parameter);
+				}
+				return;
+			case ASTNode::Kind::FunctionDeclarationNode: {
+				auto& function_declaration = node.as<FunctionDeclarationNode>();
+				for (auto& parameter : function_declaration.parameters) {
+					function(parameter);
+				}
+				function(function_declaration.statements);
+				return;
+			}
+			case ASTNode::Kind::IfNode: {
+				auto& if_node = node.as<IfNode>();
+				function(if_node.condition);
+				function(if_node.then_statements);
+				function(if_node.else_statements);
+				return;
+			}
+			case ASTNode::Kind::LiteralNode:
+			case ASTNode::Kind::LoopControlNode:
+				return;
+			case ASTNode::Kind::ModuleNode:
+				for (auto& statement : node.as<ModuleNode>().statements) {
+					function(statement);
+				}
+				return;
+			case ASTNode::Kind::ReturnNode:
+				function(node.as<ReturnNode>().expression);
+				return;
+			case ASTNode::Kind::StructDeclarationNode:
+				for (auto& parameter : node.as<StructDeclarationNode>().parameters) {
+					function(parameter);
+				}
+				return;
+			case ASTNode::Kind::UnaryNode:
+				function(node.as<UnaryNode>().expression);
+				return;
+			case ASTNode::Kind::VariableDeclarationNode:
+				function(node.as<VariableDeclarationNode>().expression);
+				return;
+			case ASTNode::Kind::WhileNode: {
+				auto& while_node = node.as<WhileNode>();
+				function(while_node.condition);
+				function(while_node.statements);
+				return;
+			}
+		}
+		std::unreachable();
+	}
+
+	/**
+	 * @brief TraversalStack traverses the AST in depth-first order without recursion: pending nodes are kept in a
+	 * single contiguous buffer (reused between the traversals) instead of on the native stack, thus the depth of the
+	 * tree is bounded only by the available memory.
+	 */
+	class TraversalStack
+	{
+		private:
+		struct Frame
+		{
+			ASTNode::Reference node       = nullptr;
+			bool               is_entered = false;
+		};
+
+		private:
+		std::vector<Frame> _frames = {};
+		std::size_t        _depth  = 0;
+
+		public:
+		/**
+		 * @brief Traverses the (sub-) tree.
+		 * @param enter Called with each node before its dependencies. Might return false to skip its dependencies
+		 * (and the call to leave).
+		 * @param leave Called with each entered node after its dependencies.
+		 */
+		template <typename Enter, typename Leave>
+		void traverse(ASTNode::Reference root, Enter&& enter, Leave&& leave)
+		{
+			if (!root) {
+				return;
+			}
+
+			// NOTE: Traversal might be nested (e.g. started by one of the callbacks), thus only the frames above the
+			// current ones belong to it.
+			const auto base = _frames.size();
+			_frames.push_back({ .node = root, .is_entered = false });
+			while (_frames.size() > base) {
+				const auto [node, is_entered] = _frames.back();
+				_frames.pop_back();
+				if (is_entered) {
+					--_depth;
+					leave(*node);
+					continue;
+				}
+
+				if constexpr (std::is_void_v<std::invoke_result_t<Enter&, ASTNode&>>) {
+					enter(*node);
+				} else if (!enter(*node)) {
+					continue;
+				}
+
+				++_depth;
+				_frames.push_back({ .node = node, .is_entered = true });
+				const auto first = _frames.size();
+				for_each_dependency(*node, [this](ASTNode::Dependency& dependency) {
+					if (dependency) {
+						_frames.push_back({ .node = dependency.get(), .is_entered = false });
+					}
+				});
+				// Dependencies are popped in reverse order of pushing them.
+				std::reverse(std::begin(_frames) + static_cast<std::ptrdiff_t>(first), std::end(_frames));
+			}
+		}
+
+		/**
+		 * @brief Traverses the (sub-) tree, see TraversalStack::traverse.
+		 */
+		template <typename Enter>
+		void traverse(ASTNode::Reference root, Enter&& enter)
+		{
+			traverse(root, std::forward<Enter>(enter), [](ASTNode&) {});
+		}
+
+		/** @brief Returns number of nodes which were entered, but not left yet, e.g. ancestors of the entered node. */
+		[[nodiscard]] std::size_t depth() const noexcept { return _depth; }
+	};
+
+	/**
+	 * @brief ResultStack computes a result for each node of the AST bottom-up (see TraversalStack), e.g. its clone,
+	 * thus the visitors which return results do not have to recurse into the dependencies.
+	 * @details Results of the dependencies are kept on a stack until their parent is left, at which point these can be
+	 * taken (see ResultStack::take) while computing the result of the parent itself.
+	 * @tparam Result Type of the result computed for each node.
+	 */
+	template <typename Result>
+	class ResultStack
+	{
+		private:
+		struct Entry
+		{
+			ASTNode::Reference node;
+			Result             result;
+		};
+
+		private:
+		TraversalStack           _traversal = {};
+		std::vector<Entry>       _entries   = {};
+		std::vector<std::size_t> _bases     = {};
+		std::size_t              _begin     = 0;  // First result belonging to the dependencies of the left node.
+		std::size_t              _cursor    = 0;  // Result which is (most likely) taken next.
+
+		public:
+		/**
+		 * @brief Computes the result of the (sub-) tree.
+		 * @param enter Called with each node before its dependencies. Might return false to skip the node, in which
+		 * case it has no result (unless it is computed separately).
+		 * @param leave Called with each entered node after its dependencies, returns the result of the node.
+		 * @return Result of the root, unless it was skipped.
+		 */
+		template <typename Enter, typename Leave>
+		std::optional<Result> compute(ASTNode::Reference root, Enter&& enter, Leave&& leave)
+		{
+			const auto previous_begin  = _begin;
+			const auto previous_cursor = _cursor;
+			const auto size            = _entries.size();
+			// NOTE: Computation might be nested (e.g. by one of the callbacks), thus results of the outer one must
+			// not be taken in the meantime.
+			_begin = _cursor = size;
+			_traversal.traverse(
+				root,
+				[this, &enter](ASTNode& node) {
+					if (!enter(node)) {
+						return false;
+					}
+					_bases.push_back(_entries.size());
+					return true;
+				},
+				[this, &leave](ASTNode& node) {
+					const auto base = _bases.back();
+					_bases.pop_back();
+					_begin = _cursor = base;
+					auto result      = leave(node);
+					// Results which were not taken are discarded alongside the taken ones.
+					_entries.erase(std::begin(_entries) + static_cast<std::ptrdiff_t>(base), std::end(_entries));
+					_entries.push_back({ .node = &node, .result = std::move(result) });
+				});
+			_begin  = previous_begin;
+			_cursor = previous_cursor;
+
+			if (_entries.size() == size) {
+				return std::nullopt;
+			}
+			auto result = std::move(_entries.back().result);
+			_entries.pop_back();
+			return result;
+		}
+
+		/**
+		 * @brief Takes the result of a dependency of the node which is being left.
+		 * @return Result of the dependency, unless it was skipped or taken already.
+		 */
+		std::optional<Result> take(ASTNode::Reference dependency)
+		{
+			if (!dependency) {
+				return std::nullopt;
+			}
+			// NOTE: Dependencies are usually taken in order, thus the search starts right after the last taken one.
+			auto index = _cursor;
+			while (index < _entries.size() && _entries[index].node != dependency) {
+				++index;
+			}
+			if (index == _entries.size()) {
+				index = _begin;
+				while (index < _cursor && _entries[index].node != dependency) {
+					++index;
+				}
+				if (index == _cursor) {
+					return std::nullopt;
+				}
+			}
+			_cursor              = index + 1;
+			_entries[index].node = nullptr;
+			return std::move(_entries[index].result);
+		}
+	};
+}  // namespace soul::ast
@@ -1,7 +1,13 @@
 #include "ast/visitors/compare.h"
 
+#include "ast/traversal.h"
+
+#include <algorithm>
+#include <cstddef>
 #include <format>
-#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace soul::ast::visitors
 {
@@ -27,16 +33,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor(lhs.lhs.get(), rhs.lhs.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor(lhs.rhs.get(), rhs.rhs.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -51,12 +47,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-		for (std::size_t index = 0; index < lhs.statements.size(); ++index) {
-			_ordering = CompareVisitor(lhs.statements[index].get(), rhs.statements[index].get());
-			if (_ordering != std::partial_ordering::equivalent) {
-				return;
-			}
-		}
 	}
 
 	template <>
@@ -76,11 +66,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor{ lhs.expression.get(), rhs.expression.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -104,26 +89,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor{ lhs.initialization.get(), rhs.initialization.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.condition.get(), rhs.condition.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.update.get(), rhs.update.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.statements.get(), rhs.statements.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -133,21 +98,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor{ lhs.variable.get(), rhs.variable.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.in_expression.get(), rhs.in_expression.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.statements.get(), rhs.statements.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -167,12 +117,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-		for (std::size_t index = 0; index < lhs.parameters.size(); ++index) {
-			_ordering = CompareVisitor(lhs.parameters[index].get(), rhs.parameters[index].get());
-			if (_ordering != std::partial_ordering::equivalent) {
-				return;
-			}
-		}
 	}
 
 	template <>
@@ -198,17 +142,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-		for (std::size_t index = 0; index < lhs.parameters.size(); ++index) {
-			_ordering = CompareVisitor(lhs.parameters[index].get(), rhs.parameters[index].get());
-			if (_ordering != std::partial_ordering::equivalent) {
-				return;
-			}
-		}
-
-		_ordering = CompareVisitor{ lhs.statements.get(), rhs.statements.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -218,21 +151,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor{ lhs.condition.get(), rhs.condition.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.then_statements.get(), rhs.then_statements.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
-
-		_ordering = CompareVisitor{ lhs.else_statements.get(), rhs.else_statements.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -285,12 +203,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-		for (std::size_t index = 0; index < lhs.statements.size(); ++index) {
-			_ordering = CompareVisitor(lhs.statements[index].get(), rhs.statements[index].get());
-			if (_ordering != std::partial_ordering::equivalent) {
-				return;
-			}
-		}
 	}
 
 	template <>
@@ -300,11 +212,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor{ lhs.expression.get(), rhs.expression.get() };
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -325,12 +232,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-		for (std::size_t index = 0; index < lhs.parameters.size(); ++index) {
-			_ordering = CompareVisitor(lhs.parameters[index].get(), rhs.parameters[index].get());
-			if (_ordering != std::partial_ordering::equivalent) {
-				return;
-			}
-		}
 	}
 
 	template <>
@@ -345,11 +246,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor(lhs.expression.get(), rhs.expression.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -375,11 +271,6 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
-
-		_ordering = CompareVisitor(lhs.expression.get(), rhs.expression.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
 	}
 
 	template <>
@@ -389,45 +280,70 @@ namespace soul::ast::visitors
 		if (_ordering != std::partial_ordering::equivalent) {
 			return;
 		}
+	}
 
-		_ordering = CompareVisitor(lhs.condition.get(), rhs.condition.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
-		}
+	CompareVisitor::CompareVisitor(ASTNode::Reference lhs, ASTNode::Reference rhs)
+	{
+		// NOTE: Pairs of nodes are compared in depth-first order without recursion, same as in TraversalStack, thus
+		// the depth of the trees is bounded only by the available memory.
+		thread_local std::vector<std::pair<ASTNode::Reference, ASTNode::Reference>> t_pending{};
+		t_pending.emplace_back(lhs, rhs);
+		while (!t_pending.empty()) {
+			const auto [lhs_node, rhs_node] = t_pending.back();
+			t_pending.pop_back();
+			const bool has_dependencies = compare(lhs_node, rhs_node);
+			if (_ordering != std::partial_ordering::equivalent) {
+				t_pending.clear();
+				return;
+			}
+			if (!has_dependencies) {
+				continue;
+			}
 
-		_ordering = CompareVisitor(lhs.statements.get(), rhs.statements.get());
-		if (_ordering != std::partial_ordering::equivalent) {
-			return;
+			// Both of the nodes have the same number of dependencies, as their kinds (and sizes) are equal.
+			const auto first = t_pending.size();
+			for_each_dependency(*lhs_node, [](ASTNode::Dependency& dependency) {
+				t_pending.emplace_back(dependency.get(), nullptr);
+			});
+			auto index = first;
+			for_each_dependency(*rhs_node, [&index](ASTNode::Dependency& dependency) {
+				t_pending[index++].second = dependency.get();
+			});
+			// Dependencies are popped in reverse order of pushing them.
+			std::reverse(std::begin(t_pending) + static_cast<std::ptrdiff_t>(first), std::end(t_pending));
 		}
 	}
 
-	CompareVisitor::CompareVisitor(ASTNode::Reference lhs, ASTNode::Reference rhs)
+	bool CompareVisitor::compare(ASTNode::Reference lhs, ASTNode::Reference rhs)
 	{
 		if (lhs == rhs) {
 			_ordering = std::partial_ordering::equivalent;
-			return;
+			return false;
 		}
 
 		if (lhs == nullptr) {
 			_ordering = std::partial_ordering::less;
-			return;
+			return false;
 		}
 
 		if (rhs == nullptr) {
 			_ordering = std::partial_ordering::greater;
-			return;
+			return false;
 		}
 
-		_ordering = std::type_index(typeid(*lhs)) <=> std::type_index(typeid(*rhs));
+		_ordering = lhs->kind() <=> rhs->kind();
 		if (_ordering != std::partial_ordering::equivalent) {
-			return;
+			return true;
 		}
 
+		switch (lhs->kind()) {
 #define SOUL_AST_NODE(name)                              \
-	if (lhs->is<name>() && rhs->is<name>()) {            \
+	case ASTNode::Kind::name:                            \
 		compare<name>(lhs->as<name>(), rhs->as<name>()); \
-	}
-		SOUL_AST_NODES
+		return true;
+			SOUL_AST_NODES
 #undef SOUL_AST_NODE
+		}
+		std::unreachable();
 	}
 }  // namespace soul::ast::visitors
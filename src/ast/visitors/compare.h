@@ -4,12 +4,17 @@
 #include "ast/visitors/default_traverse.h"
 
 #include <compare>
+#include <cstddef>
 
 namespace soul::ast::visitors
 {
 	/**
 	 * @brief CompareVisitor traverses both ASTs and returns the relation between them (by comparing each node).
 	 * Useful for determining if a sequence of passes had an impact on the output AST.
+	 * @details Trees are ordered structurally, i.e. by the first difference between the nodes in depth-first order, and
+	 * are traversed without recursion, thus these might be arbitrarily deep. Cached hashes (see ASTNode::hash) are not
+	 * taken into account, as these go stale once any node is modified without invalidating its ancestors, which would
+	 * silently change both the ordering and the equality of the trees.
 	 */
 	class CompareVisitor final
 	{
@@ -23,7 +28,34 @@ namespace soul::ast::visitors
 		operator std::partial_ordering() const noexcept;
 
 		private:
+		/**
+		 * @brief Compares the nodes themselves, i.e. without their dependencies.
+		 * @return True if the dependencies of the (equivalent) nodes have to be compared as well.
+		 */
+		bool compare(ASTNode::Reference lhs, ASTNode::Reference rhs);
+
 		template <NodeKind Node>
 		void compare(const Node& lhs, const Node& rhs);
 	};
+
+	/**
+	 * @brief Hashes the (sub-) trees by their structure, e.g. for bucketing (and deduplicating) them in unordered
+	 * containers alongside StructuralEqual.
+	 * @important Trees must not be modified while in the container, as their (cached) hashes would go stale.
+	 */
+	struct StructuralHash
+	{
+		[[nodiscard]] std::size_t operator()(ASTNode::Reference node) const { return node ? node->hash() : 0; }
+	};
+
+	/**
+	 * @brief Verifies if the (sub-) trees are structurally equal, see CompareVisitor.
+	 */
+	struct StructuralEqual
+	{
+		[[nodiscard]] bool operator()(ASTNode::Reference lhs, ASTNode::Reference rhs) const
+		{
+			return CompareVisitor(lhs, rhs);
+		}
+	};
 }  // namespace soul::ast::visitors
@@ -1,95 +1,90 @@
 #include "ast/visitors/copy.h"
 
-#include <ranges>
+#include <utility>
 
 namespace soul::ast::visitors
 {
+	CopyVisitor::CopyVisitor(Options options) : _options(options) {}
+
+	void CopyVisitor::accept(ASTNode::Reference node) { _current_clone = clone(node); }
+
 	ASTNode::Dependency CopyVisitor::cloned() noexcept { return std::move(_current_clone); }
 
 	void CopyVisitor::visit(const BinaryNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const BlockNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const CastNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const ErrorNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const ForLoopNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const ForeachLoopNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const FunctionCallNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const FunctionDeclarationNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const IfNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const LiteralNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const LoopControlNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const ModuleNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const ReturnNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const StructDeclarationNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const UnaryNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const VariableDeclarationNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
 	}
 	void CopyVisitor::visit(const WhileNode& node)
 	{
-		_current_clone       = clone(node);
-		_current_clone->type = node.type;
+		_current_clone = typed(clone(node), node);
+	}
+
+	ASTNode::Dependency CopyVisitor::typed(ASTNode::Dependency clone, const ASTNode& original) noexcept
+	{
+		if (clone.get() != &original) {
+			clone->type = original.type;
+		}
+		return clone;
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const ASTNode::Reference node)
@@ -97,25 +92,54 @@ namespace soul::ast::visitors
 		if (!node) {
 			return nullptr;
 		}
-		node->accept(*this);
-		return std::move(_current_clone);
+		if (auto cloned = _clones.take(node)) {
+			return std::move(*cloned);
+		}
+		auto cloned = _clones.compute(
+			node,
+			[](ASTNode&) { return true; },
+			[this](ASTNode& current) {
+				current.accept(*this);
+				return std::move(_current_clone);
+			});
+		return std::move(*cloned);
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const BinaryNode& node)
 	{
 		auto lhs{ clone(node.lhs.get()) };
 		auto rhs{ clone(node.rhs.get()) };
+		if (unchanged(node.lhs, lhs) && unchanged(node.rhs, rhs)) {
+			return node.share();
+		}
 		return BinaryNode::create(std::move(lhs), std::move(rhs), node.op);
 	}
 
-	ASTNode::ScopeBlock CopyVisitor::clone(const BlockNode& node) { return BlockNode::create(clone(node.statements)); }
+	ASTNode::ScopeBlock CopyVisitor::clone(const BlockNode& node)
+	{
+		auto statements{ clone_changed(node.statements) };
+		if (!statements) {
+			return node.share();
+		}
+		return BlockNode::create(std::move(*statements));
+	}
 
 	ASTNode::Dependency CopyVisitor::clone(const CastNode& node)
 	{
-		return CastNode::create(clone(node.expression.get()), node.type_identifier);
+		auto expression{ clone(node.expression.get()) };
+		if (unchanged(node.expression, expression)) {
+			return node.share();
+		}
+		return CastNode::create(std::move(expression), node.type_identifier);
 	}
 
-	ASTNode::Dependency CopyVisitor::clone(const ErrorNode& node) { return ErrorNode::create(node.message); }
+	ASTNode::Dependency CopyVisitor::clone(const ErrorNode& node)
+	{
+		if (_options & Options::ShareUnchanged) {
+			return node.share();
+		}
+		return ErrorNode::create(node.message);
+	}
 
 	ASTNode::Dependency CopyVisitor::clone(const ForLoopNode& node)
 	{
@@ -123,6 +147,10 @@ namespace soul::ast::visitors
 		auto condition{ clone(node.condition.get()) };
 		auto update{ clone(node.update.get()) };
 		auto statements{ clone(node.statements.get()) };
+		if (unchanged(node.initialization, initialization) && unchanged(node.condition, condition)
+		    && unchanged(node.update, update) && unchanged(node.statements, statements)) {
+			return node.share();
+		}
 		return ForLoopNode::create(
 			std::move(initialization), std::move(condition), std::move(update), std::move(statements));
 	}
@@ -132,20 +160,32 @@ namespace soul::ast::visitors
 		auto variable{ clone(node.variable.get()) };
 		auto in_expression{ clone(node.in_expression.get()) };
 		auto statements{ clone(node.statements.get()) };
+		if (unchanged(node.variable, variable) && unchanged(node.in_expression, in_expression)
+		    && unchanged(node.statements, statements)) {
+			return node.share();
+		}
 		return ForeachLoopNode::create(std::move(variable), std::move(in_expression), std::move(statements));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const FunctionCallNode& node)
 	{
-		return FunctionCallNode::create(node.name, clone(node.parameters));
+		auto parameters{ clone_changed(node.parameters) };
+		if (!parameters) {
+			return node.share();
+		}
+		return FunctionCallNode::create(node.name, std::move(*parameters));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const FunctionDeclarationNode& node)
 	{
-		auto cloned_parameters{ clone(node.parameters) };
+		auto cloned_parameters{ clone_changed(node.parameters) };
 		auto statements{ clone(node.statements.get()) };
+		if (!cloned_parameters && unchanged(node.statements, statements)) {
+			return node.share();
+		}
+		auto parameters{ cloned_parameters ? std::move(*cloned_parameters) : shared(node.parameters) };
 		return FunctionDeclarationNode::create(
-			node.name, node.type_identifier, std::move(cloned_parameters), std::move(statements));
+			node.name, node.type_identifier, std::move(parameters), std::move(statements));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const IfNode& node)
@@ -153,49 +193,134 @@ namespace soul::ast::visitors
 		auto condition{ clone(node.condition.get()) };
 		auto then_statements{ clone(node.then_statements.get()) };
 		auto else_statements{ clone(node.else_statements.get()) };
+		if (unchanged(node.condition, condition) && unchanged(node.then_statements, then_statements)
+		    && unchanged(node.else_statements, else_statements)) {
+			return node.share();
+		}
 		return IfNode::create(std::move(condition), std::move(then_statements), std::move(else_statements));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const LiteralNode& node)
 	{
+		if (_options & Options::ShareUnchanged) {
+			return node.share();
+		}
 		return LiteralNode::create(node.value, node.literal_type);
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const LoopControlNode& node)
 	{
+		if (_options & Options::ShareUnchanged) {
+			return node.share();
+		}
 		return LoopControlNode::create(node.control_type);
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const ModuleNode& node)
 	{
-		return ModuleNode::create(node.name, clone(node.statements));
+		auto statements{ clone_changed(node.statements) };
+		if (!statements) {
+			return node.share();
+		}
+
+		auto module{ ModuleNode::create(node.name, std::move(*statements), node.source) };
+		if (_options & Options::ShareUnchanged) {
+			// NOTE: Shared statements might be owned by the arena of the original module.
+			auto& arena = module->as<ModuleNode>().arena;
+			if (!arena) {
+				arena = node.arena;
+			} else {
+				arena->retain(node.arena);
+			}
+		}
+		return module;
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const ReturnNode& node)
 	{
-		return ReturnNode::create(clone(node.expression.get()));
+		auto expression{ clone(node.expression.get()) };
+		if (unchanged(node.expression, expression)) {
+			return node.share();
+		}
+		return ReturnNode::create(std::move(expression));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const StructDeclarationNode& node)
 	{
-		return StructDeclarationNode::create(node.name, clone(node.parameters));
+		auto parameters{ clone_changed(node.parameters) };
+		if (!parameters) {
+			return node.share();
+		}
+		return StructDeclarationNode::create(node.name, std::move(*parameters));
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const UnaryNode& node)
 	{
-		return UnaryNode::create(clone(node.expression.get()), node.op);
+		auto expression{ clone(node.expression.get()) };
+		if (unchanged(node.expression, expression)) {
+			return node.share();
+		}
+		return UnaryNode::create(std::move(expression), node.op);
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const VariableDeclarationNode& node)
 	{
-		return VariableDeclarationNode::create(
-			node.name, node.type_identifier, clone(node.expression.get()), node.is_mutable);
+		auto expression{ clone(node.expression.get()) };
+		if (unchanged(node.expression, expression)) {
+			return node.share();
+		}
+		return VariableDeclarationNode::create(node.name, node.type_identifier, std::move(expression), node.is_mutable);
 	}
 
 	ASTNode::Dependency CopyVisitor::clone(const WhileNode& node)
 	{
 		auto condition{ clone(node.condition.get()) };
 		auto statements{ clone(node.statements.get()) };
+		if (unchanged(node.condition, condition) && unchanged(node.statements, statements)) {
+			return node.share();
+		}
 		return WhileNode::create(std::move(condition), std::move(statements));
 	}
+
+	std::optional<ASTNode::Dependencies> CopyVisitor::clone_changed(const ASTNode::Dependencies& elements)
+	{
+		if (!(_options & Options::ShareUnchanged)) {
+			return clone(elements);
+		}
+
+		// NOTE: Unchanged clones are released right away, thus the elements are collected only once any changes.
+		for (auto it = elements.begin(); it != elements.end(); ++it) {
+			auto element{ clone(it->get()) };
+			if (unchanged(*it, element)) {
+				continue;
+			}
+
+			ASTNode::Dependencies cloned{};
+			cloned.reserve(elements.size());
+			for (auto previous = elements.begin(); previous != it; ++previous) {
+				cloned.emplace_back(*previous ? (*previous)->share() : nullptr);
+			}
+			cloned.emplace_back(std::move(element));
+			for (++it; it != elements.end(); ++it) {
+				cloned.emplace_back(clone(it->get()));
+			}
+			return cloned;
+		}
+		return std::nullopt;
+	}
+
+	bool CopyVisitor::unchanged(const ASTNode::Dependency& original, const ASTNode::Dependency& clone) const noexcept
+	{
+		return (_options & Options::ShareUnchanged) && original.get() == clone.get();
+	}
+
+	ASTNode::Dependencies CopyVisitor::shared(const ASTNode::Dependencies& elements)
+	{
+		ASTNode::Dependencies shared{};
+		shared.reserve(elements.size());
+		for (const auto& element : elements) {
+			shared.emplace_back(element ? element->share() : nullptr);
+		}
+		return shared;
+	}
 }  // namespace soul::ast::visitors
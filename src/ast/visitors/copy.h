@@ -2,9 +2,12 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
+#include "ast/traversal.h"
 #include "ast/visitors/default_traverse.h"
+#include "core/types.h"
 
 #include <cassert>
+#include <optional>
 
 namespace soul::ast::visitors
 {
@@ -12,17 +15,36 @@ namespace soul::ast::visitors
 	 * @brief CopyVisitor traverses the AST and performs a deep copy on each node, which is then put into a separate
 	 * AST. Both trees are equal to each other, but exist as a separate objects in memory. It's most useful when a
 	 * visitor can/must modify the input tree.
+	 * @details With Options::ShareUnchanged the copy is made on write instead: nodes whose dependencies were not
+	 * replaced (by a derived visitor) are shared with the input tree (see ASTNode::share), thus only the paths from
+	 * the replaced nodes to the root are copied. Tree is cloned bottom-up without recursion (see ResultStack): the
+	 * dependencies are visited (and cloned) before the node itself, whose visit then takes their clones (see
+	 * CopyVisitor::clone), thus the depth of the tree is bounded only by the available memory.
+	 * @note Nodes might be shared between threads (see ASTNode::share), but the visitor itself must not be.
 	 */
 	class CopyVisitor : public DefaultTraverseVisitor
 	{
+		public:
+		enum Options : u8
+		{
+			None           = 0 << 0,
+			ShareUnchanged = 1 << 0,
+		};
+
 		protected:
 		ASTNode::Dependency _current_clone{};
 
+		private:
+		Options                          _options{};
+		ResultStack<ASTNode::Dependency> _clones{};
+
 		public:
+		CopyVisitor(Options options = Options::None);
+
 		/** @brief Returns the cloned (sub-) tree. */
 		ASTNode::Dependency cloned() noexcept;
 
-		using DefaultTraverseVisitor::accept;
+		void accept(ASTNode::Reference node) override;
 
 		[[nodiscard]] constexpr bool affects() const noexcept override { return true; }
 
@@ -46,6 +68,17 @@ namespace soul::ast::visitors
 		void visit(const VariableDeclarationNode&) override;
 		void visit(const WhileNode&) override;
 
+		/**
+		 * @brief Copies the type of the original node into its clone.
+		 * @important With Options::ShareUnchanged the clone might be the original node itself, thus derived visitors
+		 * must replace (instead of modify) the clones which are ASTNode::is_shared.
+		 */
+		static ASTNode::Dependency typed(ASTNode::Dependency clone, const ASTNode& original) noexcept;
+
+		/**
+		 * @brief Returns the clone of the (sub-) tree. Dependencies of the visited node were cloned already, thus
+		 * their clones are only taken (once), while any other tree is cloned anew.
+		 */
 		ASTNode::Dependency   clone(const ASTNode::Reference node);
 		ASTNode::Dependency   clone(const BinaryNode&);
 		ASTNode::ScopeBlock   clone(const BlockNode&);
@@ -73,5 +106,17 @@ namespace soul::ast::visitors
 			}
 			return cloned;
 		}
+
+		private:
+		/**
+		 * @brief Returns the clones of the elements, or std::nullopt if all of them are unchanged (see
+		 * Options::ShareUnchanged), in which case no container is allocated.
+		 */
+		std::optional<ASTNode::Dependencies> clone_changed(const ASTNode::Dependencies& elements);
+
+		bool unchanged(const ASTNode::Dependency& original, const ASTNode::Dependency& clone) const noexcept;
+
+		/** @brief Returns the elements shared with the original node (see ASTNode::share). */
+		static ASTNode::Dependencies shared(const ASTNode::Dependencies& elements);
 	};
 }  // namespace soul::ast::visitors
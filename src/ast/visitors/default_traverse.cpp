@@ -1,5 +1,7 @@
 #include "ast/visitors/default_traverse.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <utility>
 
 namespace soul::ast::visitors
@@ -9,61 +11,101 @@ namespace soul::ast::visitors
 		if (!node) {
 			return;
 		}
-		node->accept(*this);
+
+		// Deferred dependency is accepted by the loop below, thus only the node itself is visited.
+		if (std::exchange(_is_deferred, false)) {
+			dispatch(*node);
+			return;
+		}
+
+		const auto  base     = _pending.size();
+		const auto* previous = _current;
+		dispatch(*node);
+		while (_pending.size() > base) {
+			auto* pending = _pending.back();
+			_pending.pop_back();
+			_is_deferred = true;
+			accept(pending);
+			_is_deferred = false;
+		}
+		_current = previous;
+	}
+
+	void DefaultTraverseVisitor::traverse(const ASTNode& node, ASTNode::Reference dependency)
+	{
+		if (!dependency) {
+			return;
+		}
+		// NOTE: Node might have been visited directly (e.g. by an overridden visit), thus there is no loop to defer
+		// the dependency to.
+		if (&node != _current) {
+			accept(dependency);
+			return;
+		}
+		_pending.push_back(dependency);
+	}
+
+	void DefaultTraverseVisitor::dispatch(ASTNode& node)
+	{
+		const auto first = _pending.size();
+		_current         = &node;
+		node.accept(*this);
+		// Dependencies are popped in reverse order of deferring them.
+		std::reverse(std::begin(_pending) + static_cast<std::ptrdiff_t>(first), std::end(_pending));
 	}
 
 	void DefaultTraverseVisitor::visit(const BinaryNode& node)
 	{
-		accept(node.lhs.get());
-		accept(node.rhs.get());
+		traverse(node, node.lhs.get());
+		traverse(node, node.rhs.get());
 	}
 
 	void DefaultTraverseVisitor::visit(const BlockNode& node)
 	{
 		for (const auto& statement : node.statements) {
-			accept(statement.get());
+			traverse(node, statement.get());
 		}
 	}
 
-	void DefaultTraverseVisitor::visit(const CastNode& node) { accept(node.expression.get()); }
+	void DefaultTraverseVisitor::visit(const CastNode& node) { traverse(node, node.expression.get()); }
 
 	void DefaultTraverseVisitor::visit([[maybe_unused]] const ErrorNode& node) { /* Can't traverse further. */ }
 
 	void DefaultTraverseVisitor::visit(const ForLoopNode& node)
 	{
-		accept(node.initialization.get());
-		accept(node.condition.get());
-		accept(node.update.get());
-		accept(node.statements.get());
+		traverse(node, node.initialization.get());
+		traverse(node, node.condition.get());
+		traverse(node, node.update.get());
+		traverse(node, node.statements.get());
 	}
 
 	void DefaultTraverseVisitor::visit(const ForeachLoopNode& node)
 	{
-		accept(node.variable.get());
-		accept(node.in_expression.get());
-		accept(node.statements.get());
+		traverse(node, node.variable.get());
+		traverse(node, node.in_expression.get());
+		traverse(node, node.statements.get());
 	}
 
 	void DefaultTraverseVisitor::visit(const FunctionCallNode& node)
 	{
 		for (auto& param : node.parameters) {
-			accept(param.get());
+			traverse(node, param.get());
 		}
 	}
 
 	void DefaultTraverseVisitor::visit(const FunctionDeclarationNode& node)
 	{
 		for (auto& param : node.parameters) {
-			accept(param.get());
+			traverse(node, param.get());
 		}
-		accept(node.statements.get());
+		traverse(node, node.statements.get());
 	}
 
 	void DefaultTraverseVisitor::visit(const IfNode& node)
 	{
-		accept(node.condition.get());
-		accept(node.then_statements.get());
-		accept(node.else_statements.get());
+		traverse(node, node.condition.get());
+		traverse(node, node.then_statements.get());
+		traverse(node, node.else_statements.get());
 	}
 
 	void DefaultTraverseVisitor::visit([[maybe_unused]] const LiteralNode& node) { /* Can't traverse further. */ }
@@ -73,27 +115,27 @@ namespace soul::ast::visitors
 	void DefaultTraverseVisitor::visit(const ModuleNode& node)
 	{
 		for (const auto& statement : node.statements) {
-			accept(statement.get());
+			traverse(node, statement.get());
 		}
 	}
 
-	void DefaultTraverseVisitor::visit(const ReturnNode& node) { accept(node.expression.get()); }
+	void DefaultTraverseVisitor::visit(const ReturnNode& node) { traverse(node, node.expression.get()); }
 
 	void DefaultTraverseVisitor::visit(const StructDeclarationNode& node)
 	{
 		for (auto& param : node.parameters) {
-			accept(param.get());
+			traverse(node, param.get());
 		}
 	}
 
-	void DefaultTraverseVisitor::visit(const UnaryNode& node) { accept(node.expression.get()); }
+	void DefaultTraverseVisitor::visit(const UnaryNode& node) { traverse(node, node.expression.get()); }
 
-	void DefaultTraverseVisitor::visit(const VariableDeclarationNode& node) { accept(node.expression.get()); }
+	void DefaultTraverseVisitor::visit(const VariableDeclarationNode& node) { traverse(node, node.expression.get()); }
 
 	void DefaultTraverseVisitor::visit(const WhileNode& node)
 	{
-		accept(node.condition.get());
-		accept(node.statements.get());
+		traverse(node, node.condition.get());
+		traverse(node, node.statements.get());
 	}
 
 	void DefaultTraverseVisitor::visit(BinaryNode& node) { visit(std::as_const(node)); }
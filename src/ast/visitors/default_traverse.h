@@ -5,15 +5,26 @@
 #include "ast/visitors/visitor.h"
 
 #include <functional>
+#include <vector>
 
 namespace soul::ast::visitors
 {
 	/**
 	 * @brief DefaultTraverseVisitor traverses every node of the Abstract Syntax Tree.
 	 * It's useful for getting into a specific node.
+	 * @details Dependencies traversed by the default visits (of the nodes dispatched by DefaultTraverseVisitor::accept)
+	 * are deferred onto an explicit stack, and visited in the same order once the visit returns, thus the native
+	 * stack does not grow with the depth of the tree. Calling accept directly (e.g. from an overridden visit) still
+	 * traverses the whole (sub-) tree before returning, thus overridden visits which depend on their dependencies being
+	 * visited first must accept these themselves.
 	 */
 	class DefaultTraverseVisitor : public IVisitor
 	{
+		private:
+		std::vector<ASTNode::Reference> _pending     = {};
+		const ASTNode*                  _current     = nullptr;  // Node dispatched by DefaultTraverseVisitor::accept.
+		bool                            _is_deferred = false;
+
 		public:
 		virtual ~DefaultTraverseVisitor() = default;
 
@@ -55,5 +66,11 @@ namespace soul::ast::visitors
 		virtual void visit(UnaryNode&) override;
 		virtual void visit(VariableDeclarationNode&) override;
 		virtual void visit(WhileNode&) override;
+
+		/** @brief Traverses the dependency of a given node, after the visit of the node returns (if possible). */
+		void traverse(const ASTNode& node, ASTNode::Reference dependency);
+
+		private:
+		void dispatch(ASTNode& node);
 	};
 }  // namespace soul::ast::visitors
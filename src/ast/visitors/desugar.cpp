@@ -6,9 +6,9 @@ namespace soul::ast::visitors
 {
 	using namespace soul::types;
 
-	void DesugarVisitor::visit(const BinaryNode& node)
+	void DesugarVisitor::visit(BinaryNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
 		// BinaryNode(lhs, rhs, complex_assign) => BinaryNode(lhs, BinarNode(lhs, rhs, desugared_op), Assign)
 		static constexpr std::array k_complex_assignment_operators
@@ -20,51 +20,52 @@ namespace soul::ast::visitors
 		const auto it{ std::ranges::find(
 			k_complex_assignment_operators, node.op, &decltype(k_complex_assignment_operators)::value_type::first) };
 		if (it != std::end(k_complex_assignment_operators)) {
-			auto lhs_expression{ clone(node.lhs.get()) };
-			auto rhs_expression{ clone(node.rhs.get()) };
-			auto expression{ BinaryNode::create(std::move(lhs_expression), std::move(rhs_expression), it->second) };
+			// NOTE: Target is referred to twice, thus the other reference is a copy, which shares the nodes of the
+			// original (sub-) tree until these are rewritten (see RewriteVisitor::copy).
+			auto target{ copy(node.lhs.get()) };
+			auto expression{ BinaryNode::create(std::move(node.lhs), std::move(node.rhs), it->second) };
 			expression->type = node.type;
 
-			auto target{ clone(node.lhs.get()) };
-			_current_clone = BinaryNode::create(std::move(target), std::move(expression), ASTNode::Operator::Assign);
-			_current_clone->type = node.type;
+			node.lhs = std::move(target);
+			node.rhs = std::move(expression);
+			node.op  = ASTNode::Operator::Assign;
 		}
-	}  // namespace soul::ast::visitors
+	}
 
-	void DesugarVisitor::visit(const ForLoopNode& node)
+	void DesugarVisitor::visit(ForLoopNode& node)
 	{
 		// ForLoopNode(initialization, condition, update, BlockNode({...}))
 		// ...is equivalent to...
 		// BlockNode({initialization, WhileNode(condition, BlockNode({..., update}))})
 
-		CopyVisitor::visit(node);
-		auto& for_loop = _current_clone->as<ForLoopNode>();
+		RewriteVisitor::visit(node);
 
 		// WhileNode(condition, BlockNode({..., update}))
-		auto&& for_loop_statements   = for_loop.statements->as<BlockNode>().statements;
+		auto&& for_loop_statements   = node.statements->as<BlockNode>().statements;
 		auto   while_node_statements = ASTNode::Dependencies{};
 		while_node_statements.reserve(for_loop_statements.size() + 1);
 		while_node_statements.insert(while_node_statements.end(),
 		                             std::make_move_iterator(for_loop_statements.begin()),
 		                             std::make_move_iterator(for_loop_statements.end()));
 		if (node.update) {
-			while_node_statements.push_back(std::move(for_loop.update));
+			while_node_statements.push_back(std::move(node.update));
 		}
 		auto inner_scope  = BlockNode::create(std::move(while_node_statements));
-		inner_scope->type = for_loop.statements->type;
+		inner_scope->type = node.statements->type;
 
-		auto while_node{ WhileNode::create(std::move(for_loop.condition), std::move(inner_scope)) };
+		auto while_node{ WhileNode::create(std::move(node.condition), std::move(inner_scope)) };
 		while_node->type = node.type;
 
 		// BlockNode({initialization, <while_node>})
 		auto statements = ASTNode::Dependencies{};
 		statements.reserve(2);
-		if (for_loop.initialization) {
-			statements.push_back(std::move(for_loop.initialization));
+		if (node.initialization) {
+			statements.push_back(std::move(node.initialization));
 		}
 		statements.push_back(std::move(while_node));
 
-		_current_clone       = BlockNode::create(std::move(statements));
-		_current_clone->type = node.statements->type;
+		auto block_node  = BlockNode::create(std::move(statements));
+		block_node->type = node.statements->type;
+		replace(std::move(block_node));
 	}
 }  // namespace soul::ast::visitors
@@ -2,7 +2,7 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
-#include "ast/visitors/copy.h"
+#include "ast/visitors/rewrite.h"
 
 namespace soul::ast::visitors
 {
@@ -10,14 +10,14 @@ namespace soul::ast::visitors
 	 * @brief DesugarVisitor traverse the AST while substituting high-level nodes (such as ForNode or ForeachNode)
 	 * into a lower-level ones (such as WhileNode).
 	 */
-	class DesugarVisitor : public CopyVisitor
+	class DesugarVisitor : public RewriteVisitor
 	{
 		public:
-		using CopyVisitor::accept;
+		using RewriteVisitor::accept;
 
 		protected:
-		using CopyVisitor::visit;
-		void visit(const BinaryNode&) override;
-		void visit(const ForLoopNode&) override;
+		using RewriteVisitor::visit;
+		void visit(BinaryNode&) override;
+		void visit(ForLoopNode&) override;
 	};
 }  // namespace soul::ast::visitors
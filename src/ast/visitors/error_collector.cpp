@@ -1,9 +1,26 @@
 #include "ast/visitors/error_collector.h"
 
+#include "ast/traversal.h"
+
+#include <cassert>
+
 namespace soul::ast::visitors
 {
+#ifndef NDEBUG
+	namespace
+	{
+		/** @brief Counts the ErrorNodes in the (sub-) tree by traversing it, i.e. regardless of ASTNode::errors. */
+		std::size_t count_errors(ASTNode::Reference node)
+		{
+			std::size_t errors = 0;
+			TraversalStack{}.traverse(node, [&errors](const ASTNode& current) { errors += current.is<ErrorNode>(); });
+			return errors;
+		}
+	}  // namespace
+#endif
+
 	ErrorCollectorVisitor::ErrorCollectorVisitor(std::size_t max_depth)
-		: _depth_current(0), _depth_max(max_depth), _errors()
+		: _depth_current(0), _depth_max(max_depth), _error_count(0), _errors()
 	{
 	}
 
@@ -12,18 +29,36 @@ namespace soul::ast::visitors
 		if (!node) {
 			return;
 		}
+		if (!node->has_errors()) {
+			// NOTE: Subtree is skipped on the basis of its (cached) error count, which is stale if any of its nodes was
+			// modified without updating the ancestors (see ASTNode::update_errors), thus the errors would go missing.
+			assert(count_errors(node) == 0 && "error count of the (sub-) tree is stale, see ASTNode::update_errors");
+			return;
+		}
 
-		if (++_depth_current > _depth_max) {
+		if (_depth_current == 0) {
+			_error_count += node->errors();
+		}
+		if (_depth_current >= _depth_max) {
 			return;
 		}
-		node->accept(*this);
+		_depth_current++;
+		dispatch(*node);
 		_depth_current--;
 	}
 
-	bool ErrorCollectorVisitor::is_valid() const noexcept { return _errors.empty(); }
+	bool ErrorCollectorVisitor::is_valid() const noexcept { return _error_count == 0; }
 
 	const ErrorCollectorVisitor::Errors& ErrorCollectorVisitor::errors() const noexcept { return _errors; }
 
+	void ErrorCollectorVisitor::enter(const ASTNode& node)
+	{
+		if (_depth_current == 0) {
+			_error_count += node.errors();
+		}
+		_depth_current++;
+	}
+
 	void ErrorCollectorVisitor::visit(const ErrorNode& node)
 	{
 		if (_depth_current > _depth_max) {
@@ -31,4 +66,6 @@ namespace soul::ast::visitors
 		}
 		_errors.emplace_back(std::make_pair(_depth_current, &node));
 	}
+
+	void ErrorCollectorVisitor::leave([[maybe_unused]] const ASTNode& node) { _depth_current--; }
 }  // namespace soul::ast::visitors
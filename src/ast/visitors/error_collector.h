@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ast/ast.h"
-#include "ast/visitors/default_traverse.h"
+#include "ast/visitors/static_traverse.h"
 #include "core/types.h"
 
 #include <limits>
@@ -13,8 +13,13 @@ namespace soul::ast::visitors
 	/**
 	 * @brief ErrorPropagationVisitor traverses the AST while gathering info of any `ErrorNode`s that might be present.
 	 * @details Abstract Syntax Tree is well formed and semantically correct if it does not contain any `ErrorNode`s.
+	 * Subtrees without any errors (see ASTNode::has_errors) are skipped, thus only the paths leading to the errors
+	 * are traversed. Visitor defines the hooks of FusedVisitor as well, thus it can collect the errors alongside other
+	 * passes in a single traversal (which, however, does not skip any of the subtrees).
+	 * @note Debug builds verify that the skipped subtrees indeed do not contain any errors, i.e. that the error counts
+	 * were not left stale by a rewrite.
 	 */
-	class ErrorCollectorVisitor : public DefaultTraverseVisitor
+	class ErrorCollectorVisitor : public StaticTraverseVisitor<ErrorCollectorVisitor>
 	{
 		public:
 		using Errors = std::vector<std::pair<std::size_t, const ErrorNode*>>;
@@ -24,16 +29,19 @@ namespace soul::ast::visitors
 		private:
 		std::size_t _depth_current;
 		std::size_t _depth_max;
+		std::size_t _error_count;  // Number of errors in the accepted trees, including the ones past maximum depth.
 		Errors      _errors;
 
 		public:
 		ErrorCollectorVisitor(std::size_t max_depth = k_depth_max);
 
-		void accept(ASTNode::Reference node) override;
+		void accept(ASTNode::Reference node);
 
 		/**
 		 * @brief Returns true if the AST does not contain any error nodes, i.e. is well formed and semantically
 		 * correct.
+		 * @note Errors past maximum depth are taken into account as well. Checking a single tree does not require
+		 * the visitor at all, see ASTNode::has_errors.
 		 */
 		bool is_valid() const noexcept;
 
@@ -42,8 +50,12 @@ namespace soul::ast::visitors
 		 */
 		const Errors& errors() const noexcept;
 
+		void enter(const ASTNode& node);
+		void visit(const ErrorNode& node);
+		void leave(const ASTNode& node);
+
 		private:
-		using DefaultTraverseVisitor::visit;
-		void visit(const ErrorNode&) override;
+		friend StaticTraverseVisitor;
+		using StaticTraverseVisitor::visit;
 	};
 }  // namespace soul::ast::visitors
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+#include "ast/traversal.h"
+
+#include <tuple>
+#include <utility>
+
+namespace soul::ast::visitors
+{
+	/**
+	 * @brief FusedVisitor runs multiple read-only passes in a single traversal of the AST, thus the tree is read from
+	 * memory once, instead of once per pass.
+	 * @details Each pass is a (plain) class, which might define any of the following (public) hooks:
+	 * - `void enter(const ASTNode&)`, called with each node before its dependencies,
+	 * - `void visit(const Node&)`, called with each node of a given type (after enter), in the same order in which
+	 *   DefaultTraverseVisitor visits them; unlike in DefaultTraverseVisitor, the visit does not traverse the
+	 *   dependencies of the node itself,
+	 * - `void leave(const ASTNode&)`, called with each node after its dependencies.
+	 * At each node the hooks of the passes are called in the order in which the passes were given. Tree is traversed
+	 * without recursion (see TraversalStack).
+	 * @tparam Passes Types of the passes, which are referred to (instead of copied), thus their results can be read
+	 * once the traversal is done.
+	 */
+	template <typename... Passes>
+	class FusedVisitor
+	{
+		private:
+		std::tuple<Passes&...> _passes;
+		TraversalStack         _traversal = {};
+
+		public:
+		explicit FusedVisitor(Passes&... passes) noexcept : _passes(passes...) {}
+
+		/** @brief Traverses the (sub-) tree, calling the hooks of each pass at every node. */
+		void accept(ASTNode::Reference root)
+		{
+			_traversal.traverse(
+				root,
+				[this](const ASTNode& node) {
+					std::apply([&node](auto&... passes) { (enter(passes, node), ...); }, _passes);
+					dispatch(node);
+				},
+				[this](const ASTNode& node) {
+					std::apply([&node](auto&... passes) { (leave(passes, node), ...); }, _passes);
+				});
+		}
+
+		private:
+		/** @brief Calls the visits of the passes for the concrete type of the node. */
+		void dispatch(const ASTNode& node)
+		{
+			switch (node.kind()) {
+#define SOUL_AST_NODE(name)                                                                       \
+	case ASTNode::Kind::name:                                                                     \
+		std::apply([&node](auto&... passes) { (visit(passes, node.as<name>()), ...); }, _passes); \
+		return;
+				SOUL_AST_NODES
+#undef SOUL_AST_NODE
+			}
+			std::unreachable();
+		}
+
+		template <typename Pass>
+		static void enter(Pass& pass, const ASTNode& node)
+		{
+			if constexpr (requires { pass.enter(node); }) {
+				pass.enter(node);
+			}
+		}
+
+		template <typename Pass, NodeKind Node>
+		static void visit(Pass& pass, const Node& node)
+		{
+			if constexpr (requires { pass.visit(node); }) {
+				pass.visit(node);
+			}
+		}
+
+		template <typename Pass>
+		static void leave(Pass& pass, const ASTNode& node)
+		{
+			if constexpr (requires { pass.leave(node); }) {
+				pass.leave(node);
+			}
+		}
+	};
+}  // namespace soul::ast::visitors
@@ -2,12 +2,33 @@
 
 #include <array>
 #include <ranges>
+#include <utility>
 
 namespace soul::ast::visitors
 {
 	using namespace soul::types;
 	using namespace soul::ir;
 
+	namespace
+	{
+		/** @brief Verifies if the node is an expression, i.e. its dependencies are emitted before the node itself. */
+		bool is_expression(const ASTNode& node) noexcept
+		{
+			switch (node.kind()) {
+				case ASTNode::Kind::BinaryNode:
+				case ASTNode::Kind::CastNode:
+				case ASTNode::Kind::ErrorNode:
+				case ASTNode::Kind::FunctionCallNode:
+				case ASTNode::Kind::LiteralNode:
+				case ASTNode::Kind::UnaryNode:
+				case ASTNode::Kind::VariableDeclarationNode:
+					return true;
+				default:
+					return false;
+			}
+		}
+	}  // namespace
+
 	std::unique_ptr<Module> LowerVisitor::get() noexcept { return _builder.build(); }
 
 	void LowerVisitor::visit(const BinaryNode& node) { _current_instruction = emit(node); }
@@ -110,7 +131,7 @@ namespace soul::ast::visitors
 
 	void LowerVisitor::visit(const ModuleNode& node)
 	{
-		_builder.set_module_name(node.name);
+		_builder.set_module_name(node.name.view());
 		// NOTE: At the top level only FunctionDeclarationNodes should remain (and be visited).
 		for (const auto& statement : node.statements | std::views::filter([](const auto& e) -> bool {
 										 return e->template is<FunctionDeclarationNode>();
@@ -154,6 +175,30 @@ namespace soul::ast::visitors
 		if (!node) {
 			return nullptr;
 		}
+		if (auto instruction = _instructions.take(node)) {
+			return *instruction;
+		}
+
+		// NOTE: Remaining nodes (e.g. statements) are visited as they are, once (and if) their parent asks for them.
+		auto instruction = _instructions.compute(
+			node,
+			[this](const ASTNode& current) {
+				// Target of the assignment is written instead of read, thus it is not emitted (see emit(BinaryNode)).
+				if (&current == std::exchange(_assignment_target, nullptr) || !is_expression(current)) {
+					return false;
+				}
+				if (current.is<BinaryNode>() && current.as<BinaryNode>().op == ASTNode::Operator::Assign) {
+					_assignment_target = current.as<BinaryNode>().lhs.get();
+				}
+				return true;
+			},
+			[this](ASTNode& current) {
+				current.accept(*this);
+				return _current_instruction;
+			});
+		if (instruction) {
+			return *instruction;
+		}
 		node->accept(*this);
 		return _current_instruction;
 	}
@@ -167,8 +212,8 @@ namespace soul::ast::visitors
 			const bool is_write_target = node.lhs->is<LiteralNode>()
 			                          && node.lhs->as<LiteralNode>().literal_type == LiteralNode::Type::Identifier;
 			if (is_write_target) {
-				const auto& identifier = node.lhs->as<LiteralNode>().value.get<std::string>();
-				auto*       value{ emit(node.rhs.get()) };
+				const auto identifier = node.lhs->as<LiteralNode>().value.get<Symbol>();
+				auto*        value{ emit(node.rhs.get()) };
 				return _builder.emit_upsilon(identifier, value);
 			}
 
@@ -270,7 +315,7 @@ namespace soul::ast::visitors
 		// IMPORTANT: We assume that visiting LiteralNode will always result in the READ operation for Identifiers, as
 		// any special (i.e. writing) logic will be handled beforehand.
 		if (node.literal_type == LiteralNode::Type::Identifier) {
-			return _builder.emit_phi(node.value.get<std::string>(), node.type);
+			return _builder.emit_phi(node.value.get<Symbol>(), node.type);
 		}
 		return _builder.emit<Const>(node.type, node.value);
 	}
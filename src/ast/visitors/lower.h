@@ -2,6 +2,7 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
+#include "ast/traversal.h"
 #include "ast/visitors/default_traverse.h"
 
 #include "ir/builder.h"
@@ -19,8 +20,10 @@ namespace soul::ast::visitors
 	class LowerVisitor : public DefaultTraverseVisitor
 	{
 		private:
-		ir::IRBuilder    _builder{};
-		ir::Instruction* _current_instruction = nullptr;
+		ir::IRBuilder                 _builder{};
+		ir::Instruction*              _current_instruction = nullptr;
+		ResultStack<ir::Instruction*> _instructions{};
+		const ASTNode*                _assignment_target = nullptr;
 
 		public:
 		/** @brief Returns IR representation equivalent to the AST. */
@@ -48,6 +51,9 @@ namespace soul::ast::visitors
 
 		/**
 		 * @brief Visits the specified node and emits its equivalent instruction(s).
+		 * @details Operands of the expressions are emitted bottom-up without recursion (see ResultStack), i.e. before
+		 * the expression itself, whose emit then takes their instructions, thus the depth of the expressions is
+		 * bounded only by the available memory.
 		 * @warning Some nodes may not be visited directly and should be handled separately (see implementation).
 		 */
 		ir::Instruction* emit(const ASTNode::Reference);
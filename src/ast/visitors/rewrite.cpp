@@ -0,0 +1,233 @@
+#include "ast/visitors/rewrite.h"
+
+#include "ast/visitors/copy.h"
+
+#include <utility>
+
+namespace soul::ast::visitors
+{
+	namespace
+	{
+		ASTNode::Dependency share(const ASTNode::Dependency& dependency)
+		{
+			return dependency ? dependency->share() : nullptr;
+		}
+
+		ASTNode::Dependencies share(const ASTNode::Dependencies& dependencies)
+		{
+			ASTNode::Dependencies shared{};
+			shared.reserve(dependencies.size());
+			for (const auto& dependency : dependencies) {
+				shared.emplace_back(share(dependency));
+			}
+			return shared;
+		}
+
+		ASTNode::Dependency shallow_copy(const ASTNode& node)
+		{
+			switch (node.kind()) {
+				case ASTNode::Kind::BinaryNode: {
+					const auto& binary = node.as<BinaryNode>();
+					return BinaryNode::create(share(binary.lhs), share(binary.rhs), binary.op);
+				}
+				case ASTNode::Kind::BlockNode: {
+					return BlockNode::create(share(node.as<BlockNode>().statements));
+				}
+				case ASTNode::Kind::CastNode: {
+					const auto& cast = node.as<CastNode>();
+					return CastNode::create(share(cast.expression), cast.type_identifier);
+				}
+				case ASTNode::Kind::ErrorNode: {
+					return ErrorNode::create(node.as<ErrorNode>().message);
+				}
+				case ASTNode::Kind::ForLoopNode: {
+					const auto& for_loop = node.as<ForLoopNode>();
+					return ForLoopNode::create(share(for_loop.initialization),
+					                           share(for_loop.condition),
+					                           share(for_loop.update),
+					                           share(for_loop.statements));
+				}
+				case ASTNode::Kind::ForeachLoopNode: {
+					const auto& foreach_loop = node.as<ForeachLoopNode>();
+					return ForeachLoopNode::create(share(foreach_loop.variable),
+					                               share(foreach_loop.in_expression),
+					                               share(foreach_loop.statements));
+				}
+				case ASTNode::Kind::FunctionCallNode: {
+					const auto& function_call = node.as<FunctionCallNode>();
+					return FunctionCallNode::create(function_call.name, share(function_call.parameters));
+				}
+				case ASTNode::Kind::FunctionDeclarationNode: {
+					const auto& function = node.as<FunctionDeclarationNode>();
+					return FunctionDeclarationNode::create(function.name,
+					                                       function.type_identifier,
+					                                       share(function.parameters),
+					                                       share(function.statements));
+				}
+				case ASTNode::Kind::IfNode: {
+					const auto& if_node = node.as<IfNode>();
+					return IfNode::create(
+						share(if_node.condition), share(if_node.then_statements), share(if_node.else_statements));
+				}
+				case ASTNode::Kind::LiteralNode: {
+					const auto& literal = node.as<LiteralNode>();
+					return LiteralNode::create(literal.value, literal.literal_type);
+				}
+				case ASTNode::Kind::LoopControlNode: {
+					return LoopControlNode::create(node.as<LoopControlNode>().control_type);
+				}
+				case ASTNode::Kind::ModuleNode: {
+					const auto& module = node.as<ModuleNode>();
+					auto        copy   = ModuleNode::create(module.name, share(module.statements), module.source);
+					// NOTE: Shared statements might be owned by the arena of the original module.
+					auto& arena = copy->as<ModuleNode>().arena;
+					if (!arena) {
+						arena = module.arena;
+					} else {
+						arena->retain(module.arena);
+					}
+					return copy;
+				}
+				case ASTNode::Kind::ReturnNode: {
+					return ReturnNode::create(share(node.as<ReturnNode>().expression));
+				}
+				case ASTNode::Kind::StructDeclarationNode: {
+					const auto& struct_declaration = node.as<StructDeclarationNode>();
+					return StructDeclarationNode::create(struct_declaration.name, share(struct_declaration.parameters));
+				}
+				case ASTNode::Kind::UnaryNode: {
+					const auto& unary = node.as<UnaryNode>();
+					return UnaryNode::create(share(unary.expression), unary.op);
+				}
+				case ASTNode::Kind::VariableDeclarationNode: {
+					const auto& variable = node.as<VariableDeclarationNode>();
+					return VariableDeclarationNode::create(
+						variable.name, variable.type_identifier, share(variable.expression), variable.is_mutable);
+				}
+				case ASTNode::Kind::WhileNode: {
+					const auto& while_node = node.as<WhileNode>();
+					return WhileNode::create(share(while_node.condition), share(while_node.statements));
+				}
+			}
+			std::unreachable();
+		}
+	}  // namespace
+
+	void RewriteVisitor::accept(ASTNode::Dependency& root) { rewrite(root); }
+
+	void RewriteVisitor::accept(ASTNode::Reference root)
+	{
+		_root = copy(root);
+		rewrite(_root);
+	}
+
+	ASTNode::Dependency RewriteVisitor::cloned() noexcept { return std::move(_root); }
+
+	void RewriteVisitor::visit(BinaryNode& node)
+	{
+		rewrite(node.lhs);
+		rewrite(node.rhs);
+	}
+
+	void RewriteVisitor::visit(BlockNode& node) { rewrite(node.statements); }
+
+	void RewriteVisitor::visit(CastNode& node) { rewrite(node.expression); }
+
+	void RewriteVisitor::visit([[maybe_unused]] ErrorNode& node) { /* Can't traverse further. */ }
+
+	void RewriteVisitor::visit(ForLoopNode& node)
+	{
+		rewrite(node.initialization);
+		rewrite(node.condition);
+		rewrite(node.update);
+		rewrite(node.statements);
+	}
+
+	void RewriteVisitor::visit(ForeachLoopNode& node)
+	{
+		rewrite(node.variable);
+		rewrite(node.in_expression);
+		rewrite(node.statements);
+	}
+
+	void RewriteVisitor::visit(FunctionCallNode& node) { rewrite(node.parameters); }
+
+	void RewriteVisitor::visit(FunctionDeclarationNode& node)
+	{
+		rewrite(node.parameters);
+		rewrite(node.statements);
+	}
+
+	void RewriteVisitor::visit(IfNode& node)
+	{
+		rewrite(node.condition);
+		rewrite(node.then_statements);
+		rewrite(node.else_statements);
+	}
+
+	void RewriteVisitor::visit([[maybe_unused]] LiteralNode& node) { /* Can't traverse further. */ }
+
+	void RewriteVisitor::visit([[maybe_unused]] LoopControlNode& node) { /* Can't traverse further. */ }
+
+	void RewriteVisitor::visit(ModuleNode& node) { rewrite(node.statements); }
+
+	void RewriteVisitor::visit(ReturnNode& node) { rewrite(node.expression); }
+
+	void RewriteVisitor::visit(StructDeclarationNode& node) { rewrite(node.parameters); }
+
+	void RewriteVisitor::visit(UnaryNode& node) { rewrite(node.expression); }
+
+	void RewriteVisitor::visit(VariableDeclarationNode& node) { rewrite(node.expression); }
+
+	void RewriteVisitor::visit(WhileNode& node)
+	{
+		rewrite(node.condition);
+		rewrite(node.statements);
+	}
+
+	void RewriteVisitor::rewrite(ASTNode::Dependency& dependency)
+	{
+		if (!dependency) {
+			return;
+		}
+
+		if (dependency->is_shared()) {
+			dependency = detach(*dependency);
+		}
+
+		// NOTE: Parent might have requested its replacement before rewriting its dependencies.
+		auto pending = std::exchange(_replacement, nullptr);
+		dependency->accept(*this);
+		if (_replacement) {
+			dependency = std::move(_replacement);
+		}
+		// NOTE: Visit might have modified the node (or any of its dependencies), thus its cached hash is stale, and
+		// its errors have to be recounted (from its already rewritten dependencies).
+		dependency->invalidate_hash();
+		dependency->update_errors();
+		_replacement = std::move(pending);
+	}
+
+	void RewriteVisitor::rewrite(ASTNode::Dependencies& dependencies)
+	{
+		for (auto& dependency : dependencies) {
+			rewrite(dependency);
+		}
+	}
+
+	void RewriteVisitor::replace(ASTNode::Dependency node) noexcept { _replacement = std::move(node); }
+
+	ASTNode::Dependency RewriteVisitor::copy(ASTNode::Reference node)
+	{
+		CopyVisitor copy_visitor{ CopyVisitor::Options::ShareUnchanged };
+		copy_visitor.accept(node);
+		return copy_visitor.cloned();
+	}
+
+	ASTNode::Dependency RewriteVisitor::detach(const ASTNode& node)
+	{
+		auto detached{ shallow_copy(node) };
+		detached->type = node.type;
+		return detached;
+	}
+}  // namespace soul::ast::visitors
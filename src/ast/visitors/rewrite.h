@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+#include "ast/visitors/visitor.h"
+
+namespace soul::ast::visitors
+{
+	/**
+	 * @brief RewriteVisitor traverses the AST while letting each visit mutate the node in place, or replace it
+	 * altogether (see RewriteVisitor::replace), thus passes do not have to copy the whole tree.
+	 * @details Dependencies are rewritten (in order) by the base visits, i.e. before the derived visit inspects them.
+	 * Callers which need to keep the original tree can still pass it by reference, in which case it is copied once
+	 * and the copy is rewritten instead (see RewriteVisitor::cloned). Cached hashes of the visited nodes are
+	 * invalidated (see ASTNode::hash) and their errors are recounted (see ASTNode::errors).
+	 * @important Nodes shared with other trees (see ASTNode::is_shared) are never modified; each one is detached
+	 * first, i.e. replaced by its copy, which shares the dependencies in turn (see RewriteVisitor::detach).
+	 * @note Unlike CopyVisitor, rewriting recurses into the dependencies, as the derived visits inspect these once
+	 * rewritten (e.g. to resolve the type of the node), thus the depth of the tree is bounded by the native stack.
+	 */
+	class RewriteVisitor : public IVisitor
+	{
+		protected:
+		ASTNode::Dependency _replacement{};
+
+		private:
+		ASTNode::Dependency _root{};
+
+		public:
+		/**
+		 * @brief Rewrites the (sub-) tree in place.
+		 * @param root Root of the tree, which might be replaced as well.
+		 */
+		void accept(ASTNode::Dependency& root);
+
+		/**
+		 * @brief Rewrites a copy of the (sub-) tree, leaving the original intact.
+		 */
+		void accept(ASTNode::Reference root);
+
+		/** @brief Returns the rewritten copy of the (sub-) tree passed by reference. */
+		ASTNode::Dependency cloned() noexcept;
+
+		[[nodiscard]] constexpr bool affects() const noexcept override { return true; }
+
+		protected:
+		using IVisitor::visit;
+		void visit(BinaryNode&) override;
+		void visit(BlockNode&) override;
+		void visit(CastNode&) override;
+		void visit(ErrorNode&) override;
+		void visit(ForLoopNode&) override;
+		void visit(ForeachLoopNode&) override;
+		void visit(FunctionCallNode&) override;
+		void visit(FunctionDeclarationNode&) override;
+		void visit(IfNode&) override;
+		void visit(LiteralNode&) override;
+		void visit(LoopControlNode&) override;
+		void visit(ModuleNode&) override;
+		void visit(ReturnNode&) override;
+		void visit(StructDeclarationNode&) override;
+		void visit(UnaryNode&) override;
+		void visit(VariableDeclarationNode&) override;
+		void visit(WhileNode&) override;
+
+		/** @brief Visits the dependency, replacing it if requested. */
+		void rewrite(ASTNode::Dependency& dependency);
+		void rewrite(ASTNode::Dependencies& dependencies);
+
+		/**
+		 * @brief Replaces the node which is currently visited, once its visit returns.
+		 * @important Replaced node is destroyed afterwards, thus its dependencies must be moved out of it first.
+		 */
+		void replace(ASTNode::Dependency node) noexcept;
+
+		/**
+		 * @brief Returns a copy of the (sub-) tree, e.g. for nodes which are referred to more than once.
+		 * @details Copy shares its nodes with the original (see CopyVisitor::Options::ShareUnchanged), thus these are
+		 * only copied once (and if) rewritten.
+		 */
+		[[nodiscard]] static ASTNode::Dependency copy(ASTNode::Reference node);
+
+		/** @brief Returns a (shallow) copy of the shared node, whose dependencies are shared in turn. */
+		[[nodiscard]] static ASTNode::Dependency detach(const ASTNode& node);
+	};
+}  // namespace soul::ast::visitors
@@ -0,0 +1,752 @@
+#include "ast/visitors/serialize.h"
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace soul::ast::visitors
+{
+	using namespace soul::types;
+
+	namespace
+	{
+		/**
+		 * @brief Tag preceding each node in the binary representation; Null denotes an absent (optional) node.
+		 */
+		enum class NodeTag : u8
+		{
+			Null,
+			Binary,
+			Block,
+			Cast,
+			Error,
+			ForLoop,
+			ForeachLoop,
+			FunctionCall,
+			FunctionDeclaration,
+			If,
+			Literal,
+			LoopControl,
+			Module,
+			Return,
+			StructDeclaration,
+			Unary,
+			VariableDeclaration,
+			While,
+		};
+
+		/**
+		 * @brief Tag preceding each value, equal to the index of its alternative in Value::Variant.
+		 */
+		enum class ValueTag : u8
+		{
+			Unknown,
+			Boolean,
+			Integer,
+			Float,
+			String,
+			Char,
+			Symbol,
+		};
+
+		/**
+		 * @brief Tag preceding each type, equal to the index of its alternative in Type::Variant.
+		 */
+		enum class TypeTag : u8
+		{
+			Primitive,
+			Array,
+			Struct,
+		};
+
+		/**
+		 * @brief Reconstructs the AST from its binary representation, see SerializeVisitor.
+		 * @details Representation is treated as untrusted input, i.e. every read is bounds checked and every
+		 * enumeration is validated; once any of these fail, the whole representation is rejected.
+		 */
+		class Deserializer
+		{
+			private:
+			// Each level of nesting is at least one byte long, thus this bounds the recursion for malformed input.
+			static constexpr std::size_t k_max_depth = SerializeVisitor::k_max_depth;
+
+			private:
+			std::string_view        _bytes   = {};
+			std::size_t             _offset  = 0;
+			bool                    _failed  = false;
+			std::span<const Symbol> _symbols = {};
+
+			public:
+			/**
+			 * @param bytes Representation, which has to be read up to its end.
+			 * @param offset Offset to start reading from.
+			 * @param symbols Symbol table, which the identifiers refer to.
+			 */
+			explicit Deserializer(std::string_view bytes, std::size_t offset, std::span<const Symbol> symbols = {})
+				: _bytes(bytes),
+				  _offset(std::min(offset, bytes.size())),
+				  _failed(offset > bytes.size()),
+				  _symbols(symbols)
+			{
+			}
+
+			[[nodiscard]] bool failed() const noexcept { return _failed; }
+
+			[[nodiscard]] bool at_end() const noexcept { return !_failed && _offset == _bytes.size(); }
+
+			ASTNode::Dependency read_root()
+			{
+				auto root = read_node(0);
+				if (!at_end()) {
+					return nullptr;
+				}
+				return root;
+			}
+
+			std::vector<Symbol> read_symbol_table()
+			{
+				const auto count = read_varint();
+				if (_failed || count > remaining()) {
+					_failed = true;
+					return {};
+				}
+				std::vector<Symbol> symbols{};
+				symbols.reserve(count);
+				for (u64 index = 0; index < count && !_failed; ++index) {
+					// NOTE: Names are not trusted, thus they must not grow the (global) table without bounds.
+					const auto symbol = Symbol::try_intern(read_string());
+					if (!symbol) {
+						_failed = true;
+						return {};
+					}
+					symbols.push_back(*symbol);
+				}
+				return symbols;
+			}
+
+			/**
+			 * @brief Reads the header of the root node, if it is a ModuleNode.
+			 * @return Offset of the statement offsets, or zero if the root is not a module.
+			 */
+			std::size_t read_module_header(Symbol& name, std::size_t& count)
+			{
+				if (remaining() == 0 || static_cast<NodeTag>(_bytes[_offset]) != NodeTag::Module) {
+					return 0;
+				}
+				++_offset;
+				[[maybe_unused]] const auto type = read_type(0);
+				name                             = read_symbol();
+				count                            = read_varint();
+				if (_failed || count > remaining() / sizeof(u32)) {
+					_failed = true;
+					return 0;
+				}
+				return _offset;
+			}
+
+			u32 read_u32()
+			{
+				u32 value = 0;
+				for (u32 index = 0; index < sizeof(value); ++index) {
+					value |= static_cast<u32>(read_u8()) << (index * 8);
+				}
+				return value;
+			}
+
+			private:
+			std::size_t remaining() const noexcept { return _bytes.size() - _offset; }
+
+			u8 read_u8()
+			{
+				if (remaining() == 0) {
+					_failed = true;
+					return 0;
+				}
+				return static_cast<u8>(_bytes[_offset++]);
+			}
+
+			u64 read_varint()
+			{
+				u64 value = 0;
+				for (u32 shift = 0; shift < 64; shift += 7) {
+					const auto byte = read_u8();
+					value |= static_cast<u64>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0) {
+						return value;
+					}
+				}
+				_failed = true;
+				return 0;
+			}
+
+			template <typename Enum>
+			Enum read_enum(Enum last)
+			{
+				const auto value = read_u8();
+				if (value > std::to_underlying(last)) {
+					_failed = true;
+				}
+				return static_cast<Enum>(value);
+			}
+
+			std::string_view read_string()
+			{
+				const auto length = read_varint();
+				if (_failed || length > remaining()) {
+					_failed = true;
+					return {};
+				}
+				const auto string = _bytes.substr(_offset, length);
+				_offset += length;
+				return string;
+			}
+
+			Symbol read_symbol()
+			{
+				const auto index = read_varint();
+				if (_failed || index >= _symbols.size()) {
+					_failed = true;
+					return {};
+				}
+				return _symbols[index];
+			}
+
+			Type read_type(std::size_t depth)
+			{
+				if (depth > k_max_depth) {
+					_failed = true;
+					return {};
+				}
+				switch (read_enum(TypeTag::Struct)) {
+					case TypeTag::Primitive:
+						return Type{ read_enum(PrimitiveType::Kind::Void) };
+					case TypeTag::Array:
+						return Type{ Type::Variant{ ArrayType{ read_type(depth + 1) } } };
+					case TypeTag::Struct:
+					{
+						const auto count = read_varint();
+						if (_failed || count > remaining()) {
+							_failed = true;
+							return {};
+						}
+						StructType::ContainedTypes types{};
+						types.reserve(count);
+						for (u64 index = 0; index < count; ++index) {
+							types.emplace_back(read_type(depth + 1));
+						}
+						return Type{ Type::Variant{ StructType{ std::move(types) } } };
+					}
+				}
+				return {};
+			}
+
+			Value read_value()
+			{
+				switch (read_enum(ValueTag::Symbol)) {
+					case ValueTag::Unknown:
+						return Value{};
+					case ValueTag::Boolean:
+						return Value{ Value::Variant{ std::in_place_type<bool>, read_u8() != 0 } };
+					case ValueTag::Integer:
+					{
+						// Integers are zigzag encoded, thus small negative values are short as well.
+						const auto zigzag = read_varint();
+						const auto value  = static_cast<i64>(zigzag >> 1) ^ -static_cast<i64>(zigzag & 1);
+						return Value{ Value::Variant{ std::in_place_type<i64>, value } };
+					}
+					case ValueTag::Float:
+					{
+						u64 bits = 0;
+						for (u32 index = 0; index < sizeof(bits); ++index) {
+							bits |= static_cast<u64>(read_u8()) << (index * 8);
+						}
+						return Value{ Value::Variant{ std::in_place_type<f64>, std::bit_cast<f64>(bits) } };
+					}
+					case ValueTag::String:
+						return Value{ Value::Variant{ std::in_place_type<std::string>, read_string() } };
+					case ValueTag::Char:
+						return Value{ Value::Variant{ std::in_place_type<char>, static_cast<char>(read_u8()) } };
+					case ValueTag::Symbol:
+						return Value{ read_symbol() };
+				}
+				return Value{};
+			}
+
+			ASTNode::Dependencies read_dependencies(std::size_t depth)
+			{
+				const auto count = read_varint();
+				if (_failed || count > remaining()) {
+					_failed = true;
+					return {};
+				}
+				ASTNode::Dependencies dependencies{};
+				dependencies.reserve(count);
+				for (u64 index = 0; index < count && !_failed; ++index) {
+					dependencies.emplace_back(read_node(depth));
+				}
+				return dependencies;
+			}
+
+			ASTNode::Dependency read_node(std::size_t depth)
+			{
+				if (depth > k_max_depth) {
+					_failed = true;
+					return nullptr;
+				}
+
+				const auto tag = read_enum(NodeTag::While);
+				if (_failed || tag == NodeTag::Null) {
+					return nullptr;
+				}
+				auto type = read_type(0);
+				auto node = read_fields(tag, depth + 1);
+				if (_failed) {
+					return nullptr;
+				}
+				node->type = std::move(type);
+				return node;
+			}
+
+			ASTNode::Dependency read_fields(NodeTag tag, std::size_t depth)
+			{
+				// NOTE: Order of evaluation of function arguments is unspecified, thus each field is read separately.
+				switch (tag) {
+					case NodeTag::Null:
+						break;
+					case NodeTag::Binary:
+					{
+						const auto op  = read_enum(ASTNode::Operator::LogicalOr);
+						auto       lhs = read_node(depth);
+						auto       rhs = read_node(depth);
+						return BinaryNode::create(std::move(lhs), std::move(rhs), op);
+					}
+					case NodeTag::Block:
+						return BlockNode::create(read_dependencies(depth));
+					case NodeTag::Cast:
+					{
+						const auto type_identifier = read_symbol();
+						return CastNode::create(read_node(depth), type_identifier);
+					}
+					case NodeTag::Error:
+						return ErrorNode::create(ErrorNode::Message{ read_string() });
+					case NodeTag::ForLoop:
+					{
+						auto initialization = read_node(depth);
+						auto condition      = read_node(depth);
+						auto update         = read_node(depth);
+						auto statements     = read_node(depth);
+						return ForLoopNode::create(
+							std::move(initialization), std::move(condition), std::move(update), std::move(statements));
+					}
+					case NodeTag::ForeachLoop:
+					{
+						auto variable      = read_node(depth);
+						auto in_expression = read_node(depth);
+						auto statements    = read_node(depth);
+						return ForeachLoopNode::create(
+							std::move(variable), std::move(in_expression), std::move(statements));
+					}
+					case NodeTag::FunctionCall:
+					{
+						const auto name = read_symbol();
+						return FunctionCallNode::create(name, read_dependencies(depth));
+					}
+					case NodeTag::FunctionDeclaration:
+					{
+						const auto name            = read_symbol();
+						const auto type_identifier = read_symbol();
+						auto       parameters      = read_dependencies(depth);
+						auto       statements      = read_node(depth);
+						return FunctionDeclarationNode::create(
+							name, type_identifier, std::move(parameters), std::move(statements));
+					}
+					case NodeTag::If:
+					{
+						auto condition       = read_node(depth);
+						auto then_statements = read_node(depth);
+						auto else_statements = read_node(depth);
+						return IfNode::create(std::move(condition), std::move(then_statements), std::move(else_statements));
+					}
+					case NodeTag::Literal:
+					{
+						const auto literal_type = read_enum(LiteralNode::Type::String);
+						return LiteralNode::create(read_value(), literal_type);
+					}
+					case NodeTag::LoopControl:
+						return LoopControlNode::create(read_enum(LoopControlNode::Type::Continue));
+					case NodeTag::Module:
+					{
+						const auto name  = read_symbol();
+						const auto count = read_varint();
+						if (_failed || count > remaining() / sizeof(u32)) {
+							break;
+						}
+						std::vector<u32> offsets(count);
+						for (auto& offset : offsets) {
+							offset = read_u32();
+						}
+						ASTNode::Dependencies statements{};
+						statements.reserve(count);
+						for (const auto offset : offsets) {
+							if (_failed || _offset != offset) {
+								_failed = true;
+								return nullptr;
+							}
+							statements.emplace_back(read_node(depth));
+						}
+						return ModuleNode::create(name, std::move(statements));
+					}
+					case NodeTag::Return:
+						return ReturnNode::create(read_node(depth));
+					case NodeTag::StructDeclaration:
+					{
+						const auto name = read_symbol();
+						return StructDeclarationNode::create(name, read_dependencies(depth));
+					}
+					case NodeTag::Unary:
+					{
+						const auto op = read_enum(ASTNode::Operator::LogicalOr);
+						return UnaryNode::create(read_node(depth), op);
+					}
+					case NodeTag::VariableDeclaration:
+					{
+						const auto name            = read_symbol();
+						const auto type_identifier = read_symbol();
+						const auto is_mutable      = read_u8() != 0;
+						return VariableDeclarationNode::create(name, type_identifier, read_node(depth), is_mutable);
+					}
+					case NodeTag::While:
+					{
+						auto condition  = read_node(depth);
+						auto statements = read_node(depth);
+						return WhileNode::create(std::move(condition), std::move(statements));
+					}
+				}
+				_failed = true;
+				return nullptr;
+			}
+		};
+	}  // namespace
+
+	std::optional<SerializedAST> SerializedAST::open(std::string_view bytes)
+	{
+		SerializedAST result{};
+		result._bytes = bytes;
+
+		Deserializer header{ bytes, 0 };
+		result._nodes_end = header.read_u32();
+		if (header.failed() || result._nodes_end < sizeof(u32) || result._nodes_end > bytes.size()) {
+			return std::nullopt;
+		}
+
+		Deserializer symbol_table{ bytes, result._nodes_end };
+		result._symbols = symbol_table.read_symbol_table();
+		if (!symbol_table.at_end()) {
+			return std::nullopt;
+		}
+
+		Deserializer root{ bytes.substr(0, result._nodes_end), sizeof(u32), result._symbols };
+		result._statements = root.read_module_header(result._name, result._count);
+		if (root.failed()) {
+			return std::nullopt;
+		}
+
+		// NOTE: Offsets are validated once, thus each statement can be read by itself afterwards.
+		auto previous = result._statements + (result._count * sizeof(u32));
+		for (std::size_t index = 0; index < result._count; ++index) {
+			const auto offset = result.statement_offset(index);
+			if (offset < previous || offset >= result._nodes_end) {
+				return std::nullopt;
+			}
+			previous = offset + 1;
+		}
+		return result;
+	}
+
+	ASTNode::Dependency SerializedAST::deserialize() const
+	{
+		return Deserializer{ _bytes.substr(0, _nodes_end), sizeof(u32), _symbols }.read_root();
+	}
+
+	ASTNode::Dependency SerializedAST::deserialize_statement(std::size_t index) const
+	{
+		if (index >= _count) {
+			return nullptr;
+		}
+		const auto end = index + 1 < _count ? statement_offset(index + 1) : _nodes_end;
+		return Deserializer{ _bytes.substr(0, end), statement_offset(index), _symbols }.read_root();
+	}
+
+	std::size_t SerializedAST::statement_offset(std::size_t index) const noexcept
+	{
+		return Deserializer{ _bytes, _statements + (index * sizeof(u32)) }.read_u32();
+	}
+
+	ASTNode::Dependency SerializeVisitor::deserialize(std::string_view bytes)
+	{
+		const auto serialized_ast = SerializedAST::open(bytes);
+		return serialized_ast ? serialized_ast->deserialize() : nullptr;
+	}
+
+	void SerializeVisitor::accept(ASTNode::Reference node)
+	{
+		if (_depth == 0) {
+			// NOTE: Offset of the symbol table is known only once the whole tree is written, see write_symbol_table.
+			_bytes.clear();
+			_symbols.clear();
+			_symbol_table.clear();
+			_complete = true;
+			_bytes.append(sizeof(u32), '\0');
+		}
+
+		if (node && _depth > k_max_depth) {
+			// NOTE: Such node could not be deserialized, which also bounds the recursion.
+			_complete = false;
+			node      = nullptr;
+		}
+
+		++_depth;
+		if (node) {
+			node->accept(*this);
+		} else {
+			_bytes.push_back(static_cast<char>(NodeTag::Null));
+		}
+		if (--_depth == 0) {
+			write_symbol_table();
+		}
+	}
+
+	void SerializeVisitor::visit(const BinaryNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Binary), node);
+		_bytes.push_back(static_cast<char>(node.op));
+		accept(node.lhs.get());
+		accept(node.rhs.get());
+	}
+
+	void SerializeVisitor::visit(const BlockNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Block), node);
+		write_dependencies(node.statements);
+	}
+
+	void SerializeVisitor::visit(const CastNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Cast), node);
+		write_symbol(node.type_identifier);
+		accept(node.expression.get());
+	}
+
+	void SerializeVisitor::visit(const ErrorNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Error), node);
+		write_string(node.message);
+	}
+
+	void SerializeVisitor::visit(const ForLoopNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::ForLoop), node);
+		accept(node.initialization.get());
+		accept(node.condition.get());
+		accept(node.update.get());
+		accept(node.statements.get());
+	}
+
+	void SerializeVisitor::visit(const ForeachLoopNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::ForeachLoop), node);
+		accept(node.variable.get());
+		accept(node.in_expression.get());
+		accept(node.statements.get());
+	}
+
+	void SerializeVisitor::visit(const FunctionCallNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::FunctionCall), node);
+		write_symbol(node.name);
+		write_dependencies(node.parameters);
+	}
+
+	void SerializeVisitor::visit(const FunctionDeclarationNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::FunctionDeclaration), node);
+		write_symbol(node.name);
+		write_symbol(node.type_identifier);
+		write_dependencies(node.parameters);
+		accept(node.statements.get());
+	}
+
+	void SerializeVisitor::visit(const IfNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::If), node);
+		accept(node.condition.get());
+		accept(node.then_statements.get());
+		accept(node.else_statements.get());
+	}
+
+	void SerializeVisitor::visit(const LiteralNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Literal), node);
+		_bytes.push_back(static_cast<char>(node.literal_type));
+		write_value(node.value);
+	}
+
+	void SerializeVisitor::visit(const LoopControlNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::LoopControl), node);
+		_bytes.push_back(static_cast<char>(node.control_type));
+	}
+
+	void SerializeVisitor::visit(const ModuleNode& node)
+	{
+		// NOTE: Source of the module is not a part of the representation.
+		write_header(std::to_underlying(NodeTag::Module), node);
+		write_symbol(node.name);
+		write_varint(node.statements.size());
+
+		// Offsets of the statements precede them, thus each can be read without reading the preceding ones.
+		const auto offsets = _bytes.size();
+		_bytes.append(node.statements.size() * sizeof(u32), '\0');
+		for (std::size_t index = 0; index < node.statements.size(); ++index) {
+			write_u32(offsets + (index * sizeof(u32)), static_cast<u32>(_bytes.size()));
+			accept(node.statements[index].get());
+		}
+	}
+
+	void SerializeVisitor::visit(const ReturnNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Return), node);
+		accept(node.expression.get());
+	}
+
+	void SerializeVisitor::visit(const StructDeclarationNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::StructDeclaration), node);
+		write_symbol(node.name);
+		write_dependencies(node.parameters);
+	}
+
+	void SerializeVisitor::visit(const UnaryNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::Unary), node);
+		_bytes.push_back(static_cast<char>(node.op));
+		accept(node.expression.get());
+	}
+
+	void SerializeVisitor::visit(const VariableDeclarationNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::VariableDeclaration), node);
+		write_symbol(node.name);
+		write_symbol(node.type_identifier);
+		_bytes.push_back(static_cast<char>(node.is_mutable));
+		accept(node.expression.get());
+	}
+
+	void SerializeVisitor::visit(const WhileNode& node)
+	{
+		write_header(std::to_underlying(NodeTag::While), node);
+		accept(node.condition.get());
+		accept(node.statements.get());
+	}
+
+	void SerializeVisitor::write_symbol_table()
+	{
+		write_u32(0, static_cast<u32>(_bytes.size()));
+		write_varint(_symbol_table.size());
+		for (const auto& symbol : _symbol_table) {
+			write_string(symbol.view());
+		}
+	}
+
+	void SerializeVisitor::write_header(u8 tag, const ASTNode& node)
+	{
+		_bytes.push_back(static_cast<char>(tag));
+		write_type(node.type);
+	}
+
+	void SerializeVisitor::write_dependencies(const ASTNode::Dependencies& dependencies)
+	{
+		write_varint(dependencies.size());
+		for (const auto& dependency : dependencies) {
+			accept(dependency.get());
+		}
+	}
+
+	void SerializeVisitor::write_varint(u64 value)
+	{
+		for (; value >= 0x80; value >>= 7) {
+			_bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		}
+		_bytes.push_back(static_cast<char>(value));
+	}
+
+	void SerializeVisitor::write_string(std::string_view string)
+	{
+		write_varint(string.size());
+		_bytes.append(string);
+	}
+
+	void SerializeVisitor::write_u32(std::size_t offset, u32 value)
+	{
+		for (u32 index = 0; index < sizeof(value); ++index) {
+			_bytes[offset + index] = static_cast<char>(value >> (index * 8));
+		}
+	}
+
+	void SerializeVisitor::write_symbol(Symbol symbol)
+	{
+		const auto [it, inserted] = _symbols.try_emplace(symbol, static_cast<u32>(_symbols.size()));
+		write_varint(it->second);
+		if (inserted) {
+			_symbol_table.push_back(symbol);
+		}
+	}
+
+	void SerializeVisitor::write_type(const Type& type)
+	{
+		if (type.is<PrimitiveType>()) {
+			_bytes.push_back(static_cast<char>(TypeTag::Primitive));
+			_bytes.push_back(static_cast<char>(type.as<PrimitiveType>().type));
+		} else if (type.is<ArrayType>()) {
+			_bytes.push_back(static_cast<char>(TypeTag::Array));
+			write_type(type.as<ArrayType>().data_type());
+		} else if (type.is<StructType>()) {
+			_bytes.push_back(static_cast<char>(TypeTag::Struct));
+			write_varint(type.as<StructType>().types.size());
+			for (const auto& contained_type : type.as<StructType>().types) {
+				write_type(contained_type);
+			}
+		}
+	}
+
+	void SerializeVisitor::write_value(const Value& value)
+	{
+		if (value.is<bool>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::Boolean));
+			_bytes.push_back(static_cast<char>(value.get<bool>()));
+		} else if (value.is<i64>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::Integer));
+			const auto integer = value.get<i64>();
+			write_varint((static_cast<u64>(integer) << 1) ^ static_cast<u64>(integer >> 63));
+		} else if (value.is<f64>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::Float));
+			const auto bits = std::bit_cast<u64>(value.get<f64>());
+			for (u32 index = 0; index < sizeof(bits); ++index) {
+				_bytes.push_back(static_cast<char>(bits >> (index * 8)));
+			}
+		} else if (value.is<std::string>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::String));
+			write_string(value.get<std::string>());
+		} else if (value.is<char>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::Char));
+			_bytes.push_back(value.get<char>());
+		} else if (value.is<Symbol>()) {
+			_bytes.push_back(static_cast<char>(ValueTag::Symbol));
+			write_symbol(value.get<Symbol>());
+		} else {
+			_bytes.push_back(static_cast<char>(ValueTag::Unknown));
+		}
+	}
+}  // namespace soul::ast::visitors
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+#include "ast/visitors/default_traverse.h"
+#include "common/symbol.h"
+#include "common/types/types_fwd.h"
+#include "core/types.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace soul::ast::visitors
+{
+	/**
+	 * @brief SerializeVisitor traverses the AST and converts it (including the types of the nodes) into a compact,
+	 * binary representation, from which an equal AST can be reconstructed with SerializeVisitor::deserialize.
+	 * @details Representation starts with the (u32) offset of the symbol table, which follows the nodes. Nodes are
+	 * written in pre-order, each as a tag followed by its type and fields. Integers are written as (LEB128) variable
+	 * length integers, while identifiers are written as indices into the symbol table. Modules additionally write the
+	 * (u32) offset of each of their statements, thus these can be read individually, see SerializedAST.
+	 */
+	class SerializeVisitor final : public DefaultTraverseVisitor
+	{
+		public:
+		/** @brief Version of the format; representations of other versions are rejected when deserializing. */
+		static constexpr u32 k_format_version = 2;
+
+		/**
+		 * @brief Maximum depth (of the nodes) which is serialized; deeper trees are rejected when deserializing, thus
+		 * these are not serialized in the first place, see SerializeVisitor::is_complete.
+		 */
+		static constexpr std::size_t k_max_depth = 4096;
+
+		private:
+		std::string                     _bytes        = {};
+		std::unordered_map<Symbol, u32> _symbols      = {};
+		std::vector<Symbol>             _symbol_table = {};  // Symbols in the order of their indices.
+		std::size_t                     _depth        = 0;
+		bool                            _complete     = true;
+
+		public:
+		/** @brief Returns binary representation of the AST. */
+		[[nodiscard]] const std::string& bytes() const noexcept { return _bytes; }
+
+		/**
+		 * @brief Checks if the whole tree was serialized, i.e. none of its nodes was deeper than k_max_depth (these
+		 * are written as null instead).
+		 */
+		[[nodiscard]] bool is_complete() const noexcept { return _complete; }
+
+		/**
+		 * @brief Reconstructs the AST from its binary representation, see SerializedAST::deserialize.
+		 * @return Root of the AST, or nullptr if the representation is malformed (e.g. truncated).
+		 */
+		[[nodiscard]] static ASTNode::Dependency deserialize(std::string_view bytes);
+
+		void accept(ASTNode::Reference node) override;
+
+		protected:
+		using DefaultTraverseVisitor::visit;
+		void visit(const BinaryNode&) override;
+		void visit(const BlockNode&) override;
+		void visit(const CastNode&) override;
+		void visit(const ErrorNode&) override;
+		void visit(const ForLoopNode&) override;
+		void visit(const ForeachLoopNode&) override;
+		void visit(const FunctionCallNode&) override;
+		void visit(const FunctionDeclarationNode&) override;
+		void visit(const IfNode&) override;
+		void visit(const LiteralNode&) override;
+		void visit(const LoopControlNode&) override;
+		void visit(const ModuleNode&) override;
+		void visit(const ReturnNode&) override;
+		void visit(const StructDeclarationNode&) override;
+		void visit(const UnaryNode&) override;
+		void visit(const VariableDeclarationNode&) override;
+		void visit(const WhileNode&) override;
+
+		private:
+		void write_symbol_table();
+		void write_header(u8 tag, const ASTNode& node);
+		void write_dependencies(const ASTNode::Dependencies& dependencies);
+		void write_varint(u64 value);
+		void write_u32(std::size_t offset, u32 value);
+		void write_string(std::string_view string);
+		void write_symbol(Symbol symbol);
+		void write_type(const types::Type& type);
+		void write_value(const Value& value);
+	};
+
+	/**
+	 * @brief SerializedAST is a (non-owning) view of the binary representation of the AST (see SerializeVisitor),
+	 * e.g. memory-mapped straight from a file, which deserializes the tree only on demand. Statements of a module
+	 * can be deserialized individually, thus only the parts of the module which are needed are ever constructed.
+	 * @important Representation has to outlive the view.
+	 */
+	class SerializedAST
+	{
+		private:
+		std::string_view    _bytes      = {};
+		std::size_t         _nodes_end  = 0;  // Offset of the symbol table, i.e. one past the last node.
+		std::vector<Symbol> _symbols    = {};
+		std::size_t         _statements = 0;  // Offset of the statement offsets, if the root is a module.
+		std::size_t         _count      = 0;  // Number of statements, if the root is a module.
+		Symbol              _name       = {};
+
+		public:
+		/**
+		 * @brief Opens the binary representation, by reading (and interning) its symbols, and validating the
+		 * offsets of the statements of the module (if the root is one).
+		 * @return View of the representation, or std::nullopt if it is malformed.
+		 */
+		[[nodiscard]] static std::optional<SerializedAST> open(std::string_view bytes);
+
+		/**
+		 * @brief Deserializes the whole tree.
+		 * @return Root of the AST, or nullptr if the representation is malformed.
+		 */
+		[[nodiscard]] ASTNode::Dependency deserialize() const;
+
+		/** @brief Checks if the root of the tree is a ModuleNode. */
+		[[nodiscard]] bool is_module() const noexcept { return _statements != 0; }
+
+		/** @brief Returns name of the module, see SerializedAST::is_module. */
+		[[nodiscard]] Symbol module_name() const noexcept { return _name; }
+
+		/** @brief Returns number of statements in the module, see SerializedAST::is_module. */
+		[[nodiscard]] std::size_t statement_count() const noexcept { return _count; }
+
+		/**
+		 * @brief Deserializes a single statement of the module, without reading any of the others.
+		 * @return Statement of the module, or nullptr if the index is out of range or the statement is malformed.
+		 */
+		[[nodiscard]] ASTNode::Dependency deserialize_statement(std::size_t index) const;
+
+		private:
+		[[nodiscard]] std::size_t statement_offset(std::size_t index) const noexcept;
+	};
+}  // namespace soul::ast::visitors
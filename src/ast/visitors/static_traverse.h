@@ -0,0 +1,152 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/ast_fwd.h"
+
+#include <utility>
+
+namespace soul::ast::visitors
+{
+	/**
+	 * @brief StaticTraverseVisitor traverses every node of the Abstract Syntax Tree, same as DefaultTraverseVisitor,
+	 * but dispatches each node to the visit of the Derived visitor at compile time (by the kind of the node), thus
+	 * neither ASTNode::accept nor the visits are virtual calls, and can be inlined instead.
+	 * @details Derived visitor hides the visits (and ASTNode::accept) it wants to override, and has to befriend the
+	 * base, e.g. `friend StaticTraverseVisitor;`, if these are not public. Non-const visits forward to the const ones,
+	 * same as in IVisitor.
+	 * @tparam Derived Type of the visitor deriving from this class (CRTP).
+	 */
+	template <typename Derived>
+	class StaticTraverseVisitor
+	{
+		public:
+		void accept(ASTNode::Reference node)
+		{
+			if (!node) {
+				return;
+			}
+			dispatch(*node);
+		}
+
+		protected:
+		/** @brief Calls the visit of the Derived visitor for the concrete type of the node. */
+		void dispatch(ASTNode& node)
+		{
+			switch (node.kind()) {
+#define SOUL_AST_NODE(name)            \
+	case ASTNode::Kind::name:          \
+		self().visit(node.as<name>()); \
+		return;
+				SOUL_AST_NODES
+#undef SOUL_AST_NODE
+			}
+			std::unreachable();
+		}
+
+		void dispatch(const ASTNode& node)
+		{
+			switch (node.kind()) {
+#define SOUL_AST_NODE(name)            \
+	case ASTNode::Kind::name:          \
+		self().visit(node.as<name>()); \
+		return;
+				SOUL_AST_NODES
+#undef SOUL_AST_NODE
+			}
+			std::unreachable();
+		}
+
+		template <NodeKind Node>
+		void visit(Node& node)
+		{
+			self().visit(std::as_const(node));
+		}
+
+		void visit(const BinaryNode& node)
+		{
+			self().accept(node.lhs.get());
+			self().accept(node.rhs.get());
+		}
+
+		void visit(const BlockNode& node)
+		{
+			for (const auto& statement : node.statements) {
+				self().accept(statement.get());
+			}
+		}
+
+		void visit(const CastNode& node) { self().accept(node.expression.get()); }
+
+		void visit([[maybe_unused]] const ErrorNode& node) { /* Can't traverse further. */ }
+
+		void visit(const ForLoopNode& node)
+		{
+			self().accept(node.initialization.get());
+			self().accept(node.condition.get());
+			self().accept(node.update.get());
+			self().accept(node.statements.get());
+		}
+
+		void visit(const ForeachLoopNode& node)
+		{
+			self().accept(node.variable.get());
+			self().accept(node.in_expression.get());
+			self().accept(node.statements.get());
+		}
+
+		void visit(const FunctionCallNode& node)
+		{
+			for (const auto& param : node.parameters) {
+				self().accept(param.get());
+			}
+		}
+
+		void visit(const FunctionDeclarationNode& node)
+		{
+			for (const auto& param : node.parameters) {
+				self().accept(param.get());
+			}
+			self().accept(node.statements.get());
+		}
+
+		void visit(const IfNode& node)
+		{
+			self().accept(node.condition.get());
+			self().accept(node.then_statements.get());
+			self().accept(node.else_statements.get());
+		}
+
+		void visit([[maybe_unused]] const LiteralNode& node) { /* Can't traverse further. */ }
+
+		void visit([[maybe_unused]] const LoopControlNode& node) { /* Can't traverse further. */ }
+
+		void visit(const ModuleNode& node)
+		{
+			for (const auto& statement : node.statements) {
+				self().accept(statement.get());
+			}
+		}
+
+		void visit(const ReturnNode& node) { self().accept(node.expression.get()); }
+
+		void visit(const StructDeclarationNode& node)
+		{
+			for (const auto& param : node.parameters) {
+				self().accept(param.get());
+			}
+		}
+
+		void visit(const UnaryNode& node) { self().accept(node.expression.get()); }
+
+		void visit(const VariableDeclarationNode& node) { self().accept(node.expression.get()); }
+
+		void visit(const WhileNode& node)
+		{
+			self().accept(node.condition.get());
+			self().accept(node.statements.get());
+		}
+
+		private:
+		Derived& self() noexcept { return static_cast<Derived&>(*this); }
+	};
+}  // namespace soul::ast::visitors
@@ -0,0 +1,34 @@
+#include "ast/visitors/statistics.h"
+
+#include "ast/visitors/fused.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace soul::ast::visitors
+{
+	StatisticsVisitor::StatisticsVisitor() : _counts(), _depth_current(0), _depth_max(0) {}
+
+	void StatisticsVisitor::accept(ASTNode::Reference node) { FusedVisitor{ *this }.accept(node); }
+
+	std::size_t StatisticsVisitor::count(ASTNode::Kind kind) const noexcept
+	{
+		return _counts[std::to_underlying(kind)];
+	}
+
+	std::size_t StatisticsVisitor::count() const noexcept
+	{
+		return std::accumulate(_counts.begin(), _counts.end(), std::size_t{ 0 });
+	}
+
+	std::size_t StatisticsVisitor::depth() const noexcept { return _depth_max; }
+
+	void StatisticsVisitor::enter(const ASTNode& node)
+	{
+		++_counts[std::to_underlying(node.kind())];
+		_depth_max = std::max(_depth_max, ++_depth_current);
+	}
+
+	void StatisticsVisitor::leave([[maybe_unused]] const ASTNode& node) { --_depth_current; }
+}  // namespace soul::ast::visitors
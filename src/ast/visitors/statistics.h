@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ast/ast.h"
+
+#include <array>
+
+namespace soul::ast::visitors
+{
+	/**
+	 * @brief StatisticsVisitor gathers the statistics of the AST, i.e. number of nodes of each kind and depth of the
+	 * tree.
+	 * @details Visitor consists only of the hooks of FusedVisitor, thus it can gather the statistics alongside other
+	 * passes in a single traversal, e.g. `FusedVisitor{ error_collector, statistics }.accept(module)`.
+	 */
+	class StatisticsVisitor
+	{
+		public:
+#define SOUL_AST_NODE(name) +1
+		static constexpr std::size_t k_kind_count = 0 SOUL_AST_NODES;
+#undef SOUL_AST_NODE
+
+		private:
+		std::array<std::size_t, k_kind_count> _counts;
+		std::size_t                           _depth_current;
+		std::size_t                           _depth_max;
+
+		public:
+		StatisticsVisitor();
+
+		/**
+		 * @brief Gathers the statistics of the (sub-) tree, on top of the ones gathered so far.
+		 */
+		void accept(ASTNode::Reference node);
+
+		/**
+		 * @brief Returns number of the nodes of a given kind.
+		 */
+		std::size_t count(ASTNode::Kind kind) const noexcept;
+
+		/**
+		 * @brief Returns number of all nodes.
+		 */
+		std::size_t count() const noexcept;
+
+		/**
+		 * @brief Returns depth of the deepest node, where the root is at depth 1.
+		 */
+		std::size_t depth() const noexcept;
+
+		void enter(const ASTNode& node);
+		void leave(const ASTNode& node);
+	};
+}  // namespace soul::ast::visitors
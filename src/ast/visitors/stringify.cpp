@@ -1,6 +1,8 @@
 #include "ast/visitors/stringify.h"
 
+#include <iterator>
 #include <ranges>
+#include <utility>
 
 namespace soul::ast::visitors
 {
@@ -8,22 +10,51 @@ namespace soul::ast::visitors
 
 	StringifyVisitor::StringifyVisitor(Options options) : _options(options) {}
 
-	std::string StringifyVisitor::string() const { return _ss.str(); }
+	StringifyVisitor::StringifyVisitor(Sink sink, Options options) : _sink(std::move(sink)), _options(options)
+	{
+		// NOTE: Single write might exceed the chunk size, thus some slack is left to avoid reallocations.
+		_buffer.reserve(2 * k_chunk_size);
+	}
 
-	void StringifyVisitor::accept(const ASTNode::Reference node)
+	StringifyVisitor::Sink StringifyVisitor::file_sink(std::FILE* file)
 	{
-		if (!node) {
-			_ss << "null";
+		return [file](std::string_view chunk) {
+			return std::fwrite(chunk.data(), sizeof(char), chunk.size(), file) == chunk.size();
+		};
+	}
+
+	std::string StringifyVisitor::string() const { return _buffer; }
+
+	void StringifyVisitor::flush()
+	{
+		if (!_sink || _buffer.empty()) {
 			return;
 		}
+		if (!_has_failed) {
+			_has_failed = !_sink(_buffer);
+		}
+		_buffer.clear();
+	}
 
-		_indent_level += k_indent_amount;
-		_ss << "{\n";
+	void StringifyVisitor::accept(const ASTNode::Reference node)
+	{
+		if (!node) {
+			write("null");
+		} else {
+			write("{");
+			_indent_level += k_indent_amount;
+			new_line();
 
-		node->accept(*this);
+			dispatch(*node);
+
+			_indent_level -= k_indent_amount;
+			new_line();
+			write("}");
+		}
 
-		_indent_level -= k_indent_amount;
-		_ss << std::format("\n{}}}", std::string(_indent_level, ' '));
+		if (_indent_level == 0) {
+			flush();
+		}
 	}
 
 	void StringifyVisitor::visit(const BinaryNode& node)
@@ -46,7 +77,7 @@ namespace soul::ast::visitors
 	{
 		encode("node", "cast");
 		encode_type(node.type);
-		encode("type_identifier", node.type_identifier);
+		encode("type_identifier", node.type_identifier.view());
 		encode("expression", node.expression.get(), false);
 	}
 
@@ -80,7 +111,7 @@ namespace soul::ast::visitors
 	{
 		encode("node", "function_call");
 		encode_type(node.type);
-		encode("name", node.name);
+		encode("name", node.name.view());
 		encode("parameters", node.parameters, false);
 	}
 
@@ -88,8 +119,8 @@ namespace soul::ast::visitors
 	{
 		encode("node", "function_declaration");
 		encode_type(node.type);
-		encode("name", node.name);
-		encode("type_identifier", node.type_identifier);
+		encode("name", node.name.view());
+		encode("type_identifier", node.type_identifier.view());
 		encode("parameters", node.parameters);
 		encode("statements", node.statements.get(), false);
 	}
@@ -108,7 +139,7 @@ namespace soul::ast::visitors
 		encode("node", "literal");
 		encode_type(node.type);
 		encode("literal_type", LiteralNode::internal_name(node.literal_type));
-		encode("value", std::string(node), false);
+		encode_value(node.value, false);
 	}
 
 	void StringifyVisitor::visit(const LoopControlNode& node)
@@ -126,7 +157,7 @@ namespace soul::ast::visitors
 	{
 		encode("node", "module_declaration");
 		encode_type(node.type);
-		encode("name", node.name);
+		encode("name", node.name.view());
 		encode("statements", node.statements, false);
 	}
 
@@ -141,7 +172,7 @@ namespace soul::ast::visitors
 	{
 		encode("node", "struct_declaration");
 		encode_type(node.type);
-		encode("name", node.name);
+		encode("name", node.name.view());
 		encode("parameters", node.parameters, false);
 	}
 
@@ -157,8 +188,8 @@ namespace soul::ast::visitors
 	{
 		encode("node", "variable_declaration");
 		encode_type(node.type);
-		encode("name", node.name);
-		encode("type_identifier", node.type_identifier);
+		encode("name", node.name.view());
+		encode("type_identifier", node.type_identifier.view());
 		encode("is_mutable", node.is_mutable ? "true" : "false");
 		encode("expression", node.expression.get(), false);
 	}
@@ -171,14 +202,63 @@ namespace soul::ast::visitors
 		encode("statements", node.statements.get(), false);
 	}
 
-	std::string StringifyVisitor::current_indent() const { return std::string(_indent_level, ' '); }
+	void StringifyVisitor::write(std::string_view string)
+	{
+		_buffer.append(string);
+		if (_sink && _buffer.size() >= k_chunk_size) {
+			flush();
+		}
+	}
+
+	void StringifyVisitor::write_key(std::string_view key)
+	{
+		if (_options & Options::Compact) {
+			write("\"{}\":", key);
+		} else {
+			write("\"{}\": ", key);
+		}
+	}
+
+	void StringifyVisitor::write_separator()
+	{
+		write(",");
+		new_line();
+	}
+
+	void StringifyVisitor::new_line()
+	{
+		if (_options & Options::Compact) {
+			return;
+		}
+		_buffer.push_back('\n');
+		_buffer.append(_indent_level, ' ');
+	}
 
 	void StringifyVisitor::encode(std::string_view key, std::string_view value, bool add_trailing_comma)
 	{
-		_ss << current_indent();
-		_ss << std::format("\"{}\": \"{}\"", key, !value.empty() ? value : k_unnamed);
+		write_key(key);
+		write("\"{}\"", !value.empty() ? value : k_unnamed);
+		if (add_trailing_comma) {
+			write_separator();
+		}
+	}
+
+	void StringifyVisitor::encode_value(const Value& value, bool add_trailing_comma)
+	{
+		// NOTE: Values are formatted directly into the buffer; only the (textual) empty ones are replaced, as with the
+		// other strings, see StringifyVisitor::encode.
+		const bool is_empty = value.is<std::string>() ? value.get<std::string>().empty()
+		                                              : value.is<Symbol>() && value.get<Symbol>().view().empty();
+		write_key("value");
+		if (is_empty) {
+			write("\"{}\"", k_unnamed);
+		} else {
+			_buffer.push_back('"');
+			soul::format_to(std::back_inserter(_buffer), value);
+			write("\"");
+		}
 		if (add_trailing_comma) {
-			_ss << ",\n";
+			write_separator();
 		}
 	}
 
@@ -187,17 +267,19 @@ namespace soul::ast::visitors
 		if (!(_options & Options::PrintTypes)) {
 			return;
 		}
-		_ss << current_indent();
-		_ss << std::format("\"type\": \"{}\",\n", std::string(type));
+		write_key("type");
+		_buffer.push_back('"');
+		types::format_to(std::back_inserter(_buffer), type);
+		write("\"");
+		write_separator();
 	}
 
 	void StringifyVisitor::encode(std::string_view key, const ASTNode::Reference node, bool add_trailing_comma)
 	{
-		_ss << current_indent();
-		_ss << std::format("\"{}\": ", key);
+		write_key(key);
 		accept(node);
 		if (add_trailing_comma) {
-			_ss << ",\n";
+			write_separator();
 		}
 	}
 }  // namespace soul::ast::visitors
@@ -2,68 +2,105 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
-#include "ast/visitors/default_traverse.h"
+#include "ast/visitors/static_traverse.h"
 #include "core/types.h"
 
-#include <sstream>
+#include <cstdio>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
 
 namespace soul::ast::visitors
 {
 	/**
 	 * @brief StringifyVisitor traverses the AST and converts each visited node into its (valid) JSON representation.
 	 * Its useful for debugging.
+	 * @details Representation is formatted into a (reused) buffer, which is handed over to the sink in chunks of
+	 * about StringifyVisitor::k_chunk_size bytes, thus even huge trees are written in constant memory. Without the
+	 * sink the whole representation is kept instead, see StringifyVisitor::string.
 	 */
-	class StringifyVisitor final : public DefaultTraverseVisitor
+	class StringifyVisitor final : public StaticTraverseVisitor<StringifyVisitor>
 	{
 		public:
 		enum Options : u8
 		{
 			None       = 0 << 0,
 			PrintTypes = 1 << 0,
+			Compact    = 1 << 1,  // Omits the whitespace (newlines and indentation).
 		};
 
+		/**
+		 * @brief Receives consecutive chunks of the representation; returns false if a chunk could not be written,
+		 * after which no further chunks are handed over, see StringifyVisitor::has_failed.
+		 */
+		using Sink = std::function<bool(std::string_view)>;
+
+		/** @brief Size of the buffer, after exceeding which its contents are handed over to the sink. */
+		static constexpr std::size_t k_chunk_size = 64 * 1024;
+
 		private:
 		static constexpr auto        k_unnamed       = "__unnamed__";
 		static constexpr std::size_t k_indent_amount = 2;
 
 		private:
-		std::stringstream _ss;
-		std::size_t       _indent_level = 0;
-		Options           _options{};
+		std::string _buffer       = {};
+		Sink        _sink         = {};
+		std::size_t _indent_level = 0;
+		bool        _has_failed   = false;
+		Options     _options{};
 
 		public:
 		StringifyVisitor(Options options = Options::None);
+		StringifyVisitor(Sink sink, Options options = Options::None);
+
+		/** @brief Returns sink, which writes the chunks into a given (opened) file and fails on the short writes. */
+		static Sink file_sink(std::FILE* file);
 
-		/** @brief Returns textual representation of an AST. */
+		/** @brief Verifies if the sink failed to write any of the chunks, i.e. the representation is incomplete. */
+		[[nodiscard]] bool has_failed() const noexcept { return _has_failed; }
+
+		/** @brief Returns textual representation of an AST, or its unflushed part if the sink is used. */
 		std::string string() const;
 
-		void accept(const ASTNode::Reference node) override;
+		/** @brief Hands over the buffered part of the representation to the sink (if any). */
+		void flush();
+
+		void accept(const ASTNode::Reference node);
 
 		protected:
-		using DefaultTraverseVisitor::visit;
-		void visit(const BinaryNode&) override;
-		void visit(const BlockNode&) override;
-		void visit(const CastNode&) override;
-		void visit(const ErrorNode&) override;
-		void visit(const ForLoopNode&) override;
-		void visit(const ForeachLoopNode&) override;
-		void visit(const FunctionCallNode&) override;
-		void visit(const FunctionDeclarationNode&) override;
-		void visit(const IfNode&) override;
-		void visit(const LiteralNode&) override;
-		void visit(const LoopControlNode&) override;
-		void visit(const ModuleNode&) override;
-		void visit(const ReturnNode&) override;
-		void visit(const StructDeclarationNode&) override;
-		void visit(const UnaryNode&) override;
-		void visit(const VariableDeclarationNode&) override;
-		void visit(const WhileNode&) override;
+		friend StaticTraverseVisitor;
+		using StaticTraverseVisitor::visit;
+		void visit(const BinaryNode&);
+		void visit(const BlockNode&);
+		void visit(const CastNode&);
+		void visit(const ErrorNode&);
+		void visit(const ForLoopNode&);
+		void visit(const ForeachLoopNode&);
+		void visit(const FunctionCallNode&);
+		void visit(const FunctionDeclarationNode&);
+		void visit(const IfNode&);
+		void visit(const LiteralNode&);
+		void visit(const LoopControlNode&);
+		void visit(const ModuleNode&);
+		void visit(const ReturnNode&);
+		void visit(const StructDeclarationNode&);
+		void visit(const UnaryNode&);
+		void visit(const VariableDeclarationNode&);
+		void visit(const WhileNode&);
 
 		private:
-		std::string current_indent() const;
-		void        encode(std::string_view key, std::string_view value, bool add_trailing_comma = true);
-		void        encode_type(const types::Type& type);
-		void        encode(std::string_view key, const ASTNode::Reference node, bool add_trailing_comma = true);
+		template <typename... Args>
+		void write(std::format_string<Args...> format, Args&&... args);
+		void write(std::string_view string);
+		void write_key(std::string_view key);
+		void write_separator();
+		void new_line();
+		void encode(std::string_view key, std::string_view value, bool add_trailing_comma = true);
+		void encode_value(const Value& value, bool add_trailing_comma = true);
+		void encode_type(const types::Type& type);
+		void encode(std::string_view key, const ASTNode::Reference node, bool add_trailing_comma = true);
 		template <std::ranges::forward_range T>
 		void encode(std::string_view key, const T& parameters, bool add_trailing_comma = true)
 			requires(std::same_as<ASTNode::Dependency, std::ranges::range_value_t<T>>);
@@ -1,32 +1,40 @@
 #pragma once
 namespace soul::ast::visitors
 {
+	template <typename... Args>
+	void StringifyVisitor::write(std::format_string<Args...> format, Args&&... args)
+	{
+		std::format_to(std::back_inserter(_buffer), format, std::forward<Args>(args)...);
+		if (_sink && _buffer.size() >= k_chunk_size) {
+			flush();
+		}
+	}
+
 	template <std::ranges::forward_range T>
 	auto StringifyVisitor::encode(std::string_view key, const T& parameters, bool add_trailing_comma) -> void
 		requires(std::same_as<ASTNode::Dependency, std::ranges::range_value_t<T>>)
 	{
-		_ss << current_indent();
+		write_key(key);
 
 		if (parameters.empty()) {
-			_ss << std::format("\"{}\": []", key);
+			write("[]");
 		} else {
+			write("[");
 			_indent_level += k_indent_amount;
-
-			_ss << std::format("\"{}\": [\n", key);
-			_ss << current_indent();
+			new_line();
 			for (std::size_t index = 0; index < parameters.size(); ++index) {
 				accept(parameters[index].get());
 				if (index != parameters.size() - 1) {
-					_ss << std::format(",\n{}", current_indent());
+					write_separator();
 				}
 			}
-
 			_indent_level -= k_indent_amount;
-			_ss << std::format("\n{}]", current_indent());
+			new_line();
+			write("]");
 		}
 
 		if (add_trailing_comma) {
-			_ss << ",\n";
+			write_separator();
 		}
 	}
 
@@ -14,26 +14,25 @@ namespace soul::ast::visitors
 	void TypeDiscovererVisitor::visit(StructDeclarationNode& node)
 	{
 		if (_registered_types.contains(node.name)) {
-			_current_clone = ErrorNode::create(std::format("redefinition of type '{}'", node.name));
+			replace(ErrorNode::create(std::format("redefinition of type '{}'", node.name.view())));
 			return;
 		}
 
-		CopyVisitor::visit(node);
-		auto& struct_declaration = _current_clone->as<StructDeclarationNode>();
+		RewriteVisitor::visit(node);
 
 		StructType::ContainedTypes contained_types{};
 		contained_types.reserve(node.parameters.size());
-		for (std::size_t index = 0; index < node.parameters.size(); ++index) {
-			if (!node.parameters[index]->is<VariableDeclarationNode>()) {
-				struct_declaration.parameters[index] = ErrorNode::create(std::format(
+		for (auto& parameter : node.parameters) {
+			if (!parameter->is<VariableDeclarationNode>()) {
+				parameter = ErrorNode::create(std::format(
 					"[INTERNAL] cannot resolve type for '{}', because parameter is not of valid (node) type",
-					node.name));
+					node.name.view()));
 				continue;
 			}
-			const auto& param = node.parameters[index]->as<VariableDeclarationNode>();
+			const auto& param = parameter->as<VariableDeclarationNode>();
 			if (!_registered_types.contains(param.type_identifier)) {
-				struct_declaration.parameters[index] = ErrorNode::create(
-					std::format("cannot resolve type '{}', because no such type exists", param.type_identifier));
+				parameter = ErrorNode::create(
+					std::format("cannot resolve type '{}', because no such type exists", param.type_identifier.view()));
 				continue;
 			}
 			contained_types.push_back(_registered_types.at(param.type_identifier));
@@ -42,7 +41,7 @@ namespace soul::ast::visitors
 	}
 	TypeDiscovererVisitor::TypeMap TypeDiscovererVisitor::basic_types() noexcept
 	{
-		// IMPORTANT: Must match keywords defined in Lexer::scan_token.
+		// IMPORTANT: Must match keywords defined in lexer/keyword.h.
 		using namespace std::string_view_literals;
 		static const TypeDiscovererVisitor::TypeMap k_basic_types = {
 			{ "bool"sv, types::PrimitiveType::Kind::Boolean },
@@ -2,10 +2,10 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
-#include "ast/visitors/copy.h"
+#include "ast/visitors/rewrite.h"
+#include "common/symbol.h"
 #include "common/types/types_fwd.h"
 
-#include <string_view>
 #include <unordered_map>
 
 namespace soul::ast::visitors
@@ -13,10 +13,10 @@ namespace soul::ast::visitors
 	/**
 	 * @brief TypeDiscovererVisitor traverses the AST while making note of each type declaration.
 	 */
-	class TypeDiscovererVisitor final : public CopyVisitor
+	class TypeDiscovererVisitor final : public RewriteVisitor
 	{
 		public:
-		using TypeMap = std::unordered_map<std::string_view, types::Type>;
+		using TypeMap = std::unordered_map<Symbol, types::Type>;
 
 		private:
 		TypeMap _registered_types = basic_types();
@@ -35,10 +35,10 @@ namespace soul::ast::visitors
 
 		static TypeMap basic_types() noexcept;
 
-		using CopyVisitor::accept;
+		using RewriteVisitor::accept;
 
 		protected:
-		using CopyVisitor::visit;
+		using RewriteVisitor::visit;
 		void visit(StructDeclarationNode&) override;
 	};
 }  // namespace soul::ast::visitors
@@ -15,40 +15,39 @@ namespace soul::ast::visitors
 
 	TypeResolverVisitor::TypeResolverVisitor(TypeMap type_map) : _registered_types(std::move(type_map)) {}
 
-	void TypeResolverVisitor::visit(const BinaryNode& node)
+	void TypeResolverVisitor::visit(BinaryNode& node)
 	{
-		CopyVisitor::visit(node);
-		auto& binary_node = _current_clone->as<BinaryNode>();
+		RewriteVisitor::visit(node);
 
 		if (!node.lhs) {
-			binary_node.lhs = ErrorNode::create("[INTERNAL] BinaryNode does not contain LHS expression (nullptr)");
+			node.lhs = ErrorNode::create("[INTERNAL] BinaryNode does not contain LHS expression (nullptr)");
 		}
 		if (!node.rhs) {
-			binary_node.rhs = ErrorNode::create("[INTERNAL] BinaryNode does not contain RHS expression (nullptr)");
+			node.rhs = ErrorNode::create("[INTERNAL] BinaryNode does not contain RHS expression (nullptr)");
 		}
-		if (binary_node.lhs->is<ErrorNode>() || binary_node.rhs->is<ErrorNode>()) {
+		if (node.lhs->is<ErrorNode>() || node.rhs->is<ErrorNode>()) {
 			return;
 		}
 
 		const auto result_type
-			= get_type_for_operator(binary_node.op, std::array{ binary_node.lhs->type, binary_node.rhs->type });
+			= get_type_for_operator(node.op, std::array{ node.lhs->type, node.rhs->type });
 		if (result_type == Type{}) {
-			_current_clone = ErrorNode::create(std::format("operator ('{}') does not exist for types '{}' and '{}'",
-			                                               ASTNode::name(binary_node.op),
-			                                               std::string(binary_node.lhs->type),
-			                                               std::string(binary_node.rhs->type)));
+			replace(ErrorNode::create(std::format("operator ('{}') does not exist for types '{}' and '{}'",
+			                                      ASTNode::name(node.op),
+			                                      std::string(node.lhs->type),
+			                                      std::string(node.rhs->type))));
 			return;
 		}
-		_current_clone->type = result_type;
+		node.type = result_type;
 	}
 
-	void TypeResolverVisitor::visit(const BlockNode& node)
+	void TypeResolverVisitor::visit(BlockNode& node)
 	{
 		// ENTER SCOPE: Mark a restorepoint for variables declared in the current scope.
 		const std::size_t variables_until_this_point = _variables_in_scope.size();
 
-		CopyVisitor::visit(node);
-		_current_clone->type = PrimitiveType::Kind::Void;
+		RewriteVisitor::visit(node);
+		node.type = PrimitiveType::Kind::Void;
 
 		// EXIT SCOPE: Remove variables defined in that scope.
 		const std::size_t variables_declared_in_scope = _variables_in_scope.size() - variables_until_this_point;
@@ -56,120 +55,115 @@ namespace soul::ast::visitors
 		                          _variables_in_scope.end());
 	}
 
-	void TypeResolverVisitor::visit(const CastNode& node)
+	void TypeResolverVisitor::visit(CastNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
 		if (!node.expression) {
-			_current_clone = ErrorNode::create("[INTERNAL] CastNode does not contain an expression (nullptr)");
+			replace(ErrorNode::create("[INTERNAL] CastNode does not contain an expression (nullptr)"));
+			return;
 		}
 
-		const auto& cast_node = _current_clone->as<CastNode>();
-		const auto  from_type = cast_node.expression->type;
-		const auto  to_type   = get_type_or_default(cast_node.type_identifier);
+		const auto  from_type = node.expression->type;
+		const auto  to_type   = get_type_or_default(node.type_identifier);
 		if (get_cast_type(from_type, to_type) == CastNode::Type::Impossible) {
-			_current_clone = ErrorNode::create(
-				std::format("cannot cast from type '{}' to '{}'", std::string(from_type), std::string(to_type)));
+			replace(ErrorNode::create(
+				std::format("cannot cast from type '{}' to '{}'", std::string(from_type), std::string(to_type))));
 			return;
 		}
 
-		_current_clone->type = to_type;
+		node.type = to_type;
 	}
 
-	void TypeResolverVisitor::visit(const ForLoopNode& node)
+	void TypeResolverVisitor::visit(ForLoopNode& node)
 	{
-		CopyVisitor::visit(node);
-		const auto& for_loop = _current_clone->as<ForLoopNode>();
+		RewriteVisitor::visit(node);
 
-		if (for_loop.condition) {
+		if (node.condition) {
 			const bool is_condition_bool_coercible
-				= get_cast_type(for_loop.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
+				= get_cast_type(node.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
 			if (!is_condition_bool_coercible) {
-				_current_clone = ErrorNode::create(
+				replace(ErrorNode::create(
 					std::format("condition in for loop statement must be convertible to a '{}' type",
-				                std::string(Type{ PrimitiveType::Kind::Boolean })));
+					            std::string(Type{ PrimitiveType::Kind::Boolean }))));
 				return;
 			}
 		}
 
-		_current_clone->type = PrimitiveType::Kind::Void;
+		node.type = PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const ForeachLoopNode& node)
+	void TypeResolverVisitor::visit(ForeachLoopNode& node)
 	{
-		CopyVisitor::visit(node);
-		auto& foreach_node = _current_clone->as<ForeachLoopNode>();
+		RewriteVisitor::visit(node);
 
 		if (!node.variable) {
-			foreach_node.variable
+			node.variable
 				= ErrorNode::create("[INTERNAL] ForeachLoopNode does not contain variable expression (nullptr)");
 		}
 		if (!node.in_expression) {
-			foreach_node.in_expression
+			node.in_expression
 				= ErrorNode::create("[INTERNAL] ForeachLoopNode does not contain in_expression expression (nullptr)");
 		}
-		if (foreach_node.variable->is<ErrorNode>() || foreach_node.in_expression->is<ErrorNode>()) {
+		if (node.variable->is<ErrorNode>() || node.in_expression->is<ErrorNode>()) {
 			return;
 		}
 
-		if (!foreach_node.in_expression->type.is<ArrayType>()) {
-			_current_clone = ErrorNode::create(
-				std::format("expression iterated in for each loop statement must be of an array type"));
+		if (!node.in_expression->type.is<ArrayType>()) {
+			replace(ErrorNode::create(
+				std::format("expression iterated in for each loop statement must be of an array type")));
 			return;
 		}
 
 		const auto relation_type
-			= get_cast_type(foreach_node.in_expression->type.as<ArrayType>().data_type(), foreach_node.variable->type);
+			= get_cast_type(node.in_expression->type.as<ArrayType>().data_type(), node.variable->type);
 		if (relation_type == CastNode::Type::Impossible) {
-			_current_clone = ErrorNode::create(std::format(
+			replace(ErrorNode::create(std::format(
 				"type missmatch in for each loop statement between variable ('{}') and iterated expression ('{}')",
-				std::string(foreach_node.variable->type),
-				std::string(foreach_node.in_expression->type)));
+				std::string(node.variable->type),
+				std::string(node.in_expression->type))));
 			return;
 		}
 
-		_current_clone->type = PrimitiveType::Kind::Void;
+		node.type = PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const FunctionCallNode& node)
+	void TypeResolverVisitor::visit(FunctionCallNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
-		const auto& function_call = _current_clone->as<FunctionCallNode>();
-		auto        want_types    = function_call.parameters
+		auto        want_types    = node.parameters
 		                | std::views::transform([](const auto& parameter) -> types::Type { return parameter->type; });
 		const auto function_declaration = get_function_declaration(node.name, want_types);
 		if (!function_declaration.has_value()) {
-			_current_clone = ErrorNode::create(std::format("cannot call non-existing function '{}'", node.name));
+			replace(ErrorNode::create(std::format("cannot call non-existing function '{}'", node.name.view())));
 			return;
 		}
-		_current_clone->type = function_declaration->return_type;
+		node.type = function_declaration->return_type;
 	}
 
-	void TypeResolverVisitor::visit(const FunctionDeclarationNode& node)
+	void TypeResolverVisitor::visit(FunctionDeclarationNode& node)
 	{
 		// NOTE: Soul does not support global variables; we can assume that a function declaration is an entirely new
 		// scope without any previous declarations.
 		_variables_in_scope.clear();
 
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
-		auto& function_declaration = _current_clone->as<FunctionDeclarationNode>();
-		auto  want_types           = function_declaration.parameters
+		auto  want_types           = node.parameters
 		                | std::views::transform([](const auto& parameter) -> types::Type { return parameter->type; });
 		if (get_function_declaration(node.name, want_types)) {
-			_current_clone
-				= ErrorNode::create(std::format("function declaration '{}' shadows previous one", node.name));
+			replace(ErrorNode::create(std::format("function declaration '{}' shadows previous one", node.name.view())));
 			return;
 		}
 
-		for (std::size_t index = 0; index < function_declaration.parameters.size(); ++index) {
-			const auto* parameter = function_declaration.parameters[index].get();
+		for (std::size_t index = 0; index < node.parameters.size(); ++index) {
+			const auto* parameter = node.parameters[index].get();
 			if (parameter->is<ErrorNode>()) {
 				return;
 			}
 			if (!parameter->is<VariableDeclarationNode>()) {
-				function_declaration.parameters[index]
+				node.parameters[index]
 					= ErrorNode::create(std::format("[INTERNAL] FunctionDeclarationNode contains "
 				                                    "non-VariableDeclarationNode in the parameter list (at {})",
 				                                    index));
@@ -177,44 +171,43 @@ namespace soul::ast::visitors
 			}
 		}
 
-		_current_clone->type = get_type_or_default(node.type_identifier);
+		node.type = get_type_or_default(node.type_identifier);
 		_functions_in_module.emplace_back(
 			node.name,
 			FunctionDeclaration{
 				.input_types = std::vector<types::Type>{ want_types.begin(), want_types.end() },
-				.return_type = function_declaration.type
+				.return_type = node.type
         });
 	}
 
-	void TypeResolverVisitor::visit(const IfNode& node)
+	void TypeResolverVisitor::visit(IfNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
-		const auto& if_node = _current_clone->as<IfNode>();
 		const bool  is_condition_bool_coercible
-			= get_cast_type(if_node.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
+			= get_cast_type(node.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
 		if (!is_condition_bool_coercible) {
-			_current_clone = ErrorNode::create(
+			replace(ErrorNode::create(
 				std::format("condition in if statement statement must be convertible to a '{}' type",
-			                std::string(Type{ PrimitiveType::Kind::Boolean })));
+				            std::string(Type{ PrimitiveType::Kind::Boolean }))));
 			return;
 		}
 
-		_current_clone->type = PrimitiveType::Kind::Void;
+		node.type = PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const LiteralNode& node)
+	void TypeResolverVisitor::visit(LiteralNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
 		if (node.literal_type == LiteralNode::Type::Identifier) {
-			const auto& type_identifier = get_variable_type(node.value.get<std::string>());
+			const auto& type_identifier = get_variable_type(node.value.get<Symbol>());
 			if (!type_identifier) {
-				_current_clone = ErrorNode::create(
-					std::format("use of undeclared identifier '{}'", node.value.get<std::string>()));
+				replace(ErrorNode::create(
+					std::format("use of undeclared identifier '{}'", node.value.get<Symbol>().view())));
 				return;
 			}
-			_current_clone->type = *type_identifier;
+			node.type = *type_identifier;
 			return;
 		}
 
@@ -231,89 +224,85 @@ namespace soul::ast::visitors
 		const auto it{ std::ranges::find(
 			k_literal_to_type, node.literal_type, &decltype(k_literal_to_type)::value_type::first) };
 		if (it == std::end(k_literal_to_type)) [[unlikely]] {
-			_current_clone->type = PrimitiveType::Kind::Unknown;
+			node.type = PrimitiveType::Kind::Unknown;
 			return;
 		}
-		_current_clone->type = it->second;
+		node.type = it->second;
 	}
 
-	void TypeResolverVisitor::visit(const LoopControlNode& node)
+	void TypeResolverVisitor::visit(LoopControlNode& node)
 	{
-		CopyVisitor::visit(node);
-		_current_clone->type = PrimitiveType::Kind::Void;
+		RewriteVisitor::visit(node);
+		node.type = PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const ModuleNode& node)
+	void TypeResolverVisitor::visit(ModuleNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
 		// NOTE: Modules are a collection of type declarations and functions, thus don't have their own type.
-		_current_clone->type = PrimitiveType::Kind::Void;
+		node.type = PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const ReturnNode& node)
+	void TypeResolverVisitor::visit(ReturnNode& node)
 	{
-		CopyVisitor::visit(node);
-		const auto& expression = _current_clone->as<ReturnNode>().expression;
-		_current_clone->type   = expression ? expression->type : PrimitiveType::Kind::Void;
+		RewriteVisitor::visit(node);
+		node.type = node.expression ? node.expression->type : PrimitiveType::Kind::Void;
 	}
 
-	void TypeResolverVisitor::visit(const StructDeclarationNode& node)
+	void TypeResolverVisitor::visit(StructDeclarationNode& node)
 	{
-		CopyVisitor::visit(node);
-		_current_clone->type = get_type_or_default(node.name);
+		RewriteVisitor::visit(node);
+		node.type = get_type_or_default(node.name);
 	}
 
-	void TypeResolverVisitor::visit(const UnaryNode& node)
+	void TypeResolverVisitor::visit(UnaryNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
-		const auto& unary_node = _current_clone->as<UnaryNode>();
-		if (!unary_node.expression) {
-			_current_clone = ErrorNode::create("[INTERNAL] UnaryNode does not contain expression (nullptr)");
+		if (!node.expression) {
+			replace(ErrorNode::create("[INTERNAL] UnaryNode does not contain expression (nullptr)"));
 			return;
 		}
 
-		const auto result_type = get_type_for_operator(unary_node.op, std::array{ unary_node.expression->type });
+		const auto result_type = get_type_for_operator(node.op, std::array{ node.expression->type });
 		if (result_type == Type{}) {
-			_current_clone = ErrorNode::create(std::format("operator ('{}') does not exist for type '{}'",
-			                                               ASTNode::name(unary_node.op),
-			                                               std::string(unary_node.expression->type)));
+			replace(ErrorNode::create(std::format("operator ('{}') does not exist for type '{}'",
+			                                      ASTNode::name(node.op),
+			                                      std::string(node.expression->type))));
 			return;
 		}
-		_current_clone->type = result_type;
+		node.type = result_type;
 	}
 
-	void TypeResolverVisitor::visit(const VariableDeclarationNode& node)
+	void TypeResolverVisitor::visit(VariableDeclarationNode& node)
 	{
-		CopyVisitor::visit(node);
+		RewriteVisitor::visit(node);
 
 		if (get_variable_type(node.name)) {
-			_current_clone
-				= ErrorNode::create(std::format("variable declaration '{}' shadows previous one", node.name));
+			replace(ErrorNode::create(std::format("variable declaration '{}' shadows previous one", node.name.view())));
 			return;
 		}
 
-		_current_clone->type = get_type_or_default(node.type_identifier);
-		_variables_in_scope.emplace_back(std::make_pair(node.name, _current_clone->type));
+		node.type = get_type_or_default(node.type_identifier);
+		_variables_in_scope.emplace_back(node.name, node.type);
 	}
 
-	void TypeResolverVisitor::visit(const WhileNode& node)
+	void TypeResolverVisitor::visit(WhileNode& node)
 	{
-		CopyVisitor::visit(node);
-		const auto& while_loop = _current_clone->as<WhileNode>();
+		RewriteVisitor::visit(node);
 
-		if (while_loop.condition) {
+		if (node.condition) {
 			const bool is_condition_bool_coercible
-				= get_cast_type(while_loop.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
+				= get_cast_type(node.condition->type, PrimitiveType::Kind::Boolean) != CastNode::Type::Impossible;
 			if (!is_condition_bool_coercible) {
-				_current_clone = ErrorNode::create(
+				replace(ErrorNode::create(
 					std::format("condition in while loop statement must be convertible to a '{}' type",
-				                std::string(Type{ PrimitiveType::Kind::Boolean })));
+					            std::string(Type{ PrimitiveType::Kind::Boolean }))));
 				return;
 			}
 		}
-		_current_clone->type = PrimitiveType::Kind::Void;
+		node.type = PrimitiveType::Kind::Void;
 	}
 
 	CastNode::Type get_cast_type(const Type& from_type, const Type& to_type)
@@ -424,15 +413,15 @@ namespace soul::ast::visitors
 		return CastNode::Type::Impossible;
 	}
 
-	types::Type TypeResolverVisitor::get_type_or_default(std::string_view type_identifier) const noexcept
+	types::Type TypeResolverVisitor::get_type_or_default(Symbol type_identifier) const noexcept
 	{
-		if (_registered_types.contains(type_identifier)) {
-			return _registered_types.at(type_identifier);
+		if (const auto it = _registered_types.find(type_identifier); it != std::end(_registered_types)) {
+			return it->second;
 		}
 		return types::Type{};
 	}
 
-	std::optional<Type> TypeResolverVisitor::get_variable_type(std::string_view name) const noexcept
+	std::optional<Type> TypeResolverVisitor::get_variable_type(Symbol name) const noexcept
 	{
 		const auto it{ std::ranges::find(
 			_variables_in_scope, name, &decltype(_variables_in_scope)::value_type::first) };
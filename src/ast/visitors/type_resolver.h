@@ -2,14 +2,13 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
-#include "ast/visitors/copy.h"
+#include "ast/visitors/rewrite.h"
 #include "ast/visitors/type_discoverer.h"
+#include "common/symbol.h"
 #include "common/types/types_fwd.h"
 
 #include <optional>
 #include <ranges>
-#include <string>
-#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -18,7 +17,7 @@ namespace soul::ast::visitors
 	/**
 	 * @brief TypeResolverVisitor traverses the AST while resolving each node into the correct type.
 	 */
-	class TypeResolverVisitor final : public CopyVisitor
+	class TypeResolverVisitor final : public RewriteVisitor
 	{
 		public:
 		using TypeMap = TypeDiscovererVisitor::TypeMap;
@@ -30,8 +29,8 @@ namespace soul::ast::visitors
 			types::Type              return_type;
 		};
 
-		using VariableContext = std::vector<std::pair<std::string, types::Type>>;
-		using FunctionContext = std::vector<std::pair<std::string, FunctionDeclaration>>;
+		using VariableContext = std::vector<std::pair<Symbol, types::Type>>;
+		using FunctionContext = std::vector<std::pair<Symbol, FunctionDeclaration>>;
 
 		private:
 		TypeMap         _registered_types;
@@ -47,34 +46,34 @@ namespace soul::ast::visitors
 		TypeResolverVisitor& operator=(const TypeResolverVisitor&)     = delete;
 		TypeResolverVisitor& operator=(TypeResolverVisitor&&) noexcept = default;
 
-		using CopyVisitor::accept;
+		using RewriteVisitor::accept;
 
 		protected:
-		using CopyVisitor::visit;
-		void visit(const BinaryNode&) override;
-		void visit(const BlockNode&) override;
-		void visit(const CastNode&) override;
-		void visit(const ForLoopNode&) override;
-		void visit(const ForeachLoopNode&) override;
-		void visit(const FunctionCallNode&) override;
-		void visit(const FunctionDeclarationNode&) override;
-		void visit(const IfNode&) override;
-		void visit(const LiteralNode&) override;
-		void visit(const LoopControlNode&) override;
-		void visit(const ModuleNode&) override;
-		void visit(const ReturnNode&) override;
-		void visit(const StructDeclarationNode&) override;
-		void visit(const UnaryNode&) override;
-		void visit(const VariableDeclarationNode&) override;
-		void visit(const WhileNode&) override;
+		using RewriteVisitor::visit;
+		void visit(BinaryNode&) override;
+		void visit(BlockNode&) override;
+		void visit(CastNode&) override;
+		void visit(ForLoopNode&) override;
+		void visit(ForeachLoopNode&) override;
+		void visit(FunctionCallNode&) override;
+		void visit(FunctionDeclarationNode&) override;
+		void visit(IfNode&) override;
+		void visit(LiteralNode&) override;
+		void visit(LoopControlNode&) override;
+		void visit(ModuleNode&) override;
+		void visit(ReturnNode&) override;
+		void visit(StructDeclarationNode&) override;
+		void visit(UnaryNode&) override;
+		void visit(VariableDeclarationNode&) override;
+		void visit(WhileNode&) override;
 
 		private:
-		types::Type                        get_type_or_default(std::string_view type_identifier) const noexcept;
-		std::optional<types::Type>         get_variable_type(std::string_view name) const noexcept;
+		types::Type                        get_type_or_default(Symbol type_identifier) const noexcept;
+		std::optional<types::Type>         get_variable_type(Symbol name) const noexcept;
 		types::Type                        get_type_for_operator(ASTNode::Operator                      op,
 		                                                         const std::ranges::forward_range auto& input_types) const noexcept;
 		std::optional<FunctionDeclaration> get_function_declaration(
-			std::string_view                       name,
+			Symbol                                 name,
 			const std::ranges::forward_range auto& want_types) const noexcept;
 	};
 }  // namespace soul::ast::visitors
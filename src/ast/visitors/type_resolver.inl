@@ -36,7 +36,7 @@ namespace soul::ast::visitors
 	}
 
 	std::optional<TypeResolverVisitor::FunctionDeclaration> TypeResolverVisitor::get_function_declaration(
-		std::string_view                       name,
+		Symbol                                 name,
 		const std::ranges::forward_range auto& want_types) const noexcept
 	{
 		auto potential_declarations{
@@ -0,0 +1,117 @@
+#include "common/source_buffer.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <cerrno>
+
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace soul
+{
+	SourceBuffer::~SourceBuffer()
+	{
+		if (!_is_mapped) {
+			return;
+		}
+#if defined(_WIN32)
+		::UnmapViewOfFile(_data);
+#else
+		::munmap(const_cast<char*>(_data), _size);
+#endif
+	}
+
+	std::expected<SourceBuffer::Handle, std::error_code> SourceBuffer::map(const std::filesystem::path& path)
+	{
+		std::shared_ptr<SourceBuffer> buffer{ new SourceBuffer() };
+		buffer->_path = path;
+
+#if defined(_WIN32)
+		const auto last_error
+			= [] { return std::error_code(static_cast<int>(::GetLastError()), std::system_category()); };
+
+		HANDLE file = ::CreateFileW(path.c_str(),
+		                            GENERIC_READ,
+		                            FILE_SHARE_READ,
+		                            nullptr,
+		                            OPEN_EXISTING,
+		                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		                            nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return std::unexpected(last_error());
+		}
+
+		LARGE_INTEGER size{};
+		if (!::GetFileSizeEx(file, &size)) {
+			const auto error = last_error();
+			::CloseHandle(file);
+			return std::unexpected(error);
+		}
+		if (size.QuadPart == 0) {
+			::CloseHandle(file);
+			return buffer;  // Empty files cannot be mapped.
+		}
+
+		HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		::CloseHandle(file);
+		if (mapping == nullptr) {
+			return std::unexpected(last_error());
+		}
+
+		const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		::CloseHandle(mapping);  // View keeps the mapping alive.
+		if (data == nullptr) {
+			return std::unexpected(last_error());
+		}
+
+		buffer->_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		const auto last_error = [] { return std::error_code(errno, std::generic_category()); };
+
+		const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1) {
+			return std::unexpected(last_error());
+		}
+
+		struct stat status{};
+		if (::fstat(file, &status) == -1) {
+			const auto error = last_error();
+			::close(file);
+			return std::unexpected(error);
+		}
+		if (status.st_size == 0) {
+			::close(file);
+			return buffer;  // Empty files cannot be mapped.
+		}
+
+		void* data = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);  // Mapping keeps the file alive.
+		if (data == MAP_FAILED) {
+			return std::unexpected(last_error());
+		}
+		::madvise(data, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+
+		buffer->_size = static_cast<std::size_t>(status.st_size);
+#endif
+
+		buffer->_data      = static_cast<const char*>(data);
+		buffer->_is_mapped = true;
+		return buffer;
+	}
+
+	SourceBuffer::Handle SourceBuffer::from_string(std::string contents, std::filesystem::path path)
+	{
+		std::shared_ptr<SourceBuffer> buffer{ new SourceBuffer() };
+		buffer->_path     = std::move(path);
+		buffer->_contents = std::move(contents);
+		buffer->_data     = buffer->_contents.data();
+		buffer->_size     = buffer->_contents.size();
+		return buffer;
+	}
+}  // namespace soul
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace soul
+{
+	/**
+	 * @brief SourceBuffer owns the contents of a single script. Files are memory-mapped (read-only), thus the
+	 * Lexer (and Token::data) can refer straight into the mapping, without ever copying the script.
+	 * @details Buffers are shared (through SourceBuffer::Handle) by everything that refers to their contents, e.g.
+	 * the module compiled from them, which keeps the mapping alive for as long as it is needed.
+	 */
+	class SourceBuffer
+	{
+		public:
+		using Handle = std::shared_ptr<const SourceBuffer>;
+
+		private:
+		std::filesystem::path _path      = {};
+		const char*           _data      = nullptr;
+		std::size_t           _size      = 0;
+		bool                  _is_mapped = false;
+		std::string           _contents  = {};
+
+		public:
+		SourceBuffer(const SourceBuffer&)                = delete;
+		SourceBuffer(SourceBuffer&&) noexcept            = delete;
+		~SourceBuffer();
+		SourceBuffer& operator=(const SourceBuffer&)     = delete;
+		SourceBuffer& operator=(SourceBuffer&&) noexcept = delete;
+
+		/**
+		 * @brief Maps a file (read-only) into memory.
+		 * @param path Path to the file.
+		 * @return Handle to the buffer, or an error code if the file could not be mapped.
+		 */
+		[[nodiscard]] static std::expected<Handle, std::error_code> map(const std::filesystem::path& path);
+
+		/**
+		 * @brief Creates a buffer owning a script, which does not come from a file (e.g. was generated in memory).
+		 * @param contents Contents of the script.
+		 * @param path [Optional] Path, which the script should be associated with.
+		 */
+		[[nodiscard]] static Handle from_string(std::string contents, std::filesystem::path path = {});
+
+		/** @brief Returns the contents of the script. */
+		[[nodiscard]] std::string_view view() const noexcept { return { _data, _size }; }
+
+		/** @brief Returns path of the script (empty, if it was not read from a file). */
+		[[nodiscard]] const std::filesystem::path& path() const noexcept { return _path; }
+
+		/** @brief Checks if the contents are memory-mapped (instead of being owned by the buffer). */
+		[[nodiscard]] bool is_mapped() const noexcept { return _is_mapped; }
+
+		private:
+		SourceBuffer() = default;
+	};
+}  // namespace soul
@@ -36,3 +36,16 @@ namespace soul
 		return os << std::string(location);
 	}
 }  // namespace soul
+
+/**
+ * @brief Formats the location (as `row:column`) directly into the output.
+ */
+template <>
+struct std::formatter<soul::SourceLocation>
+{
+	constexpr auto parse(std::format_parse_context& context) { return context.begin(); }
+	auto           format(soul::SourceLocation location, std::format_context& context) const
+	{
+		return std::format_to(context.out(), "{}:{}", location.row, location.column);
+	}
+};
@@ -0,0 +1,183 @@
+#include "common/symbol.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace soul
+{
+	namespace
+	{
+		/**
+		 * @brief SymbolTable stores the names of all symbols. Lookups (of already interned names) take a shared lock,
+		 * thus concurrent lexers contend only when interning new names, while reading the names does not lock at all.
+		 * @details Names are indexed through chunks of geometrically growing sizes, which are never reallocated, thus
+		 * a reader of an (already obtained) id never observes them being moved.
+		 */
+		class SymbolTable
+		{
+			private:
+			static constexpr std::size_t k_first_chunk_size = 1024;
+			static constexpr std::size_t k_chunk_count      = 23;  // Enough to index every u32 id.
+
+			using Chunk     = std::unique_ptr<std::string_view[]>;
+			using ChunkView = std::atomic<const std::string_view*>;  // Published chunk, read without the lock.
+
+			mutable std::shared_mutex                        _mutex;
+			std::deque<std::string>                          _storage;  // Elements never move, thus views stay valid.
+			std::unordered_map<std::string_view, Symbol::Id> _ids;
+			std::array<Chunk, k_chunk_count>                 _chunks      = {};
+			std::array<ChunkView, k_chunk_count>             _chunk_views = {};
+			std::atomic<std::size_t>                         _count       = 0;
+			std::atomic<std::size_t>                         _size        = 0;
+
+			public:
+			SymbolTable() { append(std::string_view{}); }
+
+			static SymbolTable& instance()
+			{
+				static SymbolTable table;
+				return table;
+			}
+
+			/**
+			 * @brief Returns id of the name, alongside the name stored in the table.
+			 * @param max_size Size of the table past which new names are not interned.
+			 */
+			std::optional<std::pair<std::string_view, Symbol::Id>> intern(std::string_view name, std::size_t max_size)
+			{
+				{
+					std::shared_lock lock{ _mutex };
+					if (const auto it = _ids.find(name); it != std::end(_ids)) {
+						return *it;
+					}
+				}
+
+				std::unique_lock lock{ _mutex };
+				if (const auto it = _ids.find(name); it != std::end(_ids)) {
+					return *it;  // Interned by another thread in the meantime.
+				}
+				if (_size.load(std::memory_order_relaxed) + name.size() > max_size) {
+					return std::nullopt;
+				}
+				return append(name);
+			}
+
+			std::string_view name(Symbol::Id id) const noexcept
+			{
+				const auto [chunk, index] = locate(id);
+				return _chunk_views[chunk].load(std::memory_order_acquire)[index];
+			}
+
+			std::size_t count() const noexcept { return _count.load(std::memory_order_relaxed); }
+			std::size_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+
+			private:
+			/** @brief Returns the chunk holding the id, alongside the index of the id within it. */
+			static constexpr std::pair<std::size_t, std::size_t> locate(Symbol::Id id) noexcept
+			{
+				const auto chunk = static_cast<std::size_t>(std::bit_width(id / k_first_chunk_size + 1) - 1);
+				return { chunk, id - (k_first_chunk_size << chunk) + k_first_chunk_size };
+			}
+
+			/** @brief Appends a new name to the table; requires the unique lock (or no concurrent access). */
+			std::pair<std::string_view, Symbol::Id> append(std::string_view name)
+			{
+				const auto count = _count.load(std::memory_order_relaxed);
+				assert(count < std::numeric_limits<Symbol::Id>::max() && "too many symbols to index with u32");
+
+				const auto id             = static_cast<Symbol::Id>(count);
+				const auto [chunk, index] = locate(id);
+				if (!_chunks[chunk]) {
+					_chunks[chunk] = std::make_unique<std::string_view[]>(k_first_chunk_size << chunk);
+					_chunk_views[chunk].store(_chunks[chunk].get(), std::memory_order_release);
+				}
+
+				const std::string_view view = _storage.emplace_back(name);
+				_chunks[chunk][index]       = view;
+				_ids.emplace(view, id);
+				_count.store(count + 1, std::memory_order_release);
+				_size.fetch_add(name.size(), std::memory_order_relaxed);
+				return { view, id };
+			}
+		};
+
+		/**
+		 * @brief Interns the name through a (direct-mapped) per-thread cache, thus repeated identifiers, which are
+		 * the common case when parsing, neither lock nor hash the table.
+		 */
+		std::optional<Symbol::Id> intern(std::string_view name, std::size_t max_size)
+		{
+			struct CacheEntry
+			{
+				std::string_view name = {};  // Refers to the table, thus outlives the interned (script's) name.
+				Symbol::Id       id   = 0;
+			};
+			static constexpr std::size_t                        k_cache_size = 4096;
+			thread_local std::array<CacheEntry, k_cache_size> cache{};
+
+			// FNV-1a, which is cheap enough for (short) identifiers.
+			u32 hash = 2166136261U;
+			for (const auto c : name) {
+				hash = (hash ^ static_cast<u8>(c)) * 16777619U;
+			}
+
+			auto& entry = cache[hash & (k_cache_size - 1)];
+			if (entry.name != name) {
+				const auto interned = SymbolTable::instance().intern(name, max_size);
+				if (!interned) {
+					return std::nullopt;
+				}
+				entry = CacheEntry{ .name = interned->first, .id = interned->second };
+			}
+			return entry.id;
+		}
+	}  // namespace
+
+	Symbol::Symbol(std::string_view name)
+	{
+		const auto symbol = try_intern(name);
+		if (!symbol) {
+			throw std::length_error("symbol table exceeds Symbol::k_max_size");
+		}
+		_id = symbol->_id;
+	}
+
+	std::optional<Symbol> Symbol::try_intern(std::string_view name)
+	{
+		Symbol symbol{};
+		if (!name.empty()) {
+			const auto id = intern(name, k_max_size);
+			if (!id) {
+				return std::nullopt;
+			}
+			symbol._id = *id;
+		}
+		return symbol;
+	}
+
+	std::string_view Symbol::view() const noexcept
+	{
+		return _id == 0 ? std::string_view{} : SymbolTable::instance().name(_id);
+	}
+
+	std::size_t Symbol::count() noexcept { return SymbolTable::instance().count(); }
+
+	std::size_t Symbol::size() noexcept { return SymbolTable::instance().size(); }
+
+	std::strong_ordering Symbol::operator<=>(const Symbol& other) const noexcept
+	{
+		if (_id == other._id) {
+			return std::strong_ordering::equal;
+		}
+		return view() <=> other.view();
+	}
+}  // namespace soul
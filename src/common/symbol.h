@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <compare>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace soul
+{
+	/**
+	 * @brief Symbol is an interned identifier, i.e. a dense (u32) index into a process-wide table of distinct
+	 * names. Symbols are cheap to copy, and comparing them for equality (or hashing them) never touches the
+	 * underlying characters.
+	 * @details Table is filled by the Parser (with the identifiers of the nodes it builds; tokens are not interned,
+	 * thus lexing and relexing never grow it) and is append-only, thus the names remain valid for the lifetime of the
+	 * program. Each distinct name is stored once, i.e. the table grows only with names it has not seen yet, never with
+	 * repeated ones, and never past Symbol::k_max_size. Default-constructed Symbol represents an empty name.
+	 */
+	class Symbol
+	{
+		public:
+		using Id = u32;
+
+		/** @brief Size (in bytes, of the names) past which Symbol::try_intern refuses to grow the table. */
+		static constexpr std::size_t k_max_size = std::size_t{ 256 } * 1024 * 1024;
+
+		private:
+		Id _id = 0;
+
+		public:
+		constexpr Symbol() noexcept = default;
+
+		/**
+		 * @brief Interns the name.
+		 * @throws std::length_error If the name is not interned yet and the table already exceeds k_max_size; callers
+		 * which can recover (e.g. the Parser) should use Symbol::try_intern instead.
+		 */
+		Symbol(std::string_view name);
+		Symbol(const char* name) : Symbol(std::string_view{ name }) {}
+		Symbol(const std::string& name) : Symbol(std::string_view{ name }) {}
+
+		/**
+		 * @brief Interns the name, unless it is not interned yet and the table already exceeds k_max_size.
+		 */
+		[[nodiscard]] static std::optional<Symbol> try_intern(std::string_view name);
+
+		/** @brief Returns the interned name; does not lock the table. */
+		[[nodiscard]] std::string_view view() const noexcept;
+
+		/** @brief Returns the (dense) index of the symbol in the table. */
+		[[nodiscard]] constexpr Id id() const noexcept { return _id; }
+
+		[[nodiscard]] constexpr bool empty() const noexcept { return _id == 0; }
+
+		/** @brief Returns number of distinct symbols interned so far (including the empty one). */
+		[[nodiscard]] static std::size_t count() noexcept;
+
+		/** @brief Returns total size (in bytes) of the names interned so far. */
+		[[nodiscard]] static std::size_t size() noexcept;
+
+		constexpr bool operator==(const Symbol& other) const noexcept = default;
+
+		/** @brief Orders the symbols by their names (not ids), which makes the ordering independent of interning. */
+		std::strong_ordering operator<=>(const Symbol& other) const noexcept;
+
+		explicit operator std::string() const { return std::string(view()); }
+	};
+
+	template <typename T>
+	constexpr T& operator<<(T& stream, const Symbol& symbol)
+	{
+		stream << symbol.view();
+		return stream;
+	}
+}  // namespace soul
+
+template <>
+struct std::hash<soul::Symbol>
+{
+	std::size_t operator()(const soul::Symbol& symbol) const noexcept { return std::hash<soul::u32>{}(symbol.id()); }
+};
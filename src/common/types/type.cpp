@@ -1,5 +1,6 @@
 #include "common/types/type.h"
 
+#include <iterator>
 #include <sstream>
 #include <unordered_map>
 
@@ -7,12 +8,16 @@ namespace soul::types
 {
 	Type::operator std::string() const
 	{
-		return std::visit([](const auto& arg) -> std::string { return std::string(arg); }, _type);
+		std::string result{};
+		format_to(std::back_inserter(result), *this);
+		return result;
 	}
 
 	std::ostream& operator<<(std::ostream& os, const Type& type) { return os << std::string(type); }
 
-	PrimitiveType::operator std::string() const
+	PrimitiveType::operator std::string() const { return std::string(name()); }
+
+	std::string_view PrimitiveType::name() const noexcept
 	{
 		using namespace std::string_view_literals;
 		static constexpr auto                                            k_unknown = "__unknown__"sv;
@@ -28,9 +33,9 @@ namespace soul::types
             { PrimitiveType::Kind::Void,    "void"sv    },
 		};
 		if (!k_types.contains(type)) [[unlikely]] {
-			return std::string(k_unknown);
+			return k_unknown;
 		}
-		return std::string(k_types.at(type));
+		return k_types.at(type);
 	}
 
 	std::ostream& operator<<(std::ostream& os, const PrimitiveType& type) { return os << std::string(type); }
@@ -3,9 +3,14 @@
 #include "common/types/types_fwd.h"
 #include "core/types.h"
 
+#include <algorithm>
 #include <concepts>
+#include <format>
+#include <iterator>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -53,6 +58,9 @@ namespace soul::types
 		std::strong_ordering operator<=>(const PrimitiveType&) const         = default;
 		explicit             operator std::string() const;
 
+		/** @brief Returns name of the type, i.e. its textual representation. */
+		[[nodiscard]] std::string_view name() const noexcept;
+
 		friend std::ostream& operator<<(std::ostream& os, const PrimitiveType&);
 	};
 
@@ -155,4 +163,45 @@ namespace soul::types
 	{
 		return std::tie(lhs._type) <=> std::tie(rhs._type);
 	}
+
+	/**
+	 * @brief Writes textual representation of the type (i.e. Type::operator std::string) into the output, without
+	 * constructing any intermediate strings.
+	 * @return Iterator past the written representation.
+	 */
+	template <std::output_iterator<char> OutputIt>
+	OutputIt format_to(OutputIt out, const Type& type)
+	{
+		using namespace std::string_view_literals;
+
+		if (type.is<ArrayType>()) {
+			return std::ranges::copy("[]"sv, format_to(std::move(out), type.as<ArrayType>().data_type())).out;
+		}
+		if (type.is<StructType>()) {
+			const auto& types = type.as<StructType>().types;
+			*out++            = '(';
+			for (std::size_t index = 0; index < types.size(); ++index) {
+				if (index != 0) {
+					out = std::ranges::copy(", "sv, std::move(out)).out;
+				}
+				out = format_to(std::move(out), types[index]);
+			}
+			*out++ = ')';
+			return out;
+		}
+		return std::ranges::copy(type.as<PrimitiveType>().name(), std::move(out)).out;
+	}
 }  // namespace soul::types
+
+/**
+ * @brief Formats the type directly into the output, see soul::types::format_to.
+ */
+template <>
+struct std::formatter<soul::types::Type>
+{
+	constexpr auto parse(std::format_parse_context& context) { return context.begin(); }
+	auto           format(const soul::types::Type& type, std::format_context& context) const
+	{
+		return soul::types::format_to(context.out(), type);
+	}
+};
@@ -11,19 +11,9 @@ namespace soul
 
 	Value::operator std::string() const
 	{
-		return std::visit(
-			[](const auto& v) -> std::string {
-				if constexpr (std::is_same_v<std::remove_cvref_t<decltype(v)>, std::monostate>) {
-					return std::string("__unknown__");
-				} else if constexpr (std::is_constructible_v<std::decay_t<decltype(v)>, std::string>) {
-					return std::string(v);
-				} else {
-					std::stringstream ss;
-					ss << std::boolalpha << v;
-					return ss.str();
-				}
-			},
-			_value);
+		std::string result{};
+		format_to(std::back_inserter(result), *this);
+		return result;
 	}
 
 }  // namespace soul
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "common/symbol.h"
 #include "core/types.h"
 
+#include <algorithm>
 #include <concepts>
+#include <format>
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant>
 
@@ -20,6 +25,7 @@ namespace soul
 	                 || std::same_as<T, f64>             //
 	                 || std::same_as<T, std::string>     //
 	                 || std::same_as<T, char>            //
+	                 || std::same_as<T, Symbol>          //
 		;
 
 	/**
@@ -29,7 +35,7 @@ namespace soul
 	{
 		public:
 		using UnknownValue = std::monostate;
-		using Variant      = std::variant<UnknownValue, bool, i64, f64, std::string, char>;
+		using Variant      = std::variant<UnknownValue, bool, i64, f64, std::string, char, Symbol>;
 
 		private:
 		Variant _value = UnknownValue{};
@@ -40,6 +46,12 @@ namespace soul
 		Value(Value&&) noexcept      = default;
 		Value(Variant value);
 
+		/** @brief Constructs a string value, as a string literal is convertible to an identifier (Symbol) as well. */
+		template <std::size_t N>
+		Value(const char (&string)[N]) : _value(std::in_place_type<std::string>, string)
+		{
+		}
+
 		Value&                operator=(const Value&) noexcept        = default;
 		Value&                operator=(Value&&) noexcept             = default;
 		bool                  operator==(const Value&) const noexcept = default;
@@ -78,6 +90,51 @@ namespace soul
 		{
 			return std::get<T>(_value);
 		}
+
+		template <std::output_iterator<char> OutputIt>
+		friend OutputIt format_to(OutputIt out, const Value& value);
 	};
 
+	/**
+	 * @brief Writes textual representation of the value (i.e. Value::operator std::string) into the output, without
+	 * constructing any intermediate strings.
+	 * @return Iterator past the written representation.
+	 */
+	template <std::output_iterator<char> OutputIt>
+	OutputIt format_to(OutputIt out, const Value& value)
+	{
+		using namespace std::string_view_literals;
+
+		return std::visit(
+			[&](const auto& v) -> OutputIt {
+				using T = std::remove_cvref_t<decltype(v)>;
+				if constexpr (std::is_same_v<T, Value::UnknownValue>) {
+					return std::ranges::copy("__unknown__"sv, std::move(out)).out;
+				} else if constexpr (std::is_same_v<T, Symbol>) {
+					return std::ranges::copy(v.view(), std::move(out)).out;
+				} else if constexpr (std::is_same_v<T, std::string>) {
+					return std::ranges::copy(v, std::move(out)).out;
+				} else if constexpr (std::is_same_v<T, f64>) {
+					// NOTE: Matches the default formatting of the streams, i.e. at most 6 significant digits.
+					return std::format_to(std::move(out), "{:g}", v);
+				} else {
+					return std::format_to(std::move(out), "{}", v);
+				}
+			},
+			value._value);
+	}
+
 }  // namespace soul
+
+/**
+ * @brief Formats the value directly into the output, see soul::format_to.
+ */
+template <>
+struct std::formatter<soul::Value>
+{
+	constexpr auto parse(std::format_parse_context& context) { return context.begin(); }
+	auto           format(const soul::Value& value, std::format_context& context) const
+	{
+		return soul::format_to(context.out(), value);
+	}
+};
@@ -0,0 +1,178 @@
+#include "compiler/compilation_cache.h"
+
+#include "ast/visitors/serialize.h"
+#include "ast/visitors/type_discoverer.h"
+#include "ast/visitors/type_resolver.h"
+#include "parser/parser.h"
+
+#include <bit>
+#include <concepts>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace soul::compiler
+{
+	using namespace soul::ast;
+	using namespace soul::ast::visitors;
+
+	namespace
+	{
+		// Header: magic, format version (u32) and size of the script (u64), all little-endian; followed by the script.
+		constexpr std::size_t k_header_size = CompilationCache::k_magic.size() + sizeof(u32) + sizeof(u64);
+
+		template <std::unsigned_integral T>
+		void append_integer(std::string& bytes, T value)
+		{
+			for (std::size_t index = 0; index < sizeof(T); ++index) {
+				bytes.push_back(static_cast<char>(value >> (index * 8)));
+			}
+		}
+
+		template <std::unsigned_integral T>
+		T read_integer(std::string_view bytes, std::size_t offset) noexcept
+		{
+			T value = 0;
+			for (std::size_t index = 0; index < sizeof(T); ++index) {
+				value |= static_cast<T>(static_cast<u8>(bytes[offset + index])) << (index * 8);
+			}
+			return value;
+		}
+	}  // namespace
+
+	CompilationCache::CompilationCache(std::filesystem::path directory) : _directory(std::move(directory))
+	{
+		std::error_code error{};
+		std::filesystem::create_directories(_directory, error);
+	}
+
+	ASTNode::Dependency CompilationCache::compile(std::string_view module_name, SourceBuffer::Handle source)
+	{
+		if (auto module = load(module_name, source)) {
+			return module;
+		}
+
+		// NOTE: Passes rewrite the tree in place, thus the whole pipeline allocates from the arena of the parsed tree.
+		const auto      script = source->view();
+		ASTArena::Scope arena_scope{ std::make_shared<ASTArena>() };
+		auto            module = parser::Parser::parse(module_name, std::move(source));
+
+		TypeDiscovererVisitor type_discoverer{};
+		type_discoverer.accept(module);
+		if (module->has_errors()) {
+			return module;
+		}
+
+		TypeResolverVisitor type_resolver{ type_discoverer.discovered_types() };
+		type_resolver.accept(module);
+		if (!module->has_errors()) {
+			store(module.get(), script);
+		}
+		return module;
+	}
+
+	ASTNode::Dependency CompilationCache::load(std::string_view module_name, SourceBuffer::Handle source) const
+	{
+		const auto script = source->view();
+		const auto entry  = SourceBuffer::map(entry_path(script));
+		if (!entry.has_value()) {
+			return nullptr;
+		}
+
+		// NOTE: Hash (naming the entry) is not cryptographic, thus the whole script is compared instead.
+		const auto bytes = (*entry)->view();
+		if (bytes.size() < k_header_size + script.size() || !bytes.starts_with(k_magic)
+		    || read_integer<u32>(bytes, k_magic.size()) != SerializeVisitor::k_format_version
+		    || read_integer<u64>(bytes, k_magic.size() + sizeof(u32)) != script.size()
+		    || bytes.substr(k_header_size, script.size()) != script) {
+			return nullptr;
+		}
+
+		ASTArena::Scope arena_scope{ std::make_shared<ASTArena>() };
+		auto            module = SerializeVisitor::deserialize(bytes.substr(k_header_size + script.size()));
+		if (!module || !module->is<ModuleNode>()) {
+			return nullptr;
+		}
+		auto& module_node  = module->as<ModuleNode>();
+		module_node.name   = module_name;
+		module_node.source = std::move(source);
+		return module;
+	}
+
+	bool CompilationCache::store(ASTNode::Reference module, std::string_view script) const
+	{
+		SerializeVisitor serialize_visitor{};
+		serialize_visitor.accept(module);
+		if (!serialize_visitor.is_complete()) {
+			return false;  // Module could not be loaded anyway.
+		}
+
+		std::string bytes{ k_magic };
+		bytes.reserve(k_header_size + script.size() + serialize_visitor.bytes().size());
+		append_integer(bytes, SerializeVisitor::k_format_version);
+		append_integer(bytes, static_cast<u64>(script.size()));
+		bytes.append(script);
+		bytes.append(serialize_visitor.bytes());
+
+		// Entry is written under a unique name first and then renamed, thus concurrent compilations of the same script
+		// never observe a partially written entry.
+		const auto entry     = entry_path(script);
+		auto       temporary = entry;
+		temporary += ".tmp" + std::to_string(std::random_device{}());
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+			if (!file) {
+				std::error_code error{};
+				std::filesystem::remove(temporary, error);
+				return false;
+			}
+		}
+
+		std::error_code error{};
+		std::filesystem::rename(temporary, entry, error);
+		if (error) {
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+		return true;
+	}
+
+	std::filesystem::path CompilationCache::entry_path(std::string_view script) const
+	{
+		static constexpr std::string_view k_digits = "0123456789abcdef";
+
+		u64         value = hash(script);
+		std::string name(sizeof(u64) * 2, '0');
+		for (auto it = name.rbegin(); it != name.rend(); ++it, value >>= 4) {
+			*it = k_digits[value & 0xF];
+		}
+		name += k_extension;
+		return _directory / name;
+	}
+
+	u64 CompilationCache::hash(std::string_view script) noexcept
+	{
+		static constexpr u64 k_multiplier = 0x9E3779B97F4A7C15ULL;
+
+		// Processes 8 bytes at a time, thus hashing is cheap compared with loading the entry itself.
+		u64         result = script.size() * k_multiplier;
+		std::size_t offset = 0;
+		for (; offset + sizeof(u64) <= script.size(); offset += sizeof(u64)) {
+			result = (std::rotl(result, 29) ^ read_integer<u64>(script, offset)) * k_multiplier;
+		}
+		for (; offset < script.size(); ++offset) {
+			result = (std::rotl(result, 29) ^ static_cast<u8>(script[offset])) * k_multiplier;
+		}
+
+		// Finalizer of MurmurHash3, which mixes all the bits of the state into each bit of the result.
+		result ^= result >> 33;
+		result *= 0xFF51AFD7ED558CCDULL;
+		result ^= result >> 33;
+		result *= 0xC4CEB93D1A34E53BULL;
+		result ^= result >> 33;
+		return result;
+	}
+}  // namespace soul::compiler
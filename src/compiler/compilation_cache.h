@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ast/ast.h"
+#include "common/source_buffer.h"
+#include "core/types.h"
+
+#include <filesystem>
+#include <string_view>
+
+namespace soul::compiler
+{
+	/**
+	 * @brief CompilationCache stores parsed and type-resolved modules on disk, keyed by their script, thus unchanged
+	 * scripts are loaded instead of being lexed, parsed and type-resolved again.
+	 * @details Each entry is a single file in the cache directory (named after the hash of the script), which consists
+	 * of a header (identifying the format), a copy of the script and the module serialized with
+	 * ast::visitors::SerializeVisitor. Script is compared byte by byte when loading, thus colliding hashes never load
+	 * a module of another script. Entries which are malformed, stale or were written by other version of the compiler
+	 * are treated as missing.
+	 */
+	class CompilationCache
+	{
+		public:
+		/** @brief Identifies entries written by the cache; followed by the format version. */
+		static constexpr std::string_view k_magic     = "SOULAST2";
+		static constexpr std::string_view k_extension = ".soulc";
+
+		private:
+		std::filesystem::path _directory;
+
+		public:
+		/**
+		 * @brief Constructs the cache, which stores the entries in a given directory (created if it does not exist).
+		 */
+		explicit CompilationCache(std::filesystem::path directory);
+
+		/**
+		 * @brief Returns the module compiled from a given script, either loaded from the cache or compiled and then
+		 * stored in the cache.
+		 * @param module_name Name of the module.
+		 * @param source Script to compile.
+		 * @return Type-resolved module, or the module as it was after the first failing stage (i.e. containing
+		 * ErrorNodes), which is never stored in the cache.
+		 */
+		[[nodiscard]] ast::ASTNode::Dependency compile(std::string_view module_name, SourceBuffer::Handle source);
+
+		/**
+		 * @brief Loads the module compiled from a given script.
+		 * @return Type-resolved module, or nullptr if there is no (valid) entry for the script.
+		 */
+		[[nodiscard]] ast::ASTNode::Dependency load(std::string_view module_name, SourceBuffer::Handle source) const;
+
+		/**
+		 * @brief Stores type-resolved module compiled from a given script, replacing the previous entry (if any).
+		 * @return True if the entry was written, false otherwise (e.g. the module nests deeper than it could be
+		 * loaded, see ast::visitors::SerializeVisitor::k_max_depth).
+		 */
+		bool store(ast::ASTNode::Reference module, std::string_view script) const;
+
+		/** @brief Returns path of the entry for a given script. */
+		[[nodiscard]] std::filesystem::path entry_path(std::string_view script) const;
+
+		/**
+		 * @brief Computes 64-bit (non-cryptographic) hash of a script, which names its entry.
+		 */
+		[[nodiscard]] static u64 hash(std::string_view script) noexcept;
+	};
+}  // namespace soul::compiler
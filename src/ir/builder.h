@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/symbol.h"
 #include "ir/basic_block.h"
 #include "ir/instruction.h"
 #include "ir/ir.h"
@@ -17,8 +18,7 @@ namespace soul::ir
 	class IRBuilder
 	{
 		private:
-		using VariableContext
-			= std::unordered_map<std::string_view /* identifier */, std::vector<Instruction*> /* upsilons */>;
+		using VariableContext = std::unordered_map<Symbol /* identifier */, std::vector<Instruction*> /* upsilons */>;
 
 		private:
 		std::unique_ptr<Module> _module{};
@@ -44,7 +44,7 @@ namespace soul::ir
 		 * @brief Creates a new function in the module (with a single basic block initialized).
 		 * @warning Switches the current basic block to a newly initialized one.
 		 */
-		constexpr void create_function(std::string_view         identifier,
+		constexpr void create_function(Symbol                   identifier,
 		                               types::Type              return_type,
 		                               std::vector<types::Type> parameters);
 
@@ -75,7 +75,7 @@ namespace soul::ir
 		 * @return Pointer to the instruction emitted.
 		 */
 		template <typename... Args>
-		constexpr Instruction* emit_upsilon(std::string_view identifier, Args&&... args);
+		constexpr Instruction* emit_upsilon(Symbol identifier, Args&&... args);
 
 		/**
 		 * @brief Constructs new Phi instruction and appends it to the end of the current BasicBlock.
@@ -85,7 +85,7 @@ namespace soul::ir
 		 * @return Pointer to the instruction emitted.
 		 */
 		template <typename... Args>
-		constexpr Instruction* emit_phi(std::string_view identifier, Args&&... args);
+		constexpr Instruction* emit_phi(Symbol identifier, Args&&... args);
 
 		private:
 		template <InstructionKind Inst, typename... Args>
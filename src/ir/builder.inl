@@ -10,7 +10,7 @@ namespace soul::ir
 
 	constexpr auto IRBuilder::set_module_name(std::string_view name) -> void { _module->name = std::string(name); }
 
-	constexpr auto IRBuilder::create_function(std::string_view         identifier,
+	constexpr auto IRBuilder::create_function(Symbol                   identifier,
 	                                          types::Type              return_type,
 	                                          std::vector<types::Type> parameters) -> void
 	{
@@ -66,7 +66,7 @@ namespace soul::ir
 	}
 
 	template <typename... Args>
-	constexpr auto IRBuilder::emit_upsilon(std::string_view identifier, Args&&... args) -> Instruction*
+	constexpr auto IRBuilder::emit_upsilon(Symbol identifier, Args&&... args) -> Instruction*
 	{
 		auto* upsilon = emit_impl<Upsilon, Args...>(std::forward<Args>(args)..., nullptr);
 		_variable_context[identifier].emplace_back(upsilon);
@@ -74,7 +74,7 @@ namespace soul::ir
 	}
 
 	template <typename... Args>
-	constexpr auto IRBuilder::emit_phi(std::string_view identifier, Args&&... args) -> Instruction*
+	constexpr auto IRBuilder::emit_phi(Symbol identifier, Args&&... args) -> Instruction*
 	{
 		auto* phi = emit_impl<Phi>(std::forward<Args>(args)...);
 
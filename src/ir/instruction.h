@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/symbol.h"
 #include "common/types/type.h"
 #include "common/value.h"
 #include "core/types.h"
@@ -105,11 +106,11 @@ namespace soul::ir
 	struct Call final : public Instruction
 	{
 		public:
-		std::string               identifier;
+		Symbol                    identifier;
 		std::vector<Instruction*> parameters;
 
 		public:
-		constexpr Call(types::Type return_type, std::string identifier, std::vector<Instruction*> parameters);
+		constexpr Call(types::Type return_type, Symbol identifier, std::vector<Instruction*> parameters);
 		virtual ~Call() override = default;
 
 		constexpr bool operator==(const Call& other) const noexcept  = default;
@@ -41,9 +41,9 @@ namespace soul::ir
 	{
 	}
 
-	constexpr Call::Call(types::Type return_type, std::string identifier, std::vector<Instruction*> parameters)
+	constexpr Call::Call(types::Type return_type, Symbol identifier, std::vector<Instruction*> parameters)
 		: Instruction(std::move(return_type), Instruction::no_args()),
-		  identifier(std::move(identifier)),
+		  identifier(identifier),
 		  parameters(std::move(parameters))
 	{
 	}
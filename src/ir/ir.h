@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/symbol.h"
 #include "common/types/type.h"
 #include "ir/basic_block.h"
 
@@ -14,13 +15,13 @@ namespace soul::ir
 	struct Function
 	{
 		public:
-		std::string                              name;
+		Symbol                                   name;
 		types::Type                              return_type;
 		std::vector<types::Type>                 parameters;
 		std::vector<std::unique_ptr<BasicBlock>> basic_blocks;
 
 		public:
-		constexpr Function(std::string_view name, types::Type return_type, std::vector<types::Type> parameters);
+		constexpr Function(Symbol name, types::Type return_type, std::vector<types::Type> parameters);
 	};
 
 	class Module
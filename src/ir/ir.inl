@@ -1,8 +1,8 @@
 #pragma once
 namespace soul::ir
 {
-	constexpr Function::Function(std::string_view name, types::Type return_type, std::vector<types::Type> parameters)
-		: name(std::string(name)), return_type(std::move(return_type)), parameters(std::move(parameters))
+	constexpr Function::Function(Symbol name, types::Type return_type, std::vector<types::Type> parameters)
+		: name(name), return_type(std::move(return_type)), parameters(std::move(parameters))
 	{
 	}
 
@@ -24,7 +24,7 @@ namespace soul::ir::visitors
 				continue;
 			}
 
-			_ss << std::format("fn @{}", function->name);
+			_ss << std::format("fn @{}", function->name.view());
 			_ss << "(";
 			for (std::size_t parameter_index = 0; parameter_index < function->parameters.size(); ++parameter_index) {
 				_ss << std::format("%{}::{}", parameter_index, std::string(function->parameters[parameter_index]));
@@ -88,7 +88,7 @@ namespace soul::ir::visitors
 			             | std::views::transform([](const auto version) { return std::format("%{}", version); })  //
 			             | std::views::join_with(k_separator)                                                     //
 			             | std::ranges::to<std::string>() };
-		_ss << std::format("Call(`{}`, [{}])", instruction.identifier, parameters);
+		_ss << std::format("Call(`{}`, [{}])", instruction.identifier.view(), parameters);
 	}
 
 	void PrintVisitor::visit(const Const& instruction)
@@ -2,6 +2,10 @@
 
 #include "core/types.h"
 
+#include <array>
+#include <string_view>
+#include <utility>
+
 namespace soul
 {
 	/**
@@ -21,6 +25,40 @@ namespace soul
 		static constexpr ValueType k_hyphen          = 0x2D;        // U+002D HYPHEN (-)
 		static constexpr ValueType k_full_stop       = 0x2E;        // U+002E FULL STOP  (.)
 		static constexpr ValueType k_low_line        = 0x5F;        // U+005F LOW LINE (_)
+		static constexpr ValueType k_max_ascii       = 0x7F;        // U+007F DELETE, last single byte character.
+		static constexpr ValueType k_max_value       = 0x10FFFF;
+
+		/**
+		 * @brief Bit mask of the classes a character belongs to, see CodePoint::k_classes.
+		 */
+		using ClassMask                               = u8;
+		static constexpr ClassMask k_class_newline    = 1 << 0;
+		static constexpr ClassMask k_class_whitespace = 1 << 1;
+		static constexpr ClassMask k_class_alpha      = 1 << 2;
+		static constexpr ClassMask k_class_digit      = 1 << 3;
+		static constexpr ClassMask k_class_identifier = 1 << 4;
+
+		/**
+		 * @brief Classes of all single byte characters, thus classifying one is a single (branchless) lookup.
+		 */
+		static constexpr std::array<ClassMask, 256> k_classes = [] {
+			std::array<ClassMask, 256> classes{};
+			for (const auto c : { k_end_of_line, k_form_feed, k_carriage_return }) {
+				classes[c] |= k_class_newline | k_class_whitespace;
+			}
+			for (const auto c : { k_tabulation, k_space }) {
+				classes[c] |= k_class_whitespace;
+			}
+			for (ValueType c = 0x41; c <= 0x5A; ++c) {
+				classes[c] |= k_class_alpha | k_class_identifier;          // A-Z
+				classes[c + 0x20] |= k_class_alpha | k_class_identifier;  // a-z
+			}
+			for (ValueType c = 0x30; c <= 0x39; ++c) {
+				classes[c] |= k_class_digit;
+			}
+			classes[k_low_line] |= k_class_identifier;
+			return classes;
+		}();
 
 		public:
 		CodePoint()                                = delete;
@@ -30,26 +68,71 @@ namespace soul
 		CodePoint& operator=(const CodePoint&)     = delete;
 		CodePoint& operator=(CodePoint&&) noexcept = delete;
 
-		static constexpr bool is_newline(CodePoint::ValueType c) noexcept
+		/** @brief Returns classes of the character; characters outside of the single byte range have none. */
+		static constexpr ClassMask classify(CodePoint::ValueType c) noexcept
 		{
-			return c == k_end_of_line || c == k_form_feed || c == k_carriage_return;
+			return c < k_classes.size() ? k_classes[c] : ClassMask{ 0 };
 		}
 
+		static constexpr bool is_newline(CodePoint::ValueType c) noexcept { return classify(c) & k_class_newline; }
+
 		static constexpr bool is_whitespace(CodePoint::ValueType c) noexcept
 		{
-			return is_newline(c) || c == k_tabulation || c == k_space;
+			return classify(c) & k_class_whitespace;
 		}
 
-		static constexpr bool is_alpha(CodePoint::ValueType c) noexcept
-		{
-			return (c >= 0x61 && c <= 0x7A) || (c >= 0x41 && c <= 0x5A);
-		}
+		static constexpr bool is_alpha(CodePoint::ValueType c) noexcept { return classify(c) & k_class_alpha; }
 
-		static constexpr bool is_digit(CodePoint::ValueType c) noexcept { return c >= 0x30 && c <= 0x39; }
+		static constexpr bool is_digit(CodePoint::ValueType c) noexcept { return classify(c) & k_class_digit; }
 
+		/**
+		 * @brief Checks whether the character can be a part of an identifier.
+		 * @details All (valid) characters outside of the ASCII range are accepted, as they appear only in
+		 * identifiers and string literals.
+		 */
 		static constexpr bool is_identifier(CodePoint::ValueType c) noexcept
 		{
-			return is_alpha(c) || c == CodePoint::k_low_line;
+			return (classify(c) & k_class_identifier) || (c > k_max_ascii && c <= k_max_value);
+		}
+
+		/**
+		 * @brief Decodes a single UTF-8 encoded character at the start of the text.
+		 * @details Only the shortest form encodings of Unicode scalar values are valid, i.e. overlong encodings,
+		 * surrogates and values above U+10FFFF are rejected.
+		 * @return Decoded character and number of bytes it occupies, or (k_eof, 0) if the encoding is not valid.
+		 */
+		static constexpr std::pair<ValueType, std::size_t> decode(std::string_view text) noexcept
+		{
+			constexpr std::pair<ValueType, std::size_t> k_invalid = { k_eof, 0 };
+			if (text.empty()) {
+				return k_invalid;
+			}
+
+			const auto lead = static_cast<u8>(text[0]);
+			if (lead <= k_max_ascii) {
+				return { lead, 1 };
+			}
+			// Continuation bytes (0x80-0xBF) cannot start a sequence, while 0xC0, 0xC1 and 0xF5+ only start invalid
+			// ones.
+			const std::size_t length = lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : lead < 0xF5 ? 4 : 0;
+			if (length == 0 || text.size() < length) {
+				return k_invalid;
+			}
+
+			ValueType value = lead & (0x7F >> length);
+			for (std::size_t index = 1; index < length; ++index) {
+				const auto continuation = static_cast<u8>(text[index]);
+				if ((continuation & 0xC0) != 0x80) {
+					return k_invalid;
+				}
+				value = (value << 6) | (continuation & 0x3F);
+			}
+
+			constexpr std::array<ValueType, 5> k_min_values = { 0, 0, 0x80, 0x800, 0x10000 };
+			if (value < k_min_values[length] || value > k_max_value || (value >= 0xD800 && value <= 0xDFFF)) {
+				return k_invalid;
+			}
+			return { value, length };
 		}
 	};
 }  // namespace soul
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "core/types.h"
+#include "lexer/token.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+namespace soul::lexer
+{
+	namespace detail
+	{
+		using namespace std::string_view_literals;
+
+		// Adding a new keyword only requires adding it to this table; the hash is regenerated at compile time.
+		static constexpr std::array k_keywords = {
+			// Keywords
+			std::make_pair("break"sv, Token::Type::KeywordBreak),
+			std::make_pair("cast"sv, Token::Type::KeywordCast),
+			std::make_pair("continue"sv, Token::Type::KeywordContinue),
+			std::make_pair("else"sv, Token::Type::KeywordElse),
+			std::make_pair("false"sv, Token::Type::KeywordFalse),
+			std::make_pair("fn"sv, Token::Type::KeywordFn),
+			std::make_pair("for"sv, Token::Type::KeywordFor),
+			std::make_pair("if"sv, Token::Type::KeywordIf),
+			std::make_pair("let"sv, Token::Type::KeywordLet),
+			std::make_pair("mut"sv, Token::Type::KeywordMut),
+			std::make_pair("native"sv, Token::Type::KeywordNative),
+			std::make_pair("return"sv, Token::Type::KeywordReturn),
+			std::make_pair("struct"sv, Token::Type::KeywordStruct),
+			std::make_pair("true"sv, Token::Type::KeywordTrue),
+			std::make_pair("while"sv, Token::Type::KeywordWhile),
+
+			// (Explicit) primitive types
+			std::make_pair("bool"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("chr"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("f32"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("f64"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("i32"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("i64"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("str"sv, Token::Type::LiteralIdentifier),
+			std::make_pair("void"sv, Token::Type::LiteralIdentifier),
+		};
+
+		static constexpr auto        k_keyword_length     = [](const auto& keyword) { return keyword.first.size(); };
+		static constexpr std::size_t k_keyword_slot_count = std::bit_ceil(k_keywords.size() * 4);
+		static constexpr u8          k_keyword_empty_slot = 0xFF;
+		static constexpr std::size_t k_keyword_min_length
+			= std::ranges::min(k_keywords | std::views::transform(k_keyword_length));
+		static constexpr std::size_t k_keyword_max_length
+			= std::ranges::max(k_keywords | std::views::transform(k_keyword_length));
+		static_assert(k_keywords.size() < k_keyword_empty_slot, "too many keywords to index them with u8");
+
+		/**
+		 * @brief Multipliers of the (first character, last character) pair used by the keyword hash.
+		 */
+		struct KeywordHashSeed
+		{
+			public:
+			u32 first = 0;
+			u32 last  = 0;
+		};
+
+		[[nodiscard]] constexpr std::size_t keyword_hash(std::string_view lexeme, KeywordHashSeed seed) noexcept
+		{
+			const auto first = static_cast<u32>(static_cast<u8>(lexeme.front()));
+			const auto last  = static_cast<u32>(static_cast<u8>(lexeme.back()));
+			return (first * seed.first + last * seed.last + static_cast<u32>(lexeme.size()))
+			     & (k_keyword_slot_count - 1);
+		}
+
+		/**
+		 * @brief Searches for the first seed, for which the keyword hash has no collisions.
+		 */
+		[[nodiscard]] consteval KeywordHashSeed find_keyword_hash_seed()
+		{
+			for (u32 first = 1; first < 256; ++first) {
+				for (u32 last = 1; last < 256; ++last) {
+					std::array<bool, k_keyword_slot_count> occupied{};
+					const auto is_unique = [&](const auto& keyword) -> bool {
+						return !std::exchange(occupied[keyword_hash(keyword.first, { first, last })], true);
+					};
+					if (std::ranges::all_of(k_keywords, is_unique)) {
+						return { first, last };
+					}
+				}
+			}
+			throw "no perfect hash exists for the keyword table; extend the hash function";
+		}
+
+		static constexpr KeywordHashSeed k_keyword_hash_seed = find_keyword_hash_seed();
+
+		static constexpr std::array k_keyword_slots = [] {
+			std::array<u8, k_keyword_slot_count> slots{};
+			slots.fill(k_keyword_empty_slot);
+			for (std::size_t index = 0; index < k_keywords.size(); ++index) {
+				slots[keyword_hash(k_keywords[index].first, k_keyword_hash_seed)] = static_cast<u8>(index);
+			}
+			return slots;
+		}();
+	}  // namespace detail
+
+	/**
+	 * @brief Returns type of the Token for an identifier-like lexeme, i.e. either a type of the matching keyword or
+	 * Token::Type::LiteralIdentifier.
+	 * @details Uses a perfect hash (computed at compile time) of the lexeme's length, first and last character, thus
+	 * at most one string comparison is performed.
+	 */
+	[[nodiscard]] constexpr Token::Type keyword_or_identifier(std::string_view lexeme) noexcept
+	{
+		if (lexeme.size() < detail::k_keyword_min_length || lexeme.size() > detail::k_keyword_max_length) {
+			return Token::Type::LiteralIdentifier;
+		}
+		const auto index = detail::k_keyword_slots[detail::keyword_hash(lexeme, detail::k_keyword_hash_seed)];
+		if (index == detail::k_keyword_empty_slot || detail::k_keywords[index].first != lexeme) {
+			return Token::Type::LiteralIdentifier;
+		}
+		return detail::k_keywords[index].second;
+	}
+}  // namespace soul::lexer
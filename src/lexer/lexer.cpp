@@ -1,51 +1,187 @@
 #include "lexer/lexer.h"
 
+#include "lexer/keyword.h"
+#include "lexer/scan.h"
+#include "lexer/symbol_dfa.h"
+
 #include <algorithm>
-#include <array>
-#include <functional>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <limits>
+#include <ranges>
+#include <thread>
 
 namespace soul::lexer
 {
-#define MATCH_ONE_CODEPOINT(codepoint, token_type)        \
-	case codepoint:                                       \
-	{                                                     \
-		return create_token(token_type, current_token()); \
-	}
+	using namespace std::string_view_literals;
 
-#define MATCH_TWO_CODEPOINTS(first_codepoint, second_codepoint, one_match_type, two_match_type) \
-	case first_codepoint:                                                                       \
-	{                                                                                           \
-		if (peek_at(0) == (second_codepoint)) {                                                 \
-			std::ignore = advance();                                                            \
-			return create_token(two_match_type, current_token());                               \
-		}                                                                                       \
-		return create_token(one_match_type, current_token());                                   \
-	}
+	/**
+	 * @brief Part of the script, which begins at the start of a line outside of any string literal or comment.
+	 */
+	struct Lexer::Chunk
+	{
+		public:
+		std::size_t begin = 0;
+		std::size_t end   = 0;
+	};
+
+	Lexer::Lexer(std::string_view script) : Lexer(script, 0) {}
 
-#define MATCH_TWO_CODEPOINTS_SPECIAL(                                                                            \
-	first_codepoint, second_codepoint_a, second_codepoint_b, match_one_type, match_two_type_a, match_two_type_b) \
-	case first_codepoint:                                                                                        \
-	{                                                                                                            \
-		const auto next_codepoint = peek_at(0);                                                                  \
-		if (next_codepoint == (second_codepoint_a)) {                                                            \
-			std::ignore = advance();                                                                             \
-			return create_token(match_two_type_a, current_token());                                              \
-		}                                                                                                        \
-		if (next_codepoint == (second_codepoint_b)) {                                                            \
-			std::ignore = advance();                                                                             \
-			return create_token(match_two_type_b, current_token());                                              \
-		}                                                                                                        \
-		return create_token(match_one_type, current_token());                                                    \
+	Lexer::Lexer(std::string_view script, std::size_t offset)
+		: _script(script), _offset_start(offset), _offset_current(offset)
+	{
+		assert(script.size() <= std::numeric_limits<u32>::max() && "script is too large to be indexed with u32");
 	}
 
-	using namespace std::string_view_literals;
+	std::vector<Token> Lexer::tokenize(std::string_view script) { return Lexer{ script }.tokenize(); }
+
+	std::vector<Token> Lexer::tokenize_parallel(std::string_view script,
+	                                            std::size_t      thread_count,
+	                                            std::size_t      min_chunk_size)
+	{
+		static constexpr std::size_t k_chunks_per_thread = 4;  // Evens out the work between the threads.
+
+		if (thread_count == 0) {
+			thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+		}
+		const auto chunk_count
+			= std::min(thread_count * k_chunks_per_thread, script.size() / std::max(min_chunk_size, 1UZ));
+		if (thread_count == 1 || chunk_count <= 1) {
+			return tokenize(script);
+		}
+
+		const auto                      chunks = split(script, chunk_count);
+		std::vector<std::vector<Token>> chunk_tokens(chunks.size());
+		{
+			std::atomic_size_t next_chunk = 0;
+			const auto         lex_chunks = [&] {
+				for (auto index = next_chunk++; index < chunks.size(); index = next_chunk++) {
+					// Lexer sees the script only up to the end of the chunk, but keeps the offsets (and thus the
+					// tokens' views) relative to the whole script.
+					const auto& chunk   = chunks[index];
+					chunk_tokens[index] = Lexer{ script.substr(0, chunk.end), chunk.begin }.tokenize();
+				}
+			};
+
+			const auto                worker_count = std::min(thread_count, chunks.size()) - 1;  // Excluding this one.
+			std::vector<std::jthread> workers;
+			workers.reserve(worker_count);
+			for (std::size_t index = 0; index < worker_count; ++index) {
+				workers.emplace_back(lex_chunks);
+			}
+			lex_chunks();
+		}  // Joins the workers.
+
+		std::size_t token_count = 0;
+		for (const auto& tokens : chunk_tokens) {
+			token_count += tokens.size();
+		}
+
+		std::vector<Token> result;
+		result.reserve(token_count);
+		for (const auto& tokens : chunk_tokens) {
+			result.insert(std::end(result), std::begin(tokens), std::end(tokens));
+		}
+		return result;
+	}
 
-	Lexer::Lexer(std::string_view script)
-		: _script(script), _offset_start(0), _offset_current(0), _current_location(1, 0)
+	TokenDelta Lexer::relex(std::span<const Token> tokens, std::string_view script, const TextEdit& edit)
 	{
+		const auto shift     = static_cast<i64>(edit.replacement.size()) - static_cast<i64>(edit.length);
+		const auto old_size  = static_cast<u32>(static_cast<i64>(script.size()) - shift);
+		const auto token_end = [&](std::size_t index) -> u32 {
+			const auto& token = tokens[index];
+			if (token.type == Token::Type::SpecialError) {
+				// Length of the errors is unknown, the next token is the (conservative) bound.
+				return index + 1 < tokens.size() ? tokens[index + 1].offset : old_size;
+			}
+			const auto quotes = token.type == Token::Type::LiteralString ? 2U : 0U;  // Data excludes the quotes.
+			return token.offset + static_cast<u32>(token.data.size()) + quotes;
+		};
+
+		// Token is affected by the edit if it ends at or after its start, as lexing a token inspects the character
+		// directly following it. Lexing restarts at the token before the first affected one, which (unlike the end
+		// of it) is never a part of whitespace or comment that the edit might have changed. If the very first token
+		// is affected, the edit might have changed whatever precedes it, thus lexing restarts at the script's start.
+		const auto affected = *std::ranges::partition_point(
+			std::views::iota(0UZ, tokens.size()), [&](std::size_t index) { return token_end(index) < edit.offset; });
+		const auto first = affected > 0 ? affected - 1 : 0;
+
+		TokenDelta delta{ .first = first, .shift = shift };
+		const auto edit_end = static_cast<u32>(edit.offset + edit.replacement.size());
+		auto       next     = first;  // First of the previous tokens, which might resynchronize.
+		Lexer      lexer{ script, affected > 0 ? tokens[first].offset : 0 };
+		for (;;) {
+			auto token = lexer.scan_token();
+			if (token.type == Token::Type::SpecialEndOfFile) {
+				next = tokens.size();
+				break;
+			}
+			if (token.offset >= edit_end) {
+				// Past the edit, scripts are identical (apart from the shift), thus lexing from the same position
+				// yields the same tokens.
+				const auto offset = static_cast<u32>(token.offset - shift);
+				while (next < tokens.size() && tokens[next].offset < offset) {
+					next++;
+				}
+				if (next < tokens.size() && tokens[next].offset == offset) {
+					break;
+				}
+			}
+			delta.inserted.push_back(token);
+		}
+		delta.removed = next - first;
+		return delta;
 	}
 
-	std::vector<Token> Lexer::tokenize(std::string_view script) { return Lexer{ script }.tokenize(); }
+	std::vector<Lexer::Chunk> Lexer::split(std::string_view script, std::size_t chunk_count)
+	{
+		enum class State : u8
+		{
+			Code,
+			String,
+			Comment,
+		};
+
+		const auto target_size = script.size() / chunk_count;
+
+		std::vector<Chunk> chunks;
+		chunks.reserve(chunk_count);
+
+		Chunk current{};
+		auto  state = State::Code;
+		for (std::size_t offset = 0; offset < script.size(); ++offset) {
+			const auto c = static_cast<CodePoint::ValueType>(static_cast<u8>(script[offset]));
+			if (CodePoint::is_newline(c)) {
+				if (state == State::String) {
+					continue;  // String literals might span multiple lines.
+				}
+
+				state = State::Code;
+				if (offset + 1 - current.begin >= target_size && chunks.size() + 1 < chunk_count) {
+					current.end = offset + 1;
+					chunks.push_back(current);
+					current = Chunk{ .begin = offset + 1 };
+				}
+				continue;
+			}
+
+			if (state == State::Comment) {
+				offset = find_newline(script, offset) - 1;
+				continue;
+			}
+			if (c == '"') {
+				state = state == State::Code ? State::String : State::Code;
+			} else if (c == '#' && state == State::Code) {
+				state = State::Comment;
+			}
+		}
+
+		current.end = script.size();
+		chunks.push_back(current);
+		return chunks;
+	}
 
 	std::vector<Token> Lexer::tokenize()
 	{
@@ -72,28 +208,19 @@ namespace soul::lexer
 
 	Token Lexer::create_token(Token::Type type, std::string_view data)
 	{
-		auto location = SourceLocation{ _current_location.row,
-			                            std::min(_current_location.column,
-			                                     _current_location.column - static_cast<u32>(data.size())) };
-		return Token{ type, data, std::move(location) };
+		return Token{ type, data, static_cast<u32>(_offset_start) };
 	};
 
 	Token Lexer::scan_token()
 	{
 		// Consume whitespace and comments.
-		{
-			auto keep_consuming = false;
-			do {
-				keep_consuming = false;
-				advance_while(CodePoint::is_whitespace);
-
-				// Skip comments.
-				if (peek_at(0) == '#') {
-					advance_while(std::not_fn(CodePoint::is_newline));
-					keep_consuming = true;
-				}
-			} while (peek_at(0) != CodePoint::k_eof && keep_consuming);
-		};
+		for (;;) {
+			consume_whitespace();
+			if (peek_at(0) != '#') {
+				break;
+			}
+			consume_comment();
+		}
 
 		_offset_start = _offset_current;
 
@@ -105,120 +232,125 @@ namespace soul::lexer
 		// Numeric
 		const bool has_sign = current_codepoint == CodePoint::k_hyphen || current_codepoint == CodePoint::k_plus_sign;
 		if (CodePoint::is_digit(peek_at(has_sign ? 1 : 0))) {
-			advance_while([](const auto c) -> bool {
-				return CodePoint::is_digit(c) || c == CodePoint::k_full_stop || c == CodePoint::k_plus_sign
-				    || c == CodePoint::k_hyphen;
-			});
-			const auto lexeme = current_token();
-			const bool has_decimal_point
-				= std::ranges::any_of(lexeme, [](const auto c) -> bool { return c == CodePoint::k_full_stop; });
-			return create_token(has_decimal_point ? Token::Type::LiteralFloat : Token::Type::LiteralInteger, lexeme);
+			return scan_number();
 		}
 
 		// Strings
 		if (current_codepoint == '"') {
-			std::ignore = advance();  // Skip '"'
-			advance_while([](const auto c) -> bool { return c != '"'; });
+			// NOTE: Bytes of multibyte UTF-8 sequences are never ASCII, thus the closing quote can be searched for
+			// directly, and only the literal itself is validated.
+			_offset_current = std::min(_script.find('"', _offset_current + 1), _script.size());
 			if (peek_at(0) == CodePoint::k_eof) {
 				static constexpr auto k_error_message = "unterminated string literal; did you forget '\"'?"sv;
 				return create_token(Token::Type::SpecialError, k_error_message);
 			}
 			std::ignore = advance();  // Skip '"'
+			if (!is_valid_utf8(current_token(1, 1))) {
+				static constexpr auto k_error_message = "string literal is not a valid UTF-8 sequence"sv;
+				return create_token(Token::Type::SpecialError, k_error_message);
+			}
 			return create_token(Token::Type::LiteralString, current_token(1, 1));
 		}
 
 		// Keywords & Literals
-		if (advance_if([](const auto c) -> bool { return CodePoint::is_identifier(c) || CodePoint::is_digit(c); })) {
-			static constexpr std::array k_keywords = {
-				// Keywords
-				std::make_pair("break"sv, Token::Type::KeywordBreak),
-				std::make_pair("cast"sv, Token::Type::KeywordCast),
-				std::make_pair("continue"sv, Token::Type::KeywordContinue),
-				std::make_pair("else"sv, Token::Type::KeywordElse),
-				std::make_pair("false"sv, Token::Type::KeywordFalse),
-				std::make_pair("fn"sv, Token::Type::KeywordFn),
-				std::make_pair("for"sv, Token::Type::KeywordFor),
-				std::make_pair("if"sv, Token::Type::KeywordIf),
-				std::make_pair("let"sv, Token::Type::KeywordLet),
-				std::make_pair("mut"sv, Token::Type::KeywordMut),
-				std::make_pair("native"sv, Token::Type::KeywordNative),
-				std::make_pair("return"sv, Token::Type::KeywordReturn),
-				std::make_pair("struct"sv, Token::Type::KeywordStruct),
-				std::make_pair("true"sv, Token::Type::KeywordTrue),
-				std::make_pair("while"sv, Token::Type::KeywordWhile),
-
-				// (Explicit) primitive types
-				std::make_pair("bool"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("chr"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("f32"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("f64"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("i32"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("i64"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("str"sv, Token::Type::LiteralIdentifier),
-				std::make_pair("void"sv, Token::Type::LiteralIdentifier),
-			};
+		if (scan_identifier()) {
 			const auto lexeme = current_token();
-			const auto it     = std::ranges::find(k_keywords, lexeme, &decltype(k_keywords)::value_type::first);
-			return create_token(it != std::end(k_keywords) ? it->second : Token::Type::LiteralIdentifier, lexeme);
+			return create_token(keyword_or_identifier(lexeme), lexeme);
 		}
 
 		// Symbols
-		std::ignore = advance();
-		switch (current_codepoint) {
-			// Simple cases, where there are no other characters in the sequence.
-			MATCH_ONE_CODEPOINT('(', Token::Type::SymbolParenLeft)
-			MATCH_ONE_CODEPOINT(')', Token::Type::SymbolParenRight)
-			MATCH_ONE_CODEPOINT(',', Token::Type::SymbolComma)
-			MATCH_ONE_CODEPOINT('.', Token::Type::SymbolDot)
-			MATCH_ONE_CODEPOINT(';', Token::Type::SymbolSemicolon)
-			MATCH_ONE_CODEPOINT('?', Token::Type::SymbolQuestionMark)
-			MATCH_ONE_CODEPOINT('[', Token::Type::SymbolBracketLeft)
-			MATCH_ONE_CODEPOINT(']', Token::Type::SymbolBracketRight)
-			MATCH_ONE_CODEPOINT('^', Token::Type::SymbolCaret)
-			MATCH_ONE_CODEPOINT('{', Token::Type::SymbolBraceLeft)
-			MATCH_ONE_CODEPOINT('}', Token::Type::SymbolBraceRight)
-
-			// Tokens which might have one other character in the sequence.
-			MATCH_TWO_CODEPOINTS('%', '=', Token::Type::SymbolPercent, Token::Type::SymbolPercentEqual)
-			MATCH_TWO_CODEPOINTS('!', '=', Token::Type::SymbolBang, Token::Type::SymbolBangEqual)
-			MATCH_TWO_CODEPOINTS('&', '&', Token::Type::SymbolAmpersand, Token::Type::SymbolAmpersandAmpersand)
-			MATCH_TWO_CODEPOINTS('*', '=', Token::Type::SymbolStar, Token::Type::SymbolStarEqual)
-			MATCH_TWO_CODEPOINTS('/', '=', Token::Type::SymbolSlash, Token::Type::SymbolSlashEqual)
-			MATCH_TWO_CODEPOINTS(':', ':', Token::Type::SymbolColon, Token::Type::SymbolColonColon)
-			MATCH_TWO_CODEPOINTS('<', '=', Token::Type::SymbolLess, Token::Type::SymbolLessEqual)
-			MATCH_TWO_CODEPOINTS('=', '=', Token::Type::SymbolEqual, Token::Type::SymbolEqualEqual)
-			MATCH_TWO_CODEPOINTS('>', '=', Token::Type::SymbolGreater, Token::Type::SymbolGreaterEqual)
-			MATCH_TWO_CODEPOINTS('|', '|', Token::Type::SymbolPipe, Token::Type::SymbolPipePipe)
-
-			// Special cases, where the second character might be either present or vary.
-			MATCH_TWO_CODEPOINTS_SPECIAL(
-				'+', '+', '=', Token::Type::SymbolPlus, Token::Type::SymbolPlusPlus, Token::Type::SymbolPlusEqual)
-			MATCH_TWO_CODEPOINTS_SPECIAL(
-				'-', '-', '=', Token::Type::SymbolMinus, Token::Type::SymbolMinusMinus, Token::Type::SymbolMinusEqual)
-			default:
-				break;
+		if (const auto [type, length] = match_symbol(_script.substr(_offset_current)); length != 0) {
+			_offset_current += length;
+			return create_token(type, current_token());
+		}
+
+		if (current_codepoint > CodePoint::k_max_ascii) {
+			std::ignore = advance();
+			static constexpr auto k_error_message = "invalid UTF-8 sequence"sv;
+			return create_token(Token::Type::SpecialError, k_error_message);
 		}
 
+		std::ignore = advance();
 		static constexpr auto k_error_message = "unrecognized token"sv;
 		return create_token(Token::Type::SpecialError, k_error_message);
 	}
 
+	void Lexer::consume_whitespace() noexcept
+	{
+		_offset_current = skip_whitespace(_script, _offset_current);
+	}
+
+	void Lexer::consume_comment() noexcept
+	{
+		// Comments end with a newline character, which is left for the whitespace to consume.
+		_offset_current = find_newline(_script, _offset_current);
+	}
+
+	Token Lexer::scan_number()
+	{
+		// <number> ::= [ '+' | '-' ] <digit>+ [ '.' <digit>+ ]
+		const auto is_digit      = [](const auto c) -> bool { return CodePoint::is_digit(c); };
+		const bool has_plus_sign = peek_at(0) == CodePoint::k_plus_sign;
+		if (has_plus_sign || peek_at(0) == CodePoint::k_hyphen) {
+			std::ignore = advance();
+		}
+		advance_while(is_digit);
+		const bool is_float = peek_at(0) == CodePoint::k_full_stop && CodePoint::is_digit(peek_at(1));
+		if (is_float) {
+			std::ignore = advance();  // Skip '.'
+			advance_while(is_digit);
+		}
+
+		// Syntax was validated above, thus decoding fails only if the value is out of range.
+		// NOTE: std::from_chars does not accept the plus sign.
+		const auto  lexeme = current_token();
+		const auto* first  = lexeme.data() + (has_plus_sign ? 1 : 0);
+		const auto* last   = lexeme.data() + lexeme.size();
+		if (is_float) {
+			auto token = create_token(Token::Type::LiteralFloat, lexeme);
+			if (std::from_chars(first, last, token.floating).ec != std::errc{}) {
+				return create_token(Token::Type::SpecialError, "float literal is out of range"sv);
+			}
+			return token;
+		}
+		auto token = create_token(Token::Type::LiteralInteger, lexeme);
+		if (std::from_chars(first, last, token.integer).ec != std::errc{}) {
+			return create_token(Token::Type::SpecialError, "integer literal is out of range"sv);
+		}
+		return token;
+	}
+
+	bool Lexer::scan_identifier() noexcept
+	{
+		static constexpr auto k_identifier_classes = CodePoint::k_class_identifier | CodePoint::k_class_digit;
+		for (;;) {
+			advance_while([](const auto c) -> bool { return CodePoint::classify(c) & k_identifier_classes; });
+			if (const auto c = peek_at(0); c == CodePoint::k_eof || c <= CodePoint::k_max_ascii) {
+				break;
+			}
+
+			// Only characters outside of the ASCII range are decoded; invalid ones end the identifier and are
+			// reported as an error by the next token.
+			const auto [codepoint, length] = CodePoint::decode(_script.substr(_offset_current));
+			if (!CodePoint::is_identifier(codepoint)) {
+				break;
+			}
+			_offset_current += length;
+		}
+		return _offset_current != _offset_start;
+	}
+
 	CodePoint::ValueType Lexer::peek_at(std::size_t n) const
 	{
 		if (_offset_current + n >= _script.size()) {
 			return CodePoint::k_eof;
 		}
-		return _script[_offset_current + n];
+		return static_cast<u8>(_script[_offset_current + n]);
 	}
 
 	CodePoint::ValueType Lexer::advance()
 	{
-		if (CodePoint::is_newline(_script[_offset_current++])) {
-			++_current_location.row;
-			_current_location.column = 0;
-		} else {
-			++_current_location.column;
-		}
+		++_offset_current;
 		return peek_at(0);
 	}
 };  // namespace soul::lexer
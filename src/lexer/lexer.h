@@ -1,10 +1,11 @@
 #pragma once
 
-#include "common/source_location.h"
 #include "core/types.h"
 #include "lexer/codepoint.h"
 #include "lexer/token.h"
+#include "lexer/token_delta.h"
 
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -16,24 +17,89 @@ namespace soul::lexer
 	 */
 	class Lexer
 	{
+		public:
+		static constexpr std::size_t k_min_parallel_chunk_size = 256 * 1024;
+
+		private:
+		struct Chunk;
+
 		private:
 		std::string_view _script{};
 		std::size_t      _offset_start;
 		std::size_t      _offset_current;
-		SourceLocation   _current_location;
 
 		public:
+		explicit Lexer(std::string_view script);
+
+		/**
+		 * @brief Converts the whole script into a linear sequence of tokens (excluding the end of file one).
+		 */
 		[[nodiscard]] static std::vector<Token> tokenize(std::string_view script);
 
+		/**
+		 * @brief Converts the whole script into a linear sequence of tokens (excluding the end of file one), lexing
+		 * chunks of it in parallel.
+		 * @details Script is split only at newlines outside of string literals and comments, thus the result is
+		 * identical to the one of Lexer::tokenize. Scripts too small to be split are lexed serially.
+		 * @param script Script to tokenize.
+		 * @param thread_count [Optional] Number of threads to use; defaults to the number of hardware threads.
+		 * @param min_chunk_size [Optional] Minimal size (in bytes) of a single chunk.
+		 */
+		[[nodiscard]] static std::vector<Token> tokenize_parallel(
+			std::string_view script,
+			std::size_t      thread_count   = 0,
+			std::size_t      min_chunk_size = k_min_parallel_chunk_size);
+
+		/**
+		 * @brief Re-lexes a script after an edit, starting from the last token unaffected by it, until the newly
+		 * lexed tokens resynchronize with the previous ones.
+		 * @details Cost depends on the size of the edit (and the tokens it affects), not on the size of the script;
+		 * only offsets and sizes of the previous tokens are used, thus they might refer to the script before the edit.
+		 * @param tokens Tokens of the script before the edit, i.e. result of Lexer::tokenize.
+		 * @param script Script after the edit.
+		 * @param edit Edit, which was applied to the script.
+		 * @return Delta, which turns the previous tokens into the ones of the edited script.
+		 */
+		[[nodiscard]] static TokenDelta relex(std::span<const Token> tokens,
+		                                      std::string_view       script,
+		                                      const TextEdit&        edit);
+
+		/**
+		 * @brief Scans a single token. Once the end of the script is reached, Token::Type::SpecialEndOfFile is
+		 * returned (repeatedly).
+		 */
+		[[nodiscard]] Token scan_token();
+
 		private:
-		Lexer(std::string_view);
+		Lexer(std::string_view script, std::size_t offset);
 
 		std::vector<Token> tokenize();
 
+		/**
+		 * @brief Splits the script into (at most) a given number of chunks of similar size, which can be lexed
+		 * independently.
+		 */
+		static std::vector<Chunk> split(std::string_view script, std::size_t chunk_count);
+
 		std::string_view current_token(std::size_t exclude_start = 0, std::size_t exclude_end = 0);
 		Token            create_token(Token::Type type, std::string_view data);
-		Token            scan_token();
 
+		/**
+		 * @brief Scans a (possibly signed) integer or float literal, validating its syntax and decoding its value in
+		 * a single pass.
+		 */
+		Token scan_number();
+
+		/**
+		 * @brief Scans (the longest) sequence of identifier characters, decoding the ones outside of the ASCII range.
+		 * @return True if at least one character was scanned.
+		 */
+		bool scan_identifier() noexcept;
+
+		void consume_whitespace() noexcept;
+		void consume_comment() noexcept;
+
+		/** @brief Returns the n-th byte after the current one, or CodePoint::k_eof past the end of the script. */
 		CodePoint::ValueType peek_at(std::size_t n) const;
 		CodePoint::ValueType advance();
 
@@ -45,15 +111,5 @@ namespace soul::lexer
 				current_codepoint = advance();
 			}
 		}
-
-		template <std::predicate<CodePoint::ValueType> Predicate>
-		constexpr bool advance_if(Predicate&& predicate) noexcept
-		{
-			if (predicate(peek_at(0))) {
-				advance_while(predicate);
-				return true;
-			}
-			return false;
-		}
 	};
 }  // namespace soul::lexer
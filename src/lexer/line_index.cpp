@@ -0,0 +1,24 @@
+#include "lexer/line_index.h"
+
+#include "lexer/scan.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace soul::lexer
+{
+	LineIndex::LineIndex(std::string_view script)
+	{
+		assert(script.size() <= std::numeric_limits<u32>::max() && "script is too large to be indexed with u32");
+
+		_line_starts.push_back(0);
+		collect_line_starts(script, _line_starts);
+	}
+
+	SourceLocation LineIndex::location(u32 offset) const noexcept
+	{
+		const auto line = std::ranges::upper_bound(_line_starts, offset) - std::begin(_line_starts) - 1;
+		return SourceLocation{ static_cast<u32>(line + 1), offset - _line_starts[static_cast<std::size_t>(line)] };
+	}
+}  // namespace soul::lexer
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common/source_location.h"
+#include "core/types.h"
+
+#include <string_view>
+#include <vector>
+
+namespace soul::lexer
+{
+	/**
+	 * @brief LineIndex maps byte offsets in a script to their locations (row and column).
+	 * @details Offsets of line starts are gathered once, with a vectorized newline search; each lookup is a binary
+	 * search over them. Lexer records only offsets, thus this is needed only when a location is actually reported.
+	 */
+	class LineIndex
+	{
+		private:
+		std::vector<u32> _line_starts = {};
+
+		public:
+		explicit LineIndex(std::string_view script);
+
+		/** @brief Returns location of a given offset. */
+		[[nodiscard]] SourceLocation location(u32 offset) const noexcept;
+
+		/** @brief Returns number of lines in the script. */
+		[[nodiscard]] std::size_t line_count() const noexcept { return _line_starts.size(); }
+	};
+}  // namespace soul::lexer
@@ -0,0 +1,163 @@
+#include "lexer/scan.h"
+
+#include "lexer/codepoint.h"
+
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
+
+namespace soul::lexer
+{
+	namespace
+	{
+		/**
+		 * @brief Per-byte classification of a single block; n-th bit corresponds to the n-th byte of the block.
+		 */
+		struct BlockMasks
+		{
+			u32 whitespace;
+			u32 newline;
+		};
+
+#if defined(__AVX2__)
+		constexpr std::size_t k_block_size = 32;
+
+		BlockMasks classify_block(const char* data) noexcept
+		{
+			const auto block   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+			const auto matches = [&block](CodePoint::ValueType c) {
+				return _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(c)));
+			};
+			const auto newline = _mm256_or_si256(
+				_mm256_or_si256(matches(CodePoint::k_end_of_line), matches(CodePoint::k_form_feed)),
+				matches(CodePoint::k_carriage_return));
+			const auto whitespace = _mm256_or_si256(
+				newline, _mm256_or_si256(matches(CodePoint::k_tabulation), matches(CodePoint::k_space)));
+			return { static_cast<u32>(_mm256_movemask_epi8(whitespace)),
+				     static_cast<u32>(_mm256_movemask_epi8(newline)) };
+		}
+
+		u32 non_ascii_mask(const char* data) noexcept
+		{
+			// Bytes outside of the ASCII range are exactly the ones with the highest bit set.
+			return static_cast<u32>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data))));
+		}
+#elif defined(__SSE2__)
+		constexpr std::size_t k_block_size = 16;
+
+		BlockMasks classify_block(const char* data) noexcept
+		{
+			const auto block   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			const auto matches = [&block](CodePoint::ValueType c) {
+				return _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(c)));
+			};
+			const auto newline = _mm_or_si128(
+				_mm_or_si128(matches(CodePoint::k_end_of_line), matches(CodePoint::k_form_feed)),
+				matches(CodePoint::k_carriage_return));
+			const auto whitespace
+				= _mm_or_si128(newline, _mm_or_si128(matches(CodePoint::k_tabulation), matches(CodePoint::k_space)));
+			return { static_cast<u32>(_mm_movemask_epi8(whitespace)), static_cast<u32>(_mm_movemask_epi8(newline)) };
+		}
+
+		u32 non_ascii_mask(const char* data) noexcept
+		{
+			// Bytes outside of the ASCII range are exactly the ones with the highest bit set.
+			return static_cast<u32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))));
+		}
+#else
+		constexpr std::size_t k_block_size = 0;
+
+		BlockMasks classify_block(const char*) noexcept { return {}; }  // Not used; only the scalar path remains.
+		u32        non_ascii_mask(const char*) noexcept { return 0; }
+#endif
+	}  // namespace
+
+	std::size_t skip_whitespace(std::string_view script, std::size_t offset) noexcept
+	{
+		if constexpr (k_block_size != 0) {
+			for (; offset + k_block_size <= script.size(); offset += k_block_size) {
+				const auto whitespace = classify_block(script.data() + offset).whitespace;
+				if (const auto run_length = static_cast<std::size_t>(std::countr_one(whitespace));
+				    run_length < k_block_size) {
+					return offset + run_length;
+				}
+			}
+		}
+
+		for (; offset < script.size(); ++offset) {
+			if (!CodePoint::is_whitespace(static_cast<CodePoint::ValueType>(script[offset]))) {
+				break;
+			}
+		}
+		return offset;
+	}
+
+	std::size_t find_newline(std::string_view script, std::size_t offset) noexcept
+	{
+		if constexpr (k_block_size != 0) {
+			for (; offset + k_block_size <= script.size(); offset += k_block_size) {
+				if (const auto newline = classify_block(script.data() + offset).newline; newline != 0) {
+					return offset + static_cast<std::size_t>(std::countr_zero(newline));
+				}
+			}
+		}
+
+		for (; offset < script.size(); ++offset) {
+			if (CodePoint::is_newline(static_cast<CodePoint::ValueType>(script[offset]))) {
+				break;
+			}
+		}
+		return offset;
+	}
+
+	std::size_t skip_ascii(std::string_view script, std::size_t offset) noexcept
+	{
+		if constexpr (k_block_size != 0) {
+			for (; offset + k_block_size <= script.size(); offset += k_block_size) {
+				if (const auto non_ascii = non_ascii_mask(script.data() + offset); non_ascii != 0) {
+					return offset + static_cast<std::size_t>(std::countr_zero(non_ascii));
+				}
+			}
+		}
+
+		for (; offset < script.size(); ++offset) {
+			if (static_cast<u8>(script[offset]) > CodePoint::k_max_ascii) {
+				break;
+			}
+		}
+		return offset;
+	}
+
+	bool is_valid_utf8(std::string_view text) noexcept
+	{
+		for (auto offset = skip_ascii(text, 0); offset < text.size(); offset = skip_ascii(text, offset)) {
+			const auto [codepoint, length] = CodePoint::decode(text.substr(offset));
+			if (length == 0) {
+				return false;
+			}
+			offset += length;
+		}
+		return true;
+	}
+
+	void collect_line_starts(std::string_view script, std::vector<u32>& line_starts)
+	{
+		std::size_t offset = 0;
+		if constexpr (k_block_size != 0) {
+			for (; offset + k_block_size <= script.size(); offset += k_block_size) {
+				for (auto newline = classify_block(script.data() + offset).newline; newline != 0;
+				     newline &= newline - 1) {
+					line_starts.push_back(static_cast<u32>(offset + std::countr_zero(newline) + 1));
+				}
+			}
+		}
+
+		for (; offset < script.size(); ++offset) {
+			if (CodePoint::is_newline(static_cast<CodePoint::ValueType>(script[offset]))) {
+				line_starts.push_back(static_cast<u32>(offset + 1));
+			}
+		}
+	}
+}  // namespace soul::lexer
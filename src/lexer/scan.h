@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <string_view>
+#include <vector>
+
+namespace soul::lexer
+{
+	/**
+	 * @brief Skips all whitespace characters starting at a given offset.
+	 * @details Processes the input 32 (AVX2) or 16 (SSE2) bytes at a time when available, with a scalar fallback
+	 * for the remainder (and other architectures).
+	 * @param script Script to scan.
+	 * @param offset Offset to start scanning from.
+	 * @return Offset of the first non-whitespace character (or size of the script).
+	 */
+	[[nodiscard]] std::size_t skip_whitespace(std::string_view script, std::size_t offset) noexcept;
+
+	/**
+	 * @brief Returns the offset of the first newline character at or after a given offset, or size of the script if
+	 * there is none.
+	 * @param script Script to scan.
+	 * @param offset Offset to start scanning from.
+	 */
+	[[nodiscard]] std::size_t find_newline(std::string_view script, std::size_t offset) noexcept;
+
+	/**
+	 * @brief Returns the offset of the first non-ASCII byte at or after a given offset, or size of the script if there
+	 * is none.
+	 * @details Bytes are checked a whole block at a time, see skip_whitespace.
+	 * @param script Script to scan.
+	 * @param offset Offset to start scanning from.
+	 */
+	[[nodiscard]] std::size_t skip_ascii(std::string_view script, std::size_t offset) noexcept;
+
+	/**
+	 * @brief Checks whether the text is a valid UTF-8 sequence.
+	 * @details Only characters outside of all-ASCII blocks (see skip_ascii) are decoded, thus mostly ASCII text is
+	 * validated at nearly the cost of finding its end.
+	 */
+	[[nodiscard]] bool is_valid_utf8(std::string_view text) noexcept;
+
+	/**
+	 * @brief Appends offsets of all line starts (i.e. offsets directly after each newline character) to a vector.
+	 * @details Newlines are searched for a whole block at a time, see skip_whitespace.
+	 * @param script Script to scan.
+	 * @param line_starts Vector to append the offsets to.
+	 */
+	void collect_line_starts(std::string_view script, std::vector<u32>& line_starts);
+}  // namespace soul::lexer
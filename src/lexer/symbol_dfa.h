@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/types.h"
+#include "lexer/token.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <utility>
+
+namespace soul::lexer
+{
+	namespace detail
+	{
+		using namespace std::string_view_literals;
+
+		// Adding a new symbol only requires adding it to this table; the automaton is regenerated at compile time.
+		static constexpr std::array k_symbols = {
+			std::make_pair("!"sv, Token::Type::SymbolBang),
+			std::make_pair("!="sv, Token::Type::SymbolBangEqual),
+			std::make_pair("%"sv, Token::Type::SymbolPercent),
+			std::make_pair("%="sv, Token::Type::SymbolPercentEqual),
+			std::make_pair("&"sv, Token::Type::SymbolAmpersand),
+			std::make_pair("&&"sv, Token::Type::SymbolAmpersandAmpersand),
+			std::make_pair("("sv, Token::Type::SymbolParenLeft),
+			std::make_pair(")"sv, Token::Type::SymbolParenRight),
+			std::make_pair("*"sv, Token::Type::SymbolStar),
+			std::make_pair("*="sv, Token::Type::SymbolStarEqual),
+			std::make_pair("+"sv, Token::Type::SymbolPlus),
+			std::make_pair("++"sv, Token::Type::SymbolPlusPlus),
+			std::make_pair("+="sv, Token::Type::SymbolPlusEqual),
+			std::make_pair(","sv, Token::Type::SymbolComma),
+			std::make_pair("-"sv, Token::Type::SymbolMinus),
+			std::make_pair("--"sv, Token::Type::SymbolMinusMinus),
+			std::make_pair("-="sv, Token::Type::SymbolMinusEqual),
+			std::make_pair("."sv, Token::Type::SymbolDot),
+			std::make_pair("/"sv, Token::Type::SymbolSlash),
+			std::make_pair("/="sv, Token::Type::SymbolSlashEqual),
+			std::make_pair(":"sv, Token::Type::SymbolColon),
+			std::make_pair("::"sv, Token::Type::SymbolColonColon),
+			std::make_pair(";"sv, Token::Type::SymbolSemicolon),
+			std::make_pair("<"sv, Token::Type::SymbolLess),
+			std::make_pair("<="sv, Token::Type::SymbolLessEqual),
+			std::make_pair("="sv, Token::Type::SymbolEqual),
+			std::make_pair("=="sv, Token::Type::SymbolEqualEqual),
+			std::make_pair(">"sv, Token::Type::SymbolGreater),
+			std::make_pair(">="sv, Token::Type::SymbolGreaterEqual),
+			std::make_pair("?"sv, Token::Type::SymbolQuestionMark),
+			std::make_pair("["sv, Token::Type::SymbolBracketLeft),
+			std::make_pair("]"sv, Token::Type::SymbolBracketRight),
+			std::make_pair("^"sv, Token::Type::SymbolCaret),
+			std::make_pair("{"sv, Token::Type::SymbolBraceLeft),
+			std::make_pair("|"sv, Token::Type::SymbolPipe),
+			std::make_pair("||"sv, Token::Type::SymbolPipePipe),
+			std::make_pair("}"sv, Token::Type::SymbolBraceRight),
+		};
+
+		/**
+		 * @brief State of the automaton; state `N + 1` accepts the N-th symbol, while state 0 is the starting one.
+		 */
+		using SymbolState                           = u8;
+		static constexpr SymbolState k_symbol_start = 0;
+		static constexpr SymbolState k_symbol_dead  = 0xFF;
+		static_assert(k_symbols.size() + 1 < k_symbol_dead, "too many symbols to index them with u8");
+
+		/**
+		 * @brief Column of the transition table for each character; characters, which do not appear in any symbol,
+		 * share the column 0, from which there are no transitions.
+		 */
+		static constexpr std::array k_symbol_columns = [] {
+			std::array<u8, 256> columns{};
+			u8                  next_column = 1;
+			for (const auto& [symbol, type] : k_symbols) {
+				for (const auto c : symbol) {
+					if (columns[static_cast<u8>(c)] == 0) {
+						columns[static_cast<u8>(c)] = next_column++;
+					}
+				}
+			}
+			return columns;
+		}();
+
+		static constexpr std::size_t k_symbol_column_count = std::ranges::max(k_symbol_columns) + 1;
+
+		/**
+		 * @brief Returns state accepting a given symbol, or k_symbol_dead if there is no such symbol.
+		 */
+		[[nodiscard]] constexpr SymbolState symbol_state(std::string_view symbol)
+		{
+			const auto it = std::ranges::find(k_symbols, symbol, &decltype(k_symbols)::value_type::first);
+			return it == std::end(k_symbols) ? k_symbol_dead
+			                                 : static_cast<SymbolState>(std::distance(std::begin(k_symbols), it) + 1);
+		}
+
+		static constexpr auto k_symbol_transitions = [] {
+			std::array<std::array<SymbolState, k_symbol_column_count>, k_symbols.size() + 1> transitions{};
+			for (auto& row : transitions) {
+				row.fill(k_symbol_dead);
+			}
+			for (const auto& [symbol, type] : k_symbols) {
+				// Every prefix of a symbol has to be a symbol itself, thus the longest match never backtracks.
+				const auto prefix = symbol.substr(0, symbol.size() - 1);
+				const auto from   = prefix.empty() ? k_symbol_start : symbol_state(prefix);
+				if (from == k_symbol_dead) {
+					throw "prefix of a symbol has to be a symbol as well; add it to the symbol table";
+				}
+				transitions[from][k_symbol_columns[static_cast<u8>(symbol.back())]] = symbol_state(symbol);
+			}
+			return transitions;
+		}();
+	}  // namespace detail
+
+	/**
+	 * @brief Matches the longest symbol at the start of the text.
+	 * @details Runs an automaton (generated at compile time from the symbol table), which performs two table lookups
+	 * per character of the symbol.
+	 * @return Type of the matched symbol and its length, or Token::Type::SpecialError and 0 if there is none.
+	 */
+	[[nodiscard]] constexpr std::pair<Token::Type, std::size_t> match_symbol(std::string_view text) noexcept
+	{
+		detail::SymbolState state  = detail::k_symbol_start;
+		std::size_t         length = 0;
+		for (; length < text.size(); ++length) {
+			const auto next
+				= detail::k_symbol_transitions[state][detail::k_symbol_columns[static_cast<u8>(text[length])]];
+			if (next == detail::k_symbol_dead) {
+				break;
+			}
+			state = next;
+		}
+		if (state == detail::k_symbol_start) {
+			return { Token::Type::SpecialError, 0 };
+		}
+		return { detail::k_symbols[state - 1].second, length };
+	}
+}  // namespace soul::lexer
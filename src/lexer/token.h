@@ -1,6 +1,5 @@
 #pragma once
 
-#include "common/source_location.h"
 #include "core/types.h"
 
 #include <format>
@@ -17,9 +16,22 @@ namespace soul
 		enum class Type : u8;
 
 		public:
-		Type             type;
-		std::string_view data;
-		SourceLocation   location;
+		// NOTE: Offset is placed before the data, thus the token fits (along the union below) into 32 bytes.
+		Type             type   = {};
+		u32              offset = 0;  // Offset of the first character of the lexeme; see LineIndex for its location.
+		std::string_view data   = {};
+		union
+		{
+			i64 integer = 0;  // Decoded value of Token::Type::LiteralInteger tokens.
+			f64 floating;     // Decoded value of Token::Type::LiteralFloat tokens.
+		};
+
+		public:
+		constexpr Token() noexcept = default;
+		constexpr Token(Type type, std::string_view data = {}, u32 offset = 0) noexcept
+			: type(type), offset(offset), data(data)
+		{
+		}
 
 		constexpr bool operator==(const Token& other) const noexcept
 		{
@@ -37,6 +49,8 @@ namespace soul
 		static std::string_view internal_name(Token::Type type) noexcept;
 	};
 
+	static_assert(sizeof(Token) <= 32, "tokens are stored by value in large numbers, thus have to stay compact");
+
 	template <typename T>
 	constexpr T& operator<<(T& stream, const Token& token)
 	{
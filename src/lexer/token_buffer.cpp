@@ -0,0 +1,97 @@
+#include "lexer/token_buffer.h"
+
+#include "lexer/lexer.h"
+
+#include <algorithm>
+
+namespace soul::lexer
+{
+	TokenBuffer::TokenBuffer(std::string_view script) : _script(script) {}
+
+	TokenBuffer TokenBuffer::tokenize(std::string_view script)
+	{
+		TokenBuffer buffer{ script };
+		Lexer       lexer{ script };
+		for (;;) {
+			const auto token = lexer.scan_token();
+			if (token.type == Token::Type::SpecialEndOfFile) {
+				break;
+			}
+			buffer.push_back(token);
+		}
+		return buffer;
+	}
+
+	std::string_view TokenBuffer::data(Index index) const noexcept
+	{
+		if (_types[index] == Token::Type::SpecialError) {
+			const auto it = std::ranges::lower_bound(_errors, index, {}, &decltype(_errors)::value_type::first);
+			return it->second;
+		}
+		return _script.substr(_spans[index].start, _spans[index].length);
+	}
+
+	u32 TokenBuffer::offset(Index index) const noexcept
+	{
+		// Data of strings excludes the opening quote.
+		return _spans[index].start - (_types[index] == Token::Type::LiteralString ? 1 : 0);
+	}
+
+	Token TokenBuffer::operator[](Index index) const noexcept
+	{
+		const auto type = _types[index];
+		Token      token{ type, data(index), offset(index) };
+		if (type == Token::Type::LiteralInteger || type == Token::Type::LiteralFloat) {
+			const auto it = std::ranges::lower_bound(_numbers, index, {}, &Number::index);
+			if (type == Token::Type::LiteralInteger) {
+				token.integer = it->integer;
+			} else {
+				token.floating = it->floating;
+			}
+		}
+		return token;
+	}
+
+	TokenBuffer::Iterator TokenBuffer::begin() const noexcept { return Iterator{ this, 0 }; }
+
+	TokenBuffer::Iterator TokenBuffer::end() const noexcept { return Iterator{ this, static_cast<Index>(size()) }; }
+
+	void TokenBuffer::push_back(const Token& token)
+	{
+		const auto index = static_cast<Index>(_types.size());
+		_types.push_back(token.type);
+		if (token.type == Token::Type::SpecialError) {
+			// Data of errors is a message describing them, thus only the offset where they occurred is kept.
+			_spans.push_back(Span{ .start = token.offset, .length = 0 });
+			_errors.emplace_back(index, token.data);
+			return;
+		}
+		_spans.push_back(Span{ .start  = static_cast<u32>(token.data.data() - _script.data()),
+		                       .length = static_cast<u32>(token.data.size()) });
+		if (token.type == Token::Type::LiteralInteger) {
+			_numbers.push_back(Number{ .index = index, .integer = token.integer });
+		} else if (token.type == Token::Type::LiteralFloat) {
+			_numbers.push_back(Number{ .index = index, .floating = token.floating });
+		}
+	}
+
+	TokenBuffer::Iterator::Iterator(const TokenBuffer* buffer, Index index) noexcept
+		: _buffer(buffer), _index(index)
+	{
+	}
+
+	Token TokenBuffer::Iterator::operator*() const noexcept { return (*_buffer)[_index]; }
+
+	TokenBuffer::Iterator& TokenBuffer::Iterator::operator++() noexcept
+	{
+		++_index;
+		return *this;
+	}
+
+	TokenBuffer::Iterator TokenBuffer::Iterator::operator++(int) noexcept
+	{
+		auto result = *this;
+		++*this;
+		return result;
+	}
+}  // namespace soul::lexer
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/types.h"
+#include "lexer/token.h"
+
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace soul::lexer
+{
+	/**
+	 * @brief TokenBuffer stores a sequence of tokens in a compact, struct-of-arrays layout, i.e. types of the tokens
+	 * in one (u8) array and (u32) start/length pairs of their data in another.
+	 */
+	class TokenBuffer
+	{
+		public:
+		using Index = u32;
+		class Iterator;
+
+		/**
+		 * @brief Range of bytes (in the script) occupied by the token's data.
+		 */
+		struct Span
+		{
+			public:
+			u32 start  = 0;
+			u32 length = 0;
+		};
+
+		private:
+		/**
+		 * @brief Decoded value of a numeric literal, see Token::integer and Token::floating.
+		 */
+		struct Number
+		{
+			public:
+			Index index = 0;
+			union
+			{
+				i64 integer = 0;
+				f64 floating;
+			};
+		};
+
+		private:
+		std::string_view                                _script  = {};
+		std::vector<Token::Type>                        _types   = {};
+		std::vector<Span>                               _spans   = {};
+		std::vector<std::pair<Index, std::string_view>> _errors  = {};  // Messages are not part of the script.
+		std::vector<Number>                             _numbers = {};  // Values are not re-parsed from the script.
+
+		public:
+		/**
+		 * @brief Converts the whole script into a linear sequence of tokens (excluding the end of file one), storing
+		 * them directly in the buffer.
+		 */
+		[[nodiscard]] static TokenBuffer tokenize(std::string_view script);
+
+		[[nodiscard]] std::size_t      size() const noexcept { return _types.size(); }
+		[[nodiscard]] bool             empty() const noexcept { return _types.empty(); }
+		[[nodiscard]] std::string_view script() const noexcept { return _script; }
+
+		[[nodiscard]] std::span<const Token::Type> types() const noexcept { return _types; }
+		[[nodiscard]] std::span<const Span>        spans() const noexcept { return _spans; }
+
+		[[nodiscard]] Token::Type      type(Index index) const noexcept { return _types[index]; }
+		[[nodiscard]] std::string_view data(Index index) const noexcept;
+
+		/** @brief Returns offset of the first character of the lexeme, see Token::offset. */
+		[[nodiscard]] u32 offset(Index index) const noexcept;
+
+		/** @brief Materializes a single token. */
+		[[nodiscard]] Token operator[](Index index) const noexcept;
+
+		[[nodiscard]] Iterator begin() const noexcept;
+		[[nodiscard]] Iterator end() const noexcept;
+
+		private:
+		explicit TokenBuffer(std::string_view script);
+
+		void push_back(const Token& token);
+	};
+
+	/**
+	 * @brief Iterates over the TokenBuffer, materializing the tokens one at a time.
+	 */
+	class TokenBuffer::Iterator
+	{
+		public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = Token;
+		using difference_type   = std::ptrdiff_t;
+
+		private:
+		const TokenBuffer* _buffer = nullptr;
+		Index              _index  = 0;
+
+		public:
+		Iterator() = default;
+		Iterator(const TokenBuffer* buffer, Index index) noexcept;
+
+		[[nodiscard]] Token operator*() const noexcept;
+		Iterator&           operator++() noexcept;
+		Iterator            operator++(int) noexcept;
+
+		[[nodiscard]] bool operator==(const Iterator& other) const noexcept { return _index == other._index; }
+	};
+}  // namespace soul::lexer
@@ -0,0 +1,30 @@
+#include "lexer/token_delta.h"
+
+#include <iterator>
+
+namespace soul::lexer
+{
+	void TokenDelta::apply(std::vector<Token>& tokens, std::string_view script) const
+	{
+		const auto rebase = [script](Token& token, i64 shift) {
+			token.offset = static_cast<u32>(token.offset + shift);
+			if (token.type == Token::Type::SpecialError) {
+				return;  // Data of errors is a message describing them, not a part of the script.
+			}
+			const auto quote = token.type == Token::Type::LiteralString ? 1U : 0U;  // Data excludes the quotes.
+			token.data       = script.substr(token.offset + quote, token.data.size());
+		};
+
+		const auto first_it = std::next(std::begin(tokens), static_cast<std::ptrdiff_t>(first));
+		const auto last_it  = tokens.erase(first_it, std::next(first_it, static_cast<std::ptrdiff_t>(removed)));
+		tokens.insert(last_it, std::begin(inserted), std::end(inserted));
+
+		// Inserted tokens already refer to the edited script.
+		for (std::size_t index = 0; index < first; ++index) {
+			rebase(tokens[index], 0);
+		}
+		for (std::size_t index = first + inserted.size(); index < tokens.size(); ++index) {
+			rebase(tokens[index], shift);
+		}
+	}
+}  // namespace soul::lexer
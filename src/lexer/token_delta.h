@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/types.h"
+#include "lexer/token.h"
+
+#include <string_view>
+#include <vector>
+
+namespace soul::lexer
+{
+	/**
+	 * @brief Describes a single change of the script, i.e. replacement of a range of bytes with a different text.
+	 */
+	struct TextEdit
+	{
+		public:
+		u32              offset      = 0;   // Offset of the first replaced byte.
+		u32              length      = 0;   // Number of replaced (removed) bytes.
+		std::string_view replacement = {};  // Text inserted in place of the removed bytes.
+	};
+
+	/**
+	 * @brief Describes how a sequence of tokens changes after a TextEdit, i.e. which tokens should be replaced with
+	 * newly lexed ones. Tokens following the replaced ones are unchanged, apart from being shifted.
+	 */
+	struct TokenDelta
+	{
+		public:
+		std::size_t        first    = 0;   // Index of the first replaced token.
+		std::size_t        removed  = 0;   // Number of replaced tokens.
+		std::vector<Token> inserted = {};  // Tokens inserted in place of the replaced ones.
+		i64                shift    = 0;   // Change of the offsets of tokens following the replaced ones.
+
+		public:
+		/**
+		 * @brief Applies the delta to a sequence of tokens.
+		 * @details Remaining tokens are rebased onto the edited script, which is linear in their number; consumers,
+		 * which only care about the changed tokens, should use the delta directly.
+		 * @param tokens Tokens from which the delta was computed.
+		 * @param script Script after the edit.
+		 */
+		void apply(std::vector<Token>& tokens, std::string_view script) const;
+	};
+}  // namespace soul::lexer
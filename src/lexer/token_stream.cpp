@@ -0,0 +1,153 @@
+#include "lexer/token_stream.h"
+
+#include <cassert>
+#include <type_traits>
+
+namespace soul::lexer
+{
+	TokenStream::TokenStream(std::string_view script) : _source(std::in_place_type<Lexer>, script) { pull(); }
+
+	TokenStream::TokenStream(std::span<const Token> tokens) : _source(tokens) { pull(); }
+
+	TokenStream::TokenStream(const TokenBuffer& tokens) : _source(BufferCursor{ .buffer = &tokens, .index = 0 })
+	{
+		const auto types = tokens.types();
+		for (TokenBuffer::Index index = 0; index < types.size(); ++index) {
+			if (types[index] == Token::Type::SpecialError) {
+				_errors.push_back(tokens[index]);
+			}
+		}
+		for (auto index = static_cast<TokenBuffer::Index>(types.size()); index > 0; --index) {
+			if (types[index - 1] != Token::Type::SpecialError) {
+				_end_offset = end_offset(tokens[index - 1]);
+				break;
+			}
+		}
+	}
+
+	Token::Type TokenStream::current_type() const noexcept
+	{
+		if (const auto* cursor = std::get_if<BufferCursor>(&_source)) {
+			return cursor->index < cursor->buffer->size() ? cursor->buffer->type(cursor->index)
+			                                              : Token::Type::SpecialEndOfFile;
+		}
+		return _lookahead[_lookahead_begin].type;
+	}
+
+	Token TokenStream::current() const noexcept
+	{
+		if (const auto* cursor = std::get_if<BufferCursor>(&_source)) {
+			if (cursor->index < cursor->buffer->size()) {
+				return (*cursor->buffer)[cursor->index];
+			}
+			return Token{ Token::Type::SpecialEndOfFile, Token::internal_name(Token::Type::SpecialEndOfFile),
+				          _end_offset };
+		}
+		return _lookahead[_lookahead_begin];
+	}
+
+	Token TokenStream::peek(std::size_t n)
+	{
+		assert(n < k_max_lookahead && "lookahead distance exceeds the maximum lookahead");
+		if (auto* cursor = std::get_if<BufferCursor>(&_source)) {
+			const auto index = cursor->index + n;
+			if (index < cursor->buffer->size()) {
+				return (*cursor->buffer)[static_cast<TokenBuffer::Index>(index)];
+			}
+			return Token{ Token::Type::SpecialEndOfFile, Token::internal_name(Token::Type::SpecialEndOfFile),
+				          _end_offset };
+		}
+		while (_lookahead_size <= n) {
+			pull();
+		}
+		return _lookahead[(_lookahead_begin + n) % k_max_lookahead];
+	}
+
+	std::optional<Token> TokenStream::previous() const noexcept
+	{
+		if (const auto* cursor = std::get_if<BufferCursor>(&_source)) {
+			if (cursor->index == 0) {
+				return std::nullopt;
+			}
+			return (*cursor->buffer)[cursor->index - 1];
+		}
+		return _previous;
+	}
+
+	Token TokenStream::advance()
+	{
+		const auto token = current();
+		skip();
+		return token;
+	}
+
+	void TokenStream::skip()
+	{
+		if (current_type() == Token::Type::SpecialEndOfFile) {
+			return;
+		}
+
+		if (auto* cursor = std::get_if<BufferCursor>(&_source)) {
+			cursor->index++;
+			return;
+		}
+
+		_previous        = _lookahead[_lookahead_begin];
+		_lookahead_begin = (_lookahead_begin + 1) % k_max_lookahead;
+		if (--_lookahead_size == 0) {
+			pull();
+		}
+	}
+
+	bool TokenStream::empty() const noexcept { return current_type() == Token::Type::SpecialEndOfFile; }
+
+	void TokenStream::skip_all()
+	{
+		while (!empty()) {
+			skip();
+		}
+	}
+
+	std::span<const Token> TokenStream::errors() const noexcept { return _errors; }
+
+	void TokenStream::pull()
+	{
+		auto token = std::visit(
+			[](auto& source) -> Token {
+				using Source = std::remove_cvref_t<decltype(source)>;
+				if constexpr (std::is_same_v<Source, Lexer>) {
+					return source.scan_token();
+				} else if constexpr (std::is_same_v<Source, std::span<const Token>>) {
+					if (source.empty()) {
+						return Token{ Token::Type::SpecialEndOfFile };
+					}
+					auto front = source.front();
+					source     = source.subspan(1);
+					return front;
+				} else {
+					assert(false && "tokens of a TokenBuffer are never pulled");
+					return Token{ Token::Type::SpecialEndOfFile };
+				}
+			},
+			_source);
+
+		if (token.type == Token::Type::SpecialEndOfFile) {
+			token.data   = Token::internal_name(Token::Type::SpecialEndOfFile);
+			token.offset = _end_offset;
+		} else if (token.type != Token::Type::SpecialError) {
+			_end_offset = end_offset(token);
+		}
+		if (token.type == Token::Type::SpecialError) {
+			_errors.push_back(token);
+		}
+
+		_lookahead[(_lookahead_begin + _lookahead_size) % k_max_lookahead] = std::move(token);
+		_lookahead_size++;
+	}
+
+	u32 TokenStream::end_offset(const Token& token) noexcept
+	{
+		const auto quotes = token.type == Token::Type::LiteralString ? 2U : 0U;  // Data excludes the quotes.
+		return token.offset + static_cast<u32>(token.data.size()) + quotes;
+	}
+}  // namespace soul::lexer
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/types.h"
+#include "lexer/lexer.h"
+#include "lexer/token.h"
+#include "lexer/token_buffer.h"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace soul::lexer
+{
+	/**
+	 * @brief TokenStream lazily pulls tokens from a source (either a Lexer or an already lexed sequence of tokens),
+	 * keeping only a bounded window of lookahead in memory, which allows lexing and parsing in a single pass.
+	 * @details Once the source is exhausted, the stream keeps returning Token::Type::SpecialEndOfFile token, located
+	 * directly after the last token.
+	 * When reading from a TokenBuffer, the stream walks its arrays in place: type checks read only the array of types
+	 * and the full Token is materialized only when its payload is actually requested.
+	 */
+	class TokenStream
+	{
+		public:
+		static constexpr std::size_t k_max_lookahead = 4;
+
+		private:
+		/**
+		 * @brief Position within a TokenBuffer.
+		 */
+		struct BufferCursor
+		{
+			public:
+			const TokenBuffer* buffer = nullptr;
+			TokenBuffer::Index index  = 0;
+		};
+
+		using Source = std::variant<Lexer, std::span<const Token>, BufferCursor>;
+
+		private:
+		Source                             _source;
+		std::array<Token, k_max_lookahead> _lookahead       = {};
+		std::size_t                        _lookahead_begin = 0;
+		std::size_t                        _lookahead_size  = 0;
+		std::optional<Token>               _previous        = std::nullopt;
+		u32                                _end_offset      = 0;
+		std::vector<Token>                 _errors          = {};
+
+		public:
+		/**
+		 * @brief Creates a stream, which lexes the script on demand.
+		 */
+		explicit TokenStream(std::string_view script);
+
+		/**
+		 * @brief Creates a stream over already lexed tokens.
+		 */
+		explicit TokenStream(std::span<const Token> tokens);
+
+		/**
+		 * @brief Creates a stream over tokens stored in a TokenBuffer.
+		 */
+		explicit TokenStream(const TokenBuffer& tokens);
+
+		/** @brief Returns type of the current token, without materializing the token itself. */
+		[[nodiscard]] Token::Type current_type() const noexcept;
+
+		/** @brief Returns the current token, i.e. the next one to be consumed. */
+		[[nodiscard]] Token current() const noexcept;
+
+		/**
+		 * @brief Returns n-th token after the current one, i.e. `peek(0)` is equivalent to `current()`.
+		 * @param n Lookahead distance, must be smaller than k_max_lookahead.
+		 */
+		[[nodiscard]] Token peek(std::size_t n);
+
+		/** @brief Returns the most recently consumed token, if any. */
+		[[nodiscard]] std::optional<Token> previous() const noexcept;
+
+		/** @brief Consumes the current token and returns it. */
+		Token advance();
+
+		/** @brief Consumes the current token, without materializing it. */
+		void skip();
+
+		/** @brief Checks if all tokens were consumed. */
+		[[nodiscard]] bool empty() const noexcept;
+
+		/** @brief Consumes all remaining tokens. */
+		void skip_all();
+
+		/**
+		 * @brief Returns all Token::Type::SpecialError tokens pulled from the source so far.
+		 * @details For a TokenBuffer all of them are known upfront, thus they are returned from the start.
+		 */
+		[[nodiscard]] std::span<const Token> errors() const noexcept;
+
+		private:
+		void pull();
+
+		/** @brief Returns (script) offset directly after the token. */
+		[[nodiscard]] static u32 end_offset(const Token& token) noexcept;
+	};
+}  // namespace soul::lexer
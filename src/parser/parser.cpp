@@ -51,42 +51,59 @@ namespace soul::parser
 		SuffixFn   suffix     = nullptr;
 	};
 
-	Parser::Parser(std::string_view module_name, std::span<const Token> tokens)
-		: _tokens(tokens), _current_token(_tokens.begin()), _module_name(module_name)
+	Parser::Parser(std::string_view module_name, lexer::TokenStream tokens, SourceBuffer::Handle source)
+		: _tokens(std::move(tokens)), _module_name(module_name), _source(std::move(source))
 	{
 	}
 
 	ast::ASTNode::Dependency Parser::parse(std::string_view module_name, std::span<const Token> tokens)
 	{
-		return Parser{ module_name, tokens }.parse();
+		return parse(module_name, lexer::TokenStream{ tokens });
 	}
 
-	ast::ASTNode::Dependency Parser::parse()
+	ast::ASTNode::Dependency Parser::parse(std::string_view module_name, const lexer::TokenBuffer& tokens)
 	{
-		if (_tokens.empty()) {
-			return ModuleNode::create(std::string(_module_name), {});
-		}
+		return parse(module_name, lexer::TokenStream{ tokens });
+	}
+
+	ast::ASTNode::Dependency Parser::parse(std::string_view module_name, lexer::TokenStream tokens)
+	{
+		return Parser{ module_name, std::move(tokens) }.parse();
+	}
+
+	ast::ASTNode::Dependency Parser::parse(std::string_view module_name, SourceBuffer::Handle source)
+	{
+		auto tokens = lexer::TokenStream{ source->view() };
+		return Parser{ module_name, std::move(tokens), std::move(source) }.parse();
+	}
 
+	ast::ASTNode::Dependency Parser::parse()
+	{
 		ASTNode::Dependencies statements{};
-		for (const auto& token : _tokens) {
-			if (token.type == Token::Type::SpecialError) {
-				statements.emplace_back(ErrorNode::create(ErrorNode::Message{ token.data }));
-			}
+		while (!_tokens.empty() && _tokens.errors().empty()) {
+			statements.emplace_back(parse_statement());
 		}
-		if (!statements.empty()) {
-			return ModuleNode::create(std::string(_module_name), std::move(statements));
+
+		if (_is_symbol_table_full) {
+			statements.emplace_back(ErrorNode::create(
+				std::format("too many distinct identifiers; symbol table exceeds {} bytes", Symbol::k_max_size)));
 		}
 
-		while (_current_token != std::end(_tokens)) {
-			statements.emplace_back(parse_statement());
+		// Lexical errors take precedence over everything else, i.e. if there are any, only they are reported.
+		if (!_tokens.errors().empty()) {
+			_tokens.skip_all();
+			statements.clear();
+			for (const auto& token : _tokens.errors()) {
+				statements.emplace_back(ErrorNode::create(ErrorNode::Message{ token.data }));
+			}
 		}
-		return ModuleNode::create(std::string(_module_name), std::move(statements));
+		return ModuleNode::create(_module_name, std::move(statements), std::move(_source));
 	}
 
 	ASTNode::Dependency Parser::parse_statement()
 	{
 		// Statements
-		switch (current_token_or_default().type) {
+		switch (_tokens.current_type()) {
 			case Token::Type::KeywordBreak:
 			case Token::Type::KeywordContinue:
 				return parse_loop_control();
@@ -121,19 +138,19 @@ namespace soul::parser
 
 	ASTNode::Dependency Parser::parse_expression(Parser::Precedence precedence)
 	{
-		auto prefix_rule = precedence_rule(current_token_or_default().type).prefix;
+		auto prefix_rule = precedence_rule(_tokens.current_type()).prefix;
 		if (!prefix_rule) [[unlikely]] {
 			return create_error(std::format("[INTERNAL] no prefix precedence rule for '{}' was specified.",
-			                                Token::internal_name(current_token_or_default().type)));
+			                                Token::internal_name(_tokens.current_type())));
 		}
 
 		auto prefix_expression = (this->*prefix_rule)();
 
-		while (precedence <= precedence_rule(current_token_or_default().type).precedence) {
-			auto infix_rule = precedence_rule(current_token_or_default().type).infix;
+		while (precedence <= precedence_rule(_tokens.current_type()).precedence) {
+			auto infix_rule = precedence_rule(_tokens.current_type()).infix;
 			if (!infix_rule) [[unlikely]] {
 				return create_error(std::format("[INTERNAL] no infix precedence rule for '{}' was specified.",
-				                                Token::internal_name(current_token_or_default().type)));
+				                                Token::internal_name(_tokens.current_type())));
 			}
 			prefix_expression = (this->*infix_rule)(std::move(prefix_expression));
 		}
@@ -236,7 +253,7 @@ namespace soul::parser
 			                                std::string(current_token_or_default().data)));
 		}
 
-		return CastNode::create(std::move(expression), std::string(type_identifier->data));
+		return CastNode::create(std::move(expression), intern(type_identifier->data));
 	}
 
 	ASTNode::Dependency Parser::parse_for_loop()
@@ -312,7 +329,7 @@ namespace soul::parser
 
 		// <identifier>
 		if (!dependency->is<LiteralNode>()) {
-			const auto previous_token = peek(-1);
+			const auto previous_token = _tokens.previous();
 			return create_error(std::format("expected function name identifier, but got: '{}'",
 			                                std::string(previous_token ? previous_token->data : "__ERROR__")));
 		}
@@ -325,7 +342,7 @@ namespace soul::parser
 			                                std::string(current_token_or_default().data)));
 		}
 
-		const bool parenthesis_next = current_token_or_default().type == Token::Type::SymbolParenRight;
+		const bool parenthesis_next = _tokens.current_type() == Token::Type::SymbolParenRight;
 		if (!parenthesis_next) {
 			do {
 				// <expression>
@@ -339,7 +356,7 @@ namespace soul::parser
 			                                std::string(current_token_or_default().data)));
 		}
 
-		return FunctionCallNode::create(std::string(dependency->as<LiteralNode>().value.get<std::string>()),
+		return FunctionCallNode::create(dependency->as<LiteralNode>().value.get<Symbol>(),
 		                                std::move(parameters));
 	}
 
@@ -365,7 +382,7 @@ namespace soul::parser
 		// [Optional] '(' <parameter_list> ')'
 		ASTNode::Dependencies parameters{};
 		if (match(Token::Type::SymbolParenLeft)) {
-			const bool parenthesis_next = current_token_or_default().type == Token::Type::SymbolParenRight;
+			const bool parenthesis_next = _tokens.current_type() == Token::Type::SymbolParenRight;
 			if (!parenthesis_next) {
 				do {
 					parameters.emplace_back(parse_parameter_declaration());
@@ -395,8 +412,8 @@ namespace soul::parser
 
 		auto statements = parse_block_statement();
 
-		return FunctionDeclarationNode::create(std::string(name_identifier->data),
-		                                       std::string(type_identifier->data),
+		return FunctionDeclarationNode::create(intern(name_identifier->data),
+		                                       intern(type_identifier->data),
 		                                       std::move(parameters),
 		                                       BlockNode::create(std::move(statements)));
 	}
@@ -479,34 +496,23 @@ namespace soul::parser
 		                                        Token::Type::LiteralString });
 		if (!token) {
 			return create_error(std::format("expected literal expression, but got: '{}'",
-			                                Token::name(current_token_or_default().type)));
+			                                Token::name(_tokens.current_type())));
 		}
 
 		LiteralNode::Type literal_type{};
 		Value             value{};
+		// Values of numeric literals were already decoded by the lexer.
 		if (token->type == Token::Type::LiteralFloat) {
-			f64        v{};
-			const auto result = std::from_chars(std::begin(token->data), std::end(token->data), v);
-			if (result.ec != std::errc{}) {
-				return create_error(std::format("failed to parse float expression, because: '{}'",
-				                                std::make_error_condition(result.ec).message()));
-			}
-			value = Value{ v };
-
+			const f64 v  = token->floating;
+			value        = Value{ v };
 			literal_type = v <= std::numeric_limits<f32>::lowest() || v >= std::numeric_limits<f32>::max()
 			                 ? LiteralNode::Type::Float64
 			                 : LiteralNode::Type::Float32;
 		}
 
 		if (token->type == Token::Type::LiteralInteger) {
-			i64        v{};
-			const auto result = std::from_chars(std::begin(token->data), std::end(token->data), v);
-			if (result.ec != std::errc{}) {
-				return create_error(std::format("failed to parse integer expression, because: '{}'",
-				                                std::make_error_condition(result.ec).message()));
-			}
-			value = Value{ v };
-
+			const i64 v  = token->integer;
+			value        = Value{ v };
 			literal_type = v <= std::numeric_limits<i32>::lowest() || v >= std::numeric_limits<i32>::max()
 			                 ? LiteralNode::Type::Int64
 			                 : LiteralNode::Type::Int32;
@@ -519,7 +525,7 @@ namespace soul::parser
 
 		if (token->type == Token::Type::LiteralIdentifier) {
 			literal_type = LiteralNode::Type::Identifier;
-			value        = Value{ std::string(token->data) };
+			value        = Value{ intern(token->data) };
 		}
 
 		if (token->type == Token::Type::KeywordTrue) {
@@ -565,7 +571,7 @@ namespace soul::parser
 
 		// [ <expression> ]
 		ASTNode::Dependency expression = nullptr;
-		if (current_token_or_default().type != Token::Type::SymbolSemicolon) {
+		if (_tokens.current_type() != Token::Type::SymbolSemicolon) {
 			expression = parse_expression();
 		}
 
@@ -598,7 +604,7 @@ namespace soul::parser
 		}
 
 		ASTNode::Dependencies parameters{};
-		if (const auto current_type = current_token_or_default().type; current_type != Token::Type::SymbolBraceRight) {
+		if (const auto current_type = _tokens.current_type(); current_type != Token::Type::SymbolBraceRight) {
 			if (current_type == Token::Type::SpecialEndOfFile) {
 				return create_error(std::format("expected '{}', but got: '{}'",
 				                                Token::name(Token::Type::SymbolBraceRight),
@@ -609,7 +615,7 @@ namespace soul::parser
 				parameters.emplace_back(parse_parameter_declaration());
 
 				// ','
-				if (current_token_or_default().type != Token::Type::SymbolBraceRight
+				if (_tokens.current_type() != Token::Type::SymbolBraceRight
 				    && !require(Token::Type::SymbolComma)) {
 					return create_error(std::format("expected '{}', but got: '{}'",
 					                                Token::name(Token::Type::SymbolComma),
@@ -618,7 +624,7 @@ namespace soul::parser
 			}
 
 			// '}'
-			const auto previous_token = peek(-1);
+			const auto previous_token = _tokens.previous();
 			if (!previous_token || previous_token->type != Token::Type::SymbolBraceRight) {
 				return create_error(std::format("expected '{}', but got: '{}'",
 				                                Token::name(Token::Type::SymbolBraceRight),
@@ -633,7 +639,7 @@ namespace soul::parser
 			}
 		};
 
-		return StructDeclarationNode::create(std::string(name_identifier->data), std::move(parameters));
+		return StructDeclarationNode::create(intern(name_identifier->data), std::move(parameters));
 	}
 
 	ASTNode::Dependency Parser::parse_unary() { return create_error("Parser::parse_unary is not implemented yet."); }
@@ -684,7 +690,7 @@ namespace soul::parser
 		auto expression = parse_expression();
 
 		return VariableDeclarationNode::create(
-			std::string(name_identifier->data), std::string(type_identifier->data), std::move(expression), is_mutable);
+			intern(name_identifier->data), intern(type_identifier->data), std::move(expression), is_mutable);
 	}
 
 	ASTNode::Dependency Parser::parse_while_loop()
@@ -733,13 +739,13 @@ namespace soul::parser
 		}
 
 		while (!match(Token::Type::SymbolBraceRight)) {
-			if (current_token_or_default().type == Token::Type::SpecialEndOfFile) {
+			if (_tokens.current_type() == Token::Type::SpecialEndOfFile) {
 				break;
 			}
 
 			statements.emplace_back(parse_statement());
 
-			if (current_token_or_default().type != Token::Type::SymbolBraceRight) {
+			if (_tokens.current_type() != Token::Type::SymbolBraceRight) {
 				// ';'
 				if (!require(Token::Type::SymbolSemicolon)) {
 					statements.emplace_back(create_error(std::format("expected '{}', but got: '{}'",
@@ -750,7 +756,7 @@ namespace soul::parser
 			}
 		}
 
-		const auto previous_token = peek(-1);
+		const auto previous_token = _tokens.previous();
 		if (!previous_token || previous_token->type != Token::Type::SymbolBraceRight) {
 			statements.emplace_back(create_error(std::format("expected '{}', but got: '{}'",
 			                                                 Token::name(Token::Type::SymbolBraceRight),
@@ -793,7 +799,7 @@ namespace soul::parser
 		}
 
 		return VariableDeclarationNode::create(
-			std::string(name_identifier->data), std::string(type_identifier->data), std::move(expression), false);
+			intern(name_identifier->data), intern(type_identifier->data), std::move(expression), false);
 	}
 
 	ASTNode::Dependency Parser::create_error(ErrorNode::Message error_message)
@@ -804,53 +810,55 @@ namespace soul::parser
 			Token::Type::KeywordStruct,    Token::Type::KeywordWhile,     Token::Type::SymbolSemicolon,
 			Token::Type::SymbolBraceRight, Token::Type::SymbolParenRight,
 		};
-		while (_current_token != std::end(_tokens)) {
-			if (std::ranges::contains(k_synchronization_tokens, _current_token->type)) {
-				_current_token++;
+		while (!_tokens.empty()) {
+			const auto type = _tokens.current_type();
+			_tokens.skip();
+			if (std::ranges::contains(k_synchronization_tokens, type)) {
 				break;  // Synchronized.
 			}
-			_current_token++;
 		}
 
 		return ErrorNode::create(std::move(error_message));
 	}
 
+	Symbol Parser::intern(std::string_view identifier)
+	{
+		auto symbol = Symbol::try_intern(identifier);
+		if (!symbol) {
+			_is_symbol_table_full = true;
+			return Symbol{};
+		}
+		return *symbol;
+	}
+
 	std::optional<Token> Parser::require(Token::Type type)
 	{
-		if (_current_token == std::end(_tokens) || _current_token->type != type) {
+		if (_tokens.empty() || _tokens.current_type() != type) {
 			return std::nullopt;
 		}
-		return *_current_token++;
+		return _tokens.advance();
 	}
 
 	std::optional<Token> Parser::require(std::span<const Token::Type> types)
 	{
-		if (_current_token == std::end(_tokens)) {
+		if (_tokens.empty()) {
 			return std::nullopt;
 		}
 
 		for (const auto& type : types) {
-			if (_current_token->type == type) {
-				return *_current_token++;
+			if (_tokens.current_type() == type) {
+				return _tokens.advance();
 			}
 		}
 		return std::nullopt;
 	}
 
-	std::optional<Token> Parser::peek(std::ptrdiff_t n)
-	{
-		if ((_current_token + n) != std::end(_tokens)) {
-			return *(_current_token + n);
-		}
-		return std::nullopt;
-	}
-
 	bool Parser::match(Token::Type type)
 	{
-		if (_current_token == std::end(_tokens) || _current_token->type != type) {
+		if (_tokens.empty() || _tokens.current_type() != type) {
 			return false;
 		}
-		_current_token++;
+		_tokens.skip();
 		return true;
 	}
 
@@ -889,18 +897,6 @@ namespace soul::parser
 		return { Precedence::None, nullptr, nullptr, nullptr };  // No precedence.
 	}
 
-	Token Parser::current_token_or_default() const noexcept
-	{
-		if (_current_token == std::end(_tokens)) {
-			auto last_token = _tokens.back();
-			return Token{
-				.type     = Token::Type::SpecialEndOfFile,
-				.data     = Token::internal_name(Token::Type::SpecialEndOfFile),
-				.location = SourceLocation{ last_token.location.row,
-                                           static_cast<u32>(last_token.location.column + last_token.data.size()) }
-			};
-		}
-		return *_current_token;
-	}
+	Token Parser::current_token_or_default() const noexcept { return _tokens.current(); }
 
 }  // namespace soul::parser
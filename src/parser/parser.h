@@ -2,9 +2,12 @@
 
 #include "ast/ast.h"
 #include "ast/ast_fwd.h"
+#include "common/source_buffer.h"
+#include "common/symbol.h"
 #include "common/types/types_fwd.h"
 #include "core/types.h"
 #include "lexer/token.h"
+#include "lexer/token_stream.h"
 
 #include <span>
 #include <string_view>
@@ -22,9 +25,10 @@ namespace soul::parser
 		enum class Precedence : u8;
 
 		private:
-		std::span<const Token>           _tokens        = {};
-		std::span<const Token>::iterator _current_token = {};
-		std::string_view                 _module_name   = {};
+		lexer::TokenStream   _tokens;
+		std::string_view     _module_name          = {};
+		SourceBuffer::Handle _source               = {};
+		bool                 _is_symbol_table_full = false;  // See Parser::intern.
 
 		public:
 		/**
@@ -36,8 +40,33 @@ namespace soul::parser
 		[[nodiscard]] static ast::ASTNode::Dependency parse(std::string_view       module_name,
 		                                                    std::span<const Token> tokens);
 
+		/**
+		 * @brief Converts tokens stored in a TokenBuffer into an Abstract Syntax Tree (AST).
+		 * @param module_name Name of the module.
+		 * @param tokens Tokens to be parsed.
+		 * @return Module with parsed statements.
+		 */
+		[[nodiscard]] static ast::ASTNode::Dependency parse(std::string_view          module_name,
+		                                                    const lexer::TokenBuffer& tokens);
+
+		/**
+		 * @brief Converts a stream of tokens into an Abstract Syntax Tree (AST), consuming the tokens as they come.
+		 * @param module_name Name of the module.
+		 * @param tokens Stream of tokens to be parsed.
+		 * @return Module with parsed statements.
+		 */
+		[[nodiscard]] static ast::ASTNode::Dependency parse(std::string_view module_name, lexer::TokenStream tokens);
+
+		/**
+		 * @brief Lexes and parses a script in a single pass, converting it into an Abstract Syntax Tree (AST).
+		 * @param module_name Name of the module.
+		 * @param source Script to be parsed; the resulting module shares its ownership.
+		 * @return Module with parsed statements.
+		 */
+		[[nodiscard]] static ast::ASTNode::Dependency parse(std::string_view module_name, SourceBuffer::Handle source);
+
 		private:
-		Parser(std::string_view module_name, std::span<const Token> tokens);
+		Parser(std::string_view module_name, lexer::TokenStream tokens, SourceBuffer::Handle source = {});
 
 		ast::ASTNode::Dependency parse();
 		ast::ASTNode::Dependency parse_statement();
@@ -67,9 +96,16 @@ namespace soul::parser
 		 */
 		ast::ASTNode::Dependency create_error(ast::ErrorNode::Message error_message);
 
+		/**
+		 * @brief Interns the identifier of a node which is being built.
+		 * @details Identifiers are interned only once the parser needs them (i.e. not while lexing), thus only the
+		 * names which make it into the AST grow the (process-wide) table. If the table is full, an empty Symbol is
+		 * returned instead and the module is marked with an ErrorNode.
+		 */
+		Symbol intern(std::string_view identifier);
+
 		std::optional<Token> require(Token::Type type);
 		std::optional<Token> require(std::span<const Token::Type> types);
-		std::optional<Token> peek(std::ptrdiff_t n);
 		bool                 match(Token::Type type);
 
 		PrecedenceRule precedence_rule(Token::Type type) const noexcept;
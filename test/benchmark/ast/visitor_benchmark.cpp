@@ -0,0 +1,602 @@
+#include <benchmark/benchmark.h>
+
+#include "ast/ast_arena.h"
+#include "ast/flat_ast.h"
+#include "ast/visitors/compare.h"
+#include "ast/visitors/copy.h"
+#include "ast/visitors/default_traverse.h"
+#include "ast/visitors/desugar.h"
+#include "ast/visitors/error_collector.h"
+#include "ast/visitors/fused.h"
+#include "ast/visitors/serialize.h"
+#include "ast/visitors/static_traverse.h"
+#include "ast/visitors/statistics.h"
+#include "ast/visitors/stringify.h"
+#include "ast/visitors/type_discoverer.h"
+#include "ast/visitors/type_resolver.h"
+#include "parser/parser.h"
+#include "scripts.h"
+
+#include <concepts>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace soul::ast::visitors::benchmark
+{
+	using namespace soul::benchmark;
+
+	static void BM_VisitorPipeline(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		for (auto _ : state) {
+			DesugarVisitor desugar{};
+			desugar.accept(module.get());
+			auto desugar_root = desugar.cloned();
+
+			TypeDiscovererVisitor type_discoverer{};
+			type_discoverer.accept(desugar_root.get());
+			auto type_discoverer_root = type_discoverer.cloned();
+
+			TypeResolverVisitor type_resolver{ type_discoverer.discovered_types() };
+			type_resolver.accept(type_discoverer_root.get());
+			auto type_resolver_root = type_resolver.cloned();
+
+			ErrorCollectorVisitor error_collector{};
+			error_collector.accept(type_resolver_root.get());
+			::benchmark::DoNotOptimize(error_collector.is_valid());
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_VisitorPipeline)->Arg(1 << 12);
+
+	static void BM_VisitorPipeline_InPlace(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+			state.ResumeTiming();
+
+			DesugarVisitor desugar{};
+			desugar.accept(module);
+
+			TypeDiscovererVisitor type_discoverer{};
+			type_discoverer.accept(module);
+
+			TypeResolverVisitor type_resolver{ type_discoverer.discovered_types() };
+			type_resolver.accept(module);
+
+			ErrorCollectorVisitor error_collector{};
+			error_collector.accept(module.get());
+			::benchmark::DoNotOptimize(error_collector.is_valid());
+
+			state.PauseTiming();
+			module.reset();
+			state.ResumeTiming();
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_VisitorPipeline_InPlace)->Arg(1 << 12);
+
+	/**
+	 * @brief Renames every hundredth function declaration, thus modifies only a small part of the tree.
+	 */
+	class RenameFunctionVisitor final : public CopyVisitor
+	{
+		private:
+		std::size_t _count = 0;
+
+		public:
+		using CopyVisitor::CopyVisitor;
+
+		protected:
+		using CopyVisitor::visit;
+		void visit(const FunctionDeclarationNode& node) override
+		{
+			if (_count++ % 100 != 0) {
+				CopyVisitor::visit(node);
+				return;
+			}
+			auto parameters{ clone(node.parameters) };
+			auto statements{ clone(node.statements.get()) };
+			_current_clone = typed(FunctionDeclarationNode::create(std::string(node.name.view()) + "_renamed",
+			                                                       node.type_identifier,
+			                                                       std::move(parameters),
+			                                                       std::move(statements)),
+			                       node);
+		}
+	};
+
+	static void BM_Copy(::benchmark::State& state)
+	{
+		const auto script  = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module  = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		const auto options = state.range(1) ? CopyVisitor::Options::ShareUnchanged : CopyVisitor::Options::None;
+		for (auto _ : state) {
+			RenameFunctionVisitor rename{ options };
+			rename.accept(module.get());
+			auto result = rename.cloned();
+			::benchmark::DoNotOptimize(result.get());
+		}
+	}
+	BENCHMARK(BM_Copy)->Args({ 1 << 12, 0 })->Args({ 1 << 12, 1 });
+
+	static void BM_Compare(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		const auto other  = [&] {
+			if (state.range(1)) {
+				RenameFunctionVisitor rename{};
+				rename.accept(module.get());
+				return rename.cloned();
+			}
+			CopyVisitor copy{};
+			copy.accept(module.get());
+			return copy.cloned();
+		}();
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(static_cast<bool>(CompareVisitor(module.get(), other.get())));
+		}
+	}
+	BENCHMARK(BM_Compare)->Args({ 1 << 12, 0 })->Args({ 1 << 12, 1 });
+
+	/**
+	 * @brief Counts the literals in the tree, which touches every node.
+	 */
+	class LiteralCounterVisitor final : public DefaultTraverseVisitor
+	{
+		public:
+		std::size_t count = 0;
+
+		protected:
+		using DefaultTraverseVisitor::visit;
+		void visit(const LiteralNode&) override { ++count; }
+	};
+
+	static void BM_Traverse_Tree(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		for (auto _ : state) {
+			LiteralCounterVisitor counter{};
+			counter.accept(module.get());
+			::benchmark::DoNotOptimize(counter.count);
+		}
+	}
+	BENCHMARK(BM_Traverse_Tree)->Arg(1 << 14);
+
+	/**
+	 * @brief LiteralCounterVisitor, but dispatched at compile time.
+	 */
+	class StaticLiteralCounterVisitor final : public StaticTraverseVisitor<StaticLiteralCounterVisitor>
+	{
+		public:
+		std::size_t count = 0;
+
+		protected:
+		friend StaticTraverseVisitor;
+		using StaticTraverseVisitor::visit;
+		void visit(const LiteralNode&) { ++count; }
+	};
+
+	static void BM_Traverse_Static(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		for (auto _ : state) {
+			StaticLiteralCounterVisitor counter{};
+			counter.accept(module.get());
+			::benchmark::DoNotOptimize(counter.count);
+		}
+	}
+	BENCHMARK(BM_Traverse_Static)->Arg(1 << 14);
+
+	static ASTNode::Dependency parse_passes_script(std::size_t functions, bool is_erroneous)
+	{
+		const auto script = is_erroneous ? make_erroneous_script(functions) : make_dense_script(functions);
+		return parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+	}
+
+	/**
+	 * @brief ErrorCollectorVisitor (without the depth limit) on top of the virtually dispatched DefaultTraverseVisitor.
+	 */
+	class VirtualErrorCollectorVisitor final : public DefaultTraverseVisitor
+	{
+		public:
+		std::size_t                                           depth = 0;
+		std::vector<std::pair<std::size_t, const ErrorNode*>> errors{};
+
+		void accept(ASTNode::Reference node) override
+		{
+			if (!node) {
+				return;
+			}
+			++depth;
+			node->accept(*this);
+			--depth;
+		}
+
+		protected:
+		using DefaultTraverseVisitor::visit;
+		void visit(const ErrorNode& node) override { errors.emplace_back(depth, &node); }
+	};
+
+	static void BM_ErrorCollector_Virtual(::benchmark::State& state)
+	{
+		const auto module = parse_passes_script(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+		for (auto _ : state) {
+			VirtualErrorCollectorVisitor error_collector{};
+			error_collector.accept(module.get());
+			::benchmark::DoNotOptimize(error_collector.errors.empty());
+		}
+	}
+	BENCHMARK(BM_ErrorCollector_Virtual)->Args({ 1 << 14, 0 })->Args({ 1 << 14, 1 });
+
+	static void BM_ErrorCollector_Static(::benchmark::State& state)
+	{
+		const auto module = parse_passes_script(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+		// NOTE: Unlike the virtual one, the collector skips the subtrees without any errors, see ASTNode::has_errors,
+		// thus it does not traverse the valid tree at all.
+		for (auto _ : state) {
+			ErrorCollectorVisitor error_collector{};
+			error_collector.accept(module.get());
+			::benchmark::DoNotOptimize(error_collector.is_valid());
+		}
+	}
+	BENCHMARK(BM_ErrorCollector_Static)->Args({ 1 << 14, 0 })->Args({ 1 << 14, 1 });
+
+	static void BM_Passes_Separate(::benchmark::State& state)
+	{
+		const auto module = parse_passes_script(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+		for (auto _ : state) {
+			ErrorCollectorVisitor error_collector{};
+			error_collector.accept(module.get());
+
+			StatisticsVisitor statistics{};
+			statistics.accept(module.get());
+			::benchmark::DoNotOptimize(error_collector.errors().size() + statistics.depth());
+		}
+	}
+	BENCHMARK(BM_Passes_Separate)->Args({ 1 << 14, 0 })->Args({ 1 << 14, 1 });
+
+	static void BM_Passes_Fused(::benchmark::State& state)
+	{
+		const auto module = parse_passes_script(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+		for (auto _ : state) {
+			ErrorCollectorVisitor error_collector{};
+			StatisticsVisitor     statistics{};
+			FusedVisitor{ error_collector, statistics }.accept(module.get());
+			::benchmark::DoNotOptimize(error_collector.errors().size() + statistics.depth());
+		}
+	}
+	BENCHMARK(BM_Passes_Fused)->Args({ 1 << 14, 0 })->Args({ 1 << 14, 1 });
+
+	/**
+	 * @brief StringifyVisitor (with the types printed) on top of the virtually dispatched DefaultTraverseVisitor.
+	 * @note Replicates only the nodes of the dense script (see make_dense_script); the others are just traversed.
+	 */
+	class VirtualStringifyVisitor final : public DefaultTraverseVisitor
+	{
+		private:
+		static constexpr auto        k_unnamed       = "__unnamed__";
+		static constexpr std::size_t k_indent_amount = 2;
+
+		private:
+		std::string _buffer       = {};
+		std::size_t _indent_level = 0;
+
+		public:
+		std::string string() const { return _buffer; }
+
+		void accept(ASTNode::Reference node) override
+		{
+			if (!node) {
+				write("null");
+				return;
+			}
+			write("{");
+			_indent_level += k_indent_amount;
+			new_line();
+
+			node->accept(*this);
+
+			_indent_level -= k_indent_amount;
+			new_line();
+			write("}");
+		}
+
+		protected:
+		using DefaultTraverseVisitor::visit;
+
+		void visit(const BinaryNode& node) override
+		{
+			encode("node", "binary");
+			encode_type(node.type);
+			encode("operator", ASTNode::internal_name(node.op));
+			encode("lhs", node.lhs.get());
+			encode("rhs", node.rhs.get(), false);
+		}
+
+		void visit(const BlockNode& node) override
+		{
+			encode("node", "scope_block");
+			encode_type(node.type);
+			encode("statements", node.statements, false);
+		}
+
+		void visit(const FunctionDeclarationNode& node) override
+		{
+			encode("node", "function_declaration");
+			encode_type(node.type);
+			encode("name", node.name.view());
+			encode("type_identifier", node.type_identifier.view());
+			encode("parameters", node.parameters);
+			encode("statements", node.statements.get(), false);
+		}
+
+		void visit(const LiteralNode& node) override
+		{
+			encode("node", "literal");
+			encode_type(node.type);
+			encode("literal_type", LiteralNode::internal_name(node.literal_type));
+			write_key("value");
+			write("\"");
+			soul::format_to(std::back_inserter(_buffer), node.value);
+			write("\"");
+		}
+
+		void visit(const ModuleNode& node) override
+		{
+			encode("node", "module_declaration");
+			encode_type(node.type);
+			encode("name", node.name.view());
+			encode("statements", node.statements, false);
+		}
+
+		void visit(const ReturnNode& node) override
+		{
+			encode("node", "return");
+			encode_type(node.type);
+			encode("expression", node.expression.get(), false);
+		}
+
+		void visit(const VariableDeclarationNode& node) override
+		{
+			encode("node", "variable_declaration");
+			encode_type(node.type);
+			encode("name", node.name.view());
+			encode("type_identifier", node.type_identifier.view());
+			encode("is_mutable", node.is_mutable ? "true" : "false");
+			encode("expression", node.expression.get(), false);
+		}
+
+		private:
+		void write(std::string_view string) { _buffer.append(string); }
+
+		void write_key(std::string_view key) { std::format_to(std::back_inserter(_buffer), "\"{}\": ", key); }
+
+		void write_separator()
+		{
+			write(",");
+			new_line();
+		}
+
+		void new_line()
+		{
+			_buffer.push_back('\n');
+			_buffer.append(_indent_level, ' ');
+		}
+
+		void encode(std::string_view key, std::string_view value, bool add_trailing_comma = true)
+		{
+			write_key(key);
+			std::format_to(std::back_inserter(_buffer), "\"{}\"", !value.empty() ? value : k_unnamed);
+			if (add_trailing_comma) {
+				write_separator();
+			}
+		}
+
+		void encode_type(const types::Type& type)
+		{
+			write_key("type");
+			write("\"");
+			types::format_to(std::back_inserter(_buffer), type);
+			write("\"");
+			write_separator();
+		}
+
+		void encode(std::string_view key, ASTNode::Reference node, bool add_trailing_comma = true)
+		{
+			write_key(key);
+			accept(node);
+			if (add_trailing_comma) {
+				write_separator();
+			}
+		}
+
+		void encode(std::string_view key, const ASTNode::Dependencies& nodes, bool add_trailing_comma = true)
+		{
+			write_key(key);
+			if (nodes.empty()) {
+				write("[]");
+			} else {
+				write("[");
+				_indent_level += k_indent_amount;
+				new_line();
+				for (std::size_t index = 0; index < nodes.size(); ++index) {
+					accept(nodes[index].get());
+					if (index != nodes.size() - 1) {
+						write_separator();
+					}
+				}
+				_indent_level -= k_indent_amount;
+				new_line();
+				write("]");
+			}
+			if (add_trailing_comma) {
+				write_separator();
+			}
+		}
+	};
+
+	static void BM_Stringify_Virtual(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		{
+			// NOTE: Both of the visitors must produce the very same representation, i.e. do the same work.
+			VirtualStringifyVisitor virtual_stringify{};
+			virtual_stringify.accept(module.get());
+			StringifyVisitor stringify{ StringifyVisitor::Options::PrintTypes };
+			stringify.accept(module.get());
+			if (virtual_stringify.string() != stringify.string()) {
+				state.SkipWithError("representation differs from StringifyVisitor's");
+				return;
+			}
+		}
+		for (auto _ : state) {
+			VirtualStringifyVisitor stringify{};
+			stringify.accept(module.get());
+			::benchmark::DoNotOptimize(stringify.string());
+		}
+	}
+	BENCHMARK(BM_Stringify_Virtual)->Arg(1 << 10);
+
+	static void BM_Stringify(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		for (auto _ : state) {
+			StringifyVisitor stringify{ StringifyVisitor::Options::PrintTypes };
+			stringify.accept(module.get());
+			::benchmark::DoNotOptimize(stringify.string());
+		}
+	}
+	BENCHMARK(BM_Stringify)->Arg(1 << 10);
+
+	static void BM_Stringify_Sink(::benchmark::State& state)
+	{
+		const auto script  = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module  = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		const auto options = static_cast<StringifyVisitor::Options>(
+			StringifyVisitor::Options::PrintTypes | (state.range(1) ? StringifyVisitor::Options::Compact : 0));
+		std::size_t bytes = 0;
+		for (auto _ : state) {
+			StringifyVisitor stringify{ [&](std::string_view chunk) { return (bytes += chunk.size()) != 0; }, options };
+			stringify.accept(module.get());
+		}
+		state.SetBytesProcessed(static_cast<i64>(bytes));
+	}
+	BENCHMARK(BM_Stringify_Sink)->Args({ 1 << 10, 0 })->Args({ 1 << 10, 1 });
+
+	/**
+	 * @brief LiteralCounterVisitor, but over the FlatAST: dispatches on the kind of each node (reading its fields) and
+	 * recurses into its dependencies.
+	 */
+	class FlatLiteralCounter
+	{
+		public:
+		std::size_t count = 0;
+
+		void accept(const FlatAST& flat, FlatIndex index)
+		{
+			flat.visit(index, [&]<NodeKind Node>(FlatIndex, const FlatNode<Node>& node) {
+				if constexpr (std::same_as<Node, LiteralNode>) {
+					count += node.literal_type != LiteralNode::Type::Unknown;
+				}
+			});
+			flat.for_each_child(index, [&](FlatIndex child) { accept(flat, child); });
+		}
+	};
+
+	static void BM_Traverse_Flat(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		const auto flat   = FlatAST::from_tree(module.get());
+		for (auto _ : state) {
+			FlatLiteralCounter counter{};
+			counter.accept(flat, flat.root());
+			::benchmark::DoNotOptimize(counter.count);
+		}
+		state.counters["nodes"] = static_cast<double>(flat.size());
+	}
+	BENCHMARK(BM_Traverse_Flat)->Arg(1 << 14);
+
+	static void BM_Traverse_Flat_Kinds(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		const auto flat   = FlatAST::from_tree(module.get());
+		// NOTE: Lower bound of the flat traversal, i.e. a linear scan over the kinds, which does not read the nodes.
+		for (auto _ : state) {
+			std::size_t count = 0;
+			for (FlatIndex index = 0; index < flat.size(); ++index) {
+				count += flat.kind(index) == ASTNode::Kind::LiteralNode;
+			}
+			::benchmark::DoNotOptimize(count);
+		}
+		state.counters["nodes"] = static_cast<double>(flat.size());
+	}
+	BENCHMARK(BM_Traverse_Flat_Kinds)->Arg(1 << 14);
+
+	static void BM_FlatAST_FromTree(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto arena  = std::make_shared<ASTArena>();
+		const auto module = [&] {
+			ASTArena::Scope arena_scope{ arena };
+			return parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		}();
+		for (auto _ : state) {
+			auto flat = FlatAST::from_tree(module.get());
+			::benchmark::DoNotOptimize(flat.size());
+		}
+
+		// NOTE: Arena holds exactly the nodes of the tree and their lists of dependencies, i.e. its footprint without
+		// the per-allocation overhead of the heap.
+		const auto flat                       = FlatAST::from_tree(module.get());
+		const auto nodes                      = static_cast<double>(flat.size());
+		state.counters["nodes"]               = nodes;
+		state.counters["tree_bytes_per_node"] = static_cast<double>(arena->allocated()) / nodes;
+		state.counters["flat_bytes_per_node"] = static_cast<double>(flat.allocated()) / nodes;
+	}
+	BENCHMARK(BM_FlatAST_FromTree)->Arg(1 << 14);
+
+	static void BM_Serialize(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+		for (auto _ : state) {
+			SerializeVisitor serialize{};
+			serialize.accept(module.get());
+			::benchmark::DoNotOptimize(serialize.bytes());
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_Serialize)->Arg(1 << 12);
+
+	static void BM_Deserialize(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto module = parser::Parser::parse("benchmark", lexer::TokenStream{ script });
+
+		SerializeVisitor serialize{};
+		serialize.accept(module.get());
+		for (auto _ : state) {
+			auto result = SerializeVisitor::deserialize(serialize.bytes());
+			::benchmark::DoNotOptimize(result.get());
+		}
+		// NOTE: Bytes of the script (not of its binary representation), so the result is comparable with parsing.
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+		state.counters["bytes"] = static_cast<double>(serialize.bytes().size());
+	}
+	BENCHMARK(BM_Deserialize)->Arg(1 << 12);
+}  // namespace soul::ast::visitors::benchmark
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "lexer/lexer.h"
+#include "lexer/line_index.h"
+#include "lexer/token_buffer.h"
+#include "scripts.h"
+
+namespace soul::lexer::benchmark
+{
+	using namespace soul::benchmark;
+
+	static void BM_Tokenize_CommentHeavy(::benchmark::State& state)
+	{
+		const auto script = make_comment_heavy_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::tokenize(script));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_Tokenize_CommentHeavy)->Arg(1 << 10);
+
+	static void BM_Tokenize_Dense(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::tokenize(script));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_Tokenize_Dense)->Arg(1 << 10);
+
+	static void BM_Tokenize_IdentifierDense(::benchmark::State& state)
+	{
+		const auto script = make_identifier_dense_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::tokenize(script));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_Tokenize_IdentifierDense)->Arg(1 << 12);
+
+	static void BM_Tokenize_Localized(::benchmark::State& state)
+	{
+		const auto script = make_localized_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::tokenize(script));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_Tokenize_Localized)->Arg(1 << 10);
+
+	static void BM_TokenBuffer_Tokenize_Dense(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(TokenBuffer::tokenize(script));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_TokenBuffer_Tokenize_Dense)->Arg(1 << 10);
+
+	static void BM_LineIndex_CommentHeavy(::benchmark::State& state)
+	{
+		const auto script = make_comment_heavy_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(LineIndex{ script });
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_LineIndex_CommentHeavy)->Arg(1 << 10);
+
+	static void BM_Relex_Dense(::benchmark::State& state)
+	{
+		// Types a single character in the middle of the script, which is what an editor does on every keystroke.
+		auto           script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto     tokens = Lexer::tokenize(script);
+		const auto     offset = static_cast<u32>(script.find("result", script.size() / 2));
+		const TextEdit edit{ .offset = offset, .length = 0, .replacement = "x" };
+		script.insert(edit.offset, edit.replacement);
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::relex(tokens, script, edit));
+		}
+	}
+	BENCHMARK(BM_Relex_Dense)->Arg(1 << 10)->Arg(1 << 14);
+
+	static void BM_TokenizeParallel(::benchmark::State& state)
+	{
+		static const auto k_script = make_comment_heavy_script(1 << 14) + make_dense_script(1 << 17);
+		const auto thread_count = static_cast<std::size_t>(state.range(0));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Lexer::tokenize_parallel(k_script, thread_count));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * k_script.size()));
+	}
+	BENCHMARK(BM_TokenizeParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(::benchmark::kMillisecond)->UseRealTime();
+}  // namespace soul::lexer::benchmark
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "lexer/lexer.h"
+#include "lexer/token_buffer.h"
+#include "parser/parser.h"
+#include "scripts.h"
+
+namespace soul::parser::benchmark
+{
+	using namespace soul::benchmark;
+	using namespace soul::lexer;
+
+	static void BM_Parse_TokenVector(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto tokens = Lexer::tokenize(script);
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Parser::parse("benchmark", tokens));
+		}
+		state.counters["token_bytes"] = static_cast<double>(tokens.size() * sizeof(Token));
+	}
+	BENCHMARK(BM_Parse_TokenVector)->Arg(1 << 12);
+
+	static void BM_Parse_TokenBuffer(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		const auto tokens = TokenBuffer::tokenize(script);
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Parser::parse("benchmark", tokens));
+		}
+		state.counters["token_bytes"] = static_cast<double>(
+			tokens.size() * (sizeof(decltype(tokens.types())::value_type) + sizeof(TokenBuffer::Span)));
+	}
+	BENCHMARK(BM_Parse_TokenBuffer)->Arg(1 << 12);
+
+	static void BM_LexAndParse_Streaming(::benchmark::State& state)
+	{
+		const auto script = make_dense_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Parser::parse("benchmark", TokenStream{ script }));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_LexAndParse_Streaming)->Arg(1 << 12);
+
+	static void BM_LexAndParse_ConstantTable(::benchmark::State& state)
+	{
+		const auto script = make_constant_table_script(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			::benchmark::DoNotOptimize(Parser::parse("benchmark", TokenStream{ script }));
+		}
+		state.SetBytesProcessed(static_cast<i64>(state.iterations() * script.size()));
+	}
+	BENCHMARK(BM_LexAndParse_ConstantTable)->Arg(1 << 12);
+}  // namespace soul::parser::benchmark
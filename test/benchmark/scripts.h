@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+namespace soul::benchmark
+{
+	/**
+	 * @brief Generates a script, where most of the input consists of comments and indentation.
+	 */
+	inline std::string make_comment_heavy_script(std::size_t functions)
+	{
+		std::string result;
+		for (std::size_t index = 0; index < functions; ++index) {
+			result += "#" + std::string(79, '=') + "\n";
+			result += "# Function number " + std::to_string(index) + " does something very important, which\n";
+			result += "# is described here in great detail, spanning multiple lines of text.\n";
+			result += "#" + std::string(79, '=') + "\n";
+			result += "fn function_" + std::to_string(index) + "(a: i32, b: i32) :: i32\n{\n";
+			result += "\t\t\t\t# Indented comment explaining the line below.\n";
+			result += "\t\t\t\tlet result: i32 = a + b;\n";
+			result += "\t\t\t\treturn result;" + std::string(40, ' ') + "# Trailing comment.\n";
+			result += "}\n\n\n";
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Generates a script without any comments and with minimal whitespace.
+	 */
+	inline std::string make_dense_script(std::size_t functions)
+	{
+		std::string result;
+		for (std::size_t index = 0; index < functions; ++index) {
+			result += "fn function_" + std::to_string(index)
+			        + "(a: i32, b: i32) :: i32 {\nlet result: i32 = a + b;\nreturn result;\n}\n";
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Generates a dense script (see make_dense_script), where every function contains an (syntax) error.
+	 */
+	inline std::string make_erroneous_script(std::size_t functions)
+	{
+		std::string result;
+		for (std::size_t index = 0; index < functions; ++index) {
+			result += "fn function_" + std::to_string(index)
+			        + "(a: i32, b: i32) :: i32 {\nlet result: i32 = a + b;\nlet error: i32 = a +;\nreturn result;\n}\n";
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Generates a script consisting mostly of identifiers, keywords and primitive types.
+	 */
+	inline std::string make_identifier_dense_script(std::size_t statements)
+	{
+		static constexpr std::array k_words = {
+			"let",    "mut",    "counter", "i32",  "value", "if",     "else",  "return", "native", "struct",
+			"result", "str",    "while",   "true", "false", "buffer", "index", "fn",     "bool",   "length",
+		};
+		std::string result;
+		for (std::size_t index = 0; index < statements; ++index) {
+			for (std::size_t word = 0; word < 8; ++word) {
+				result += k_words[(index * 7 + word * 3) % k_words.size()];
+				result += ' ';
+			}
+			result += "identifier_" + std::to_string(index) + "\n";
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Generates a script, which is mostly ASCII with a few (localized) Unicode string literals.
+	 */
+	inline std::string make_localized_script(std::size_t functions)
+	{
+		std::string result;
+		for (std::size_t index = 0; index < functions; ++index) {
+			result += "fn function_" + std::to_string(index) + "(a: i32, b: i32) :: str\n{\n";
+			result += "\tlet message: str = \"Zażółć gęślą jaźń, numer " + std::to_string(index) + "\";\n";
+			result += "\tlet greeting: str = \"Hello, world! This one is plain ASCII text.\";\n";
+			result += "\treturn message;\n}\n";
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Generates a script consisting of numeric constants only, i.e. a large (data) table.
+	 */
+	inline std::string make_constant_table_script(std::size_t rows)
+	{
+		std::string result;
+		for (std::size_t index = 0; index < rows; ++index) {
+			result += "let integer_" + std::to_string(index) + ": i64 = " + std::to_string(index * 7919 + 104729)
+			        + ";\nlet float_" + std::to_string(index) + ": f64 = -" + std::to_string(index) + ".0625;\n";
+		}
+		return result;
+	}
+}  // namespace soul::benchmark
@@ -0,0 +1,88 @@
+#include "ast/ast_arena.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/compare.h"
+#include "ast/visitors/copy.h"
+#include "fixtures.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace soul::ast::ut
+{
+	class ASTArenaTest : public soul::ut::ModuleFixture
+	{
+	};
+
+	TEST_F(ASTArenaTest, Allocate_IsAligned)
+	{
+		ASTArena arena{};
+		for (const std::size_t alignment : { 1, 2, 4, 8, 16, 32 }) {
+			std::ignore       = arena.allocate(1, 1);
+			const auto* bytes = arena.allocate(alignment * 3, alignment);
+			EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bytes) % alignment, 0) << "alignment: " << alignment;
+		}
+
+		const auto* large = arena.allocate(ASTArena::k_chunk_size * 2, 8);
+		EXPECT_NE(large, nullptr);
+		EXPECT_GE(arena.allocated(), ASTArena::k_chunk_size * 2);
+	}
+
+	TEST_F(ASTArenaTest, Scope_SelectsArena)
+	{
+		EXPECT_EQ(ASTArena::current(), nullptr);
+		auto outer = std::make_shared<ASTArena>();
+		auto inner = std::make_shared<ASTArena>();
+		{
+			ASTArena::Scope outer_scope{ outer };
+			EXPECT_EQ(ASTArena::current(), outer);
+			{
+				ASTArena::Scope inner_scope{ inner };
+				EXPECT_EQ(ASTArena::current(), inner);
+			}
+			EXPECT_EQ(ASTArena::current(), outer);
+		}
+		EXPECT_EQ(ASTArena::current(), nullptr);
+
+		const auto heap_node = LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean);
+		EXPECT_FALSE(heap_node->is_arena_allocated());
+	}
+
+	TEST_F(ASTArenaTest, Parse_AllocatesFromArena)
+	{
+		const auto expected = parse();
+
+		auto                arena  = std::make_shared<ASTArena>();
+		std::weak_ptr       handle = arena;
+		ASTNode::Dependency result = nullptr;
+		{
+			ASTArena::Scope arena_scope{ std::move(arena) };
+			result = parse();
+		}
+		ASSERT_TRUE(result);
+		EXPECT_FALSE(result->is_arena_allocated());
+		ASSERT_TRUE(result->is<ModuleNode>());
+
+		const auto& module = result->as<ModuleNode>();
+		EXPECT_EQ(module.arena, handle.lock());
+		EXPECT_GT(module.arena->node_count(), 0);
+		EXPECT_EQ(module.statements.get_allocator().arena(), module.arena.get());
+		for (const auto& statement : module.statements) {
+			EXPECT_TRUE(statement->is_arena_allocated());
+		}
+		EXPECT_TRUE(visitors::CompareVisitor(expected.get(), result.get()));
+
+		// Copies made outside of the scope are allocated on the heap, thus they outlive the arena.
+		visitors::CopyVisitor copy_visitor{};
+		copy_visitor.accept(result.get());
+		auto copy = copy_visitor.cloned();
+
+		result.reset();
+		EXPECT_TRUE(handle.expired());
+		ASSERT_TRUE(copy->is<ModuleNode>());
+		EXPECT_EQ(copy->as<ModuleNode>().arena, nullptr);
+		EXPECT_TRUE(visitors::CompareVisitor(expected.get(), copy.get()));
+	}
+}  // namespace soul::ast::ut
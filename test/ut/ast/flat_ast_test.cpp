@@ -0,0 +1,97 @@
+#include "ast/flat_ast.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/compare.h"
+#include "fixtures.h"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace soul::ast::ut
+{
+	using namespace soul::types;
+	using namespace std::string_view_literals;
+
+	class FlatASTTest : public soul::ut::ModuleFixture
+	{
+	};
+
+	TEST_F(FlatASTTest, RoundTrip)
+	{
+		auto       module = parse();
+		const auto source = module->as<ModuleNode>().source;
+		module->type      = Type{ PrimitiveType::Kind::Void };
+
+		const auto flat = FlatAST::from_tree(module.get());
+		ASSERT_FALSE(flat.empty());
+		EXPECT_EQ(flat.root(), 0);
+		EXPECT_TRUE(flat.is<ModuleNode>(flat.root()));
+		EXPECT_EQ(flat.as<ModuleNode>(flat.root()).name, "test_module");
+		EXPECT_EQ(flat.type(flat.root()), Type{ PrimitiveType::Kind::Void });
+		EXPECT_EQ(flat.source(), source);
+		EXPECT_EQ(flat.subtree_end(flat.root()), flat.size());
+		EXPECT_GE(flat.allocated(), flat.size() * (sizeof(ASTNode::Kind) + sizeof(Type)));
+
+		const auto result = flat.to_tree();
+		ASSERT_TRUE(result);
+		EXPECT_TRUE(visitors::CompareVisitor(module.get(), result.get()));
+		EXPECT_EQ(stringify(module.get()), stringify(result.get()));
+		EXPECT_EQ(result->as<ModuleNode>().source, source);
+	}
+
+	TEST_F(FlatASTTest, Traversal)
+	{
+		const auto module = parse();
+		const auto flat   = FlatAST::from_tree(module.get());
+
+		// Direct dependencies of the module are its statements.
+		std::vector<FlatIndex> children{};
+		flat.for_each_child(flat.root(), [&](FlatIndex child) { children.push_back(child); });
+		const auto statements = flat.children(flat.as<ModuleNode>(flat.root()).statements);
+		EXPECT_EQ(children, std::vector<FlatIndex>(std::begin(statements), std::end(statements)));
+		ASSERT_EQ(children.size(), 3);
+		EXPECT_TRUE(flat.is<StructDeclarationNode>(children[0]));
+		EXPECT_TRUE(flat.is<FunctionDeclarationNode>(children[1]));
+		EXPECT_TRUE(flat.is<FunctionDeclarationNode>(children[2]));
+		EXPECT_EQ(flat.subtree_end(children[1]), children[2]);
+		EXPECT_EQ(flat.subtree_end(children[2]), flat.size());
+
+		// Indices are in pre-order, thus every dependency follows its parent and lies within its subtree.
+		for (FlatIndex index = 0; index < flat.size(); ++index) {
+			flat.for_each_child(index, [&](FlatIndex child) {
+				EXPECT_GT(child, index);
+				EXPECT_LE(flat.subtree_end(child), flat.subtree_end(index));
+			});
+		}
+
+		// Nodes of a single kind are contiguous (and in pre-order as well).
+		const auto declarations = flat.nodes<VariableDeclarationNode>();
+		const std::vector<std::string_view> names{ "x", "y", "lhs", "rhs", "a", "sum", "i" };
+		ASSERT_EQ(declarations.size(), names.size());
+		for (std::size_t index = 0; index < names.size(); ++index) {
+			EXPECT_EQ(declarations[index].name.view(), names[index]);
+		}
+
+		const auto function = flat.visit(children[2], [](FlatIndex, const auto& fields) -> std::string_view {
+			if constexpr (std::is_same_v<std::remove_cvref_t<decltype(fields)>, FlatNode<FunctionDeclarationNode>>) {
+				return fields.name.view();
+			} else {
+				return {};
+			}
+		});
+		EXPECT_EQ(function, "main"sv);
+	}
+
+	TEST_F(FlatASTTest, Empty)
+	{
+		const auto flat = FlatAST::from_tree(nullptr);
+		EXPECT_TRUE(flat.empty());
+		EXPECT_EQ(flat.root(), k_flat_null);
+		EXPECT_EQ(flat.allocated(), 0);
+		EXPECT_FALSE(flat.to_tree());
+	}
+}  // namespace soul::ast::ut
@@ -0,0 +1,148 @@
+#include "ast/traversal.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/compare.h"
+#include "ast/visitors/copy.h"
+#include "ast/visitors/lower.h"
+#include "fixtures.h"
+
+#include <algorithm>
+#include <compare>
+#include <vector>
+
+namespace soul::ast::ut
+{
+	class TraversalTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		using RecorderVisitor = soul::ut::RecorderVisitor;
+
+		/** @brief Returns expression `((0 + 1) + 2) + ...` nested to a given depth. */
+		static ASTNode::Dependency make_deep_expression(std::size_t depth)
+		{
+			auto expression = LiteralNode::create(Value{ i64{ 0 } }, LiteralNode::Type::Int64);
+			for (std::size_t index = 1; index <= depth; ++index) {
+				auto literal = LiteralNode::create(Value{ static_cast<i64>(index) }, LiteralNode::Type::Int64);
+				expression   = BinaryNode::create(std::move(expression), std::move(literal), ASTNode::Operator::Add);
+			}
+			return expression;
+		}
+	};
+
+	TEST_F(TraversalTest, MatchesDefaultTraverseVisitor)
+	{
+		const auto module = parse();
+
+		RecorderVisitor recorder{};
+		recorder.accept(module.get());
+
+		std::vector<ASTNode::Kind> entered{};
+		std::vector<ASTNode::Kind> left{};
+		TraversalStack             traversal{};
+		traversal.traverse(
+			module.get(),
+			[&](ASTNode& node) { entered.push_back(node.kind()); },
+			[&](ASTNode& node) { left.push_back(node.kind()); });
+
+		EXPECT_GT(entered.size(), 1);
+		EXPECT_EQ(entered, recorder.kinds);
+		EXPECT_EQ(recorder.literals, std::ranges::count(entered, ASTNode::Kind::LiteralNode));
+		ASSERT_EQ(left.size(), entered.size());
+		EXPECT_EQ(left.back(), ASTNode::Kind::ModuleNode);
+		EXPECT_EQ(traversal.depth(), 0);
+	}
+
+	TEST_F(TraversalTest, SkipsDependencies)
+	{
+		const auto module = parse();
+
+		std::vector<ASTNode::Kind> entered{};
+		TraversalStack             traversal{};
+		traversal.traverse(module.get(), [&](ASTNode& node) {
+			entered.push_back(node.kind());
+			return !node.is<FunctionDeclarationNode>() && !node.is<StructDeclarationNode>();
+		});
+
+		const std::vector expected{ ASTNode::Kind::ModuleNode,
+			                        ASTNode::Kind::StructDeclarationNode,
+			                        ASTNode::Kind::FunctionDeclarationNode,
+			                        ASTNode::Kind::FunctionDeclarationNode };
+		EXPECT_EQ(entered, expected);
+	}
+
+	TEST_F(TraversalTest, Depth_OneMillion)
+	{
+		static constexpr std::size_t k_depth = 1'000'000;
+
+		auto statements = ASTNode::Dependencies{};
+		statements.push_back(make_deep_expression(k_depth));
+		const auto module = ModuleNode::create("traversal_module", std::move(statements));
+
+		std::size_t    entered   = 0;
+		std::size_t    left      = 0;
+		std::size_t    max_depth = 0;
+		TraversalStack traversal{};
+		traversal.traverse(
+			module.get(),
+			[&](ASTNode&) {
+				++entered;
+				max_depth = std::max(max_depth, traversal.depth());
+			},
+			[&](ASTNode&) { ++left; });
+		EXPECT_EQ(entered, 2 * k_depth + 2);
+		EXPECT_EQ(left, entered);
+		EXPECT_EQ(max_depth, k_depth + 1);
+
+		RecorderVisitor recorder{};
+		recorder.accept(module.get());
+		EXPECT_EQ(recorder.literals, k_depth + 1);
+		EXPECT_EQ(recorder.kinds.size(), entered);
+
+		// Visitors which return results (i.e. clones, orderings and instructions) do not recurse either.
+		const auto copy = [&] {
+			visitors::CopyVisitor copy_visitor{};
+			copy_visitor.accept(module.get());
+			return copy_visitor.cloned();
+		}();
+		ASSERT_TRUE(copy);
+		EXPECT_NE(copy.get(), module.get());
+		EXPECT_TRUE(visitors::CompareVisitor(module.get(), copy.get()));
+
+		// NOTE: Trees differ only in the deepest literal, thus these are compared along the whole depth.
+		auto different = [&] {
+			visitors::CopyVisitor copy_visitor{};
+			copy_visitor.accept(module.get());
+			return copy_visitor.cloned();
+		}();
+		auto* deepest = different->as<ModuleNode>().statements[0].get();
+		while (deepest->is<BinaryNode>()) {
+			deepest = deepest->as<BinaryNode>().lhs.get();
+		}
+		deepest->as<LiteralNode>().value = Value{ i64{ -1 } };
+		EXPECT_EQ(visitors::CompareVisitor(module.get(), different.get()), std::partial_ordering::greater);
+
+		auto function_statements = ASTNode::Dependencies{};
+		function_statements.push_back(
+			VariableDeclarationNode::create("sum", "i64", make_deep_expression(k_depth), false));
+		auto lower_statements = ASTNode::Dependencies{};
+		lower_statements.push_back(FunctionDeclarationNode::create(
+			"main", "i64", ASTNode::Dependencies{}, BlockNode::create(std::move(function_statements))));
+		const auto lower_module = ModuleNode::create("lower_module", std::move(lower_statements));
+
+		visitors::LowerVisitor lower_visitor{};
+		lower_visitor.accept(lower_module.get());
+		const auto ir = lower_visitor.get();
+		ASSERT_TRUE(ir);
+		ASSERT_EQ(ir->functions.size(), 1);
+		std::size_t adds = 0;
+		for (const auto& basic_block : ir->functions[0]->basic_blocks) {
+			adds += std::ranges::count_if(basic_block->instructions(),
+			                              [](const auto& instruction) { return instruction->template is<ir::Add>(); });
+		}
+		EXPECT_EQ(adds, k_depth);
+
+		// NOTE: Releasing the module releases the whole expression, which must not recurse either.
+	}
+}  // namespace soul::ast::ut
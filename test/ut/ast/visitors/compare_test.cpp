@@ -0,0 +1,135 @@
+#include "ast/visitors/compare.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/desugar.h"
+#include "fixtures.h"
+
+#include <compare>
+#include <string>
+#include <unordered_set>
+
+namespace soul::ast::visitors::ut
+{
+	using namespace std::string_view_literals;
+
+	class CompareVisitorTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		/** @brief Returns expression `((0 + 1) + 2) + ...` nested to a given depth. */
+		static ASTNode::Dependency make_deep_expression(std::size_t depth, i64 last)
+		{
+			auto expression = LiteralNode::create(Value{ i64{ 0 } }, LiteralNode::Type::Int64);
+			for (std::size_t index = 1; index < depth; ++index) {
+				auto literal = LiteralNode::create(Value{ static_cast<i64>(index) }, LiteralNode::Type::Int64);
+				expression   = BinaryNode::create(std::move(expression), std::move(literal), ASTNode::Operator::Add);
+			}
+			auto literal = LiteralNode::create(Value{ last }, LiteralNode::Type::Int64);
+			return BinaryNode::create(std::move(expression), std::move(literal), ASTNode::Operator::Add);
+		}
+	};
+
+	TEST_F(CompareVisitorTest, Hash_EqualTrees)
+	{
+		const auto lhs = parse();
+		const auto rhs = parse();
+
+		EXPECT_NE(lhs->hash(), 0);
+		EXPECT_EQ(lhs->hash(), rhs->hash());
+		EXPECT_TRUE(CompareVisitor(lhs.get(), rhs.get()));
+	}
+
+	TEST_F(CompareVisitorTest, Hash_DifferentTrees)
+	{
+		const auto lhs = parse();
+		const auto rhs = [] {
+			std::string script{ k_script };
+			script.replace(script.find("i < 10"), 6, "i < 11");
+			return parse(script);
+		}();
+
+		EXPECT_NE(lhs->hash(), rhs->hash());
+		EXPECT_FALSE(CompareVisitor(lhs.get(), rhs.get()));
+
+		// Unchanged declaration hashes the same in both of the trees.
+		const auto& lhs_statements = lhs->as<ModuleNode>().statements;
+		const auto& rhs_statements = rhs->as<ModuleNode>().statements;
+		ASSERT_EQ(lhs_statements.size(), 3);
+		ASSERT_EQ(rhs_statements.size(), 3);
+		EXPECT_EQ(lhs_statements[0]->hash(), rhs_statements[0]->hash());
+		EXPECT_EQ(lhs_statements[1]->hash(), rhs_statements[1]->hash());
+		EXPECT_NE(lhs_statements[2]->hash(), rhs_statements[2]->hash());
+	}
+
+	TEST_F(CompareVisitorTest, Hash_InvalidatedByRewrite)
+	{
+		auto       module   = parse();
+		const auto original = module->hash();
+
+		auto expected = [] {
+			const auto expected_module = parse();
+
+			DesugarVisitor desugar_visitor{};
+			desugar_visitor.accept(expected_module.get());
+			return desugar_visitor.cloned();
+		}();
+
+		DesugarVisitor desugar_visitor{};
+		desugar_visitor.accept(module);
+
+		EXPECT_NE(module->hash(), original);
+		EXPECT_EQ(module->hash(), expected->hash());
+		EXPECT_TRUE(CompareVisitor(expected.get(), module.get()));
+	}
+
+	TEST_F(CompareVisitorTest, Hash_DeepTree)
+	{
+		static constexpr std::size_t k_depth = 100'000;
+
+		const auto lhs       = make_deep_expression(k_depth, 1);
+		const auto rhs       = make_deep_expression(k_depth, 1);
+		const auto different = make_deep_expression(k_depth, 2);
+
+		EXPECT_EQ(lhs->hash(), rhs->hash());
+		EXPECT_NE(lhs->hash(), different->hash());
+		EXPECT_FALSE(CompareVisitor(lhs.get(), different.get()));
+	}
+
+	TEST_F(CompareVisitorTest, Ordering_IgnoresStaleHashes)
+	{
+		auto lhs = [] {
+			std::string script{ k_script };
+			script.replace(script.find("return 123"), 10, "return 321");
+			return parse(script);
+		}();
+		const auto rhs = parse();
+		ASSERT_NE(lhs->hash(), rhs->hash());
+		EXPECT_EQ(CompareVisitor(lhs.get(), rhs.get()), std::partial_ordering::greater);
+		EXPECT_EQ(CompareVisitor(rhs.get(), lhs.get()), std::partial_ordering::less);
+
+		// NOTE: Literal is modified without invalidating the hashes of its ancestors, thus these are stale.
+		auto& body    = lhs->as<ModuleNode>().statements.back()->as<FunctionDeclarationNode>().statements;
+		auto& literal = body->as<BlockNode>().statements.back()->as<ReturnNode>().expression->as<LiteralNode>();
+		literal.value = Value{ i64{ 123 } };
+		ASSERT_NE(lhs->hash(), rhs->hash());
+
+		EXPECT_TRUE(CompareVisitor(lhs.get(), rhs.get()));
+		EXPECT_EQ(CompareVisitor(lhs.get(), rhs.get()), std::partial_ordering::equivalent);
+	}
+
+	TEST_F(CompareVisitorTest, StructuralHash_DeduplicatesSubtrees)
+	{
+		const auto module = parse(R"(
+			struct point { x: f64, y: f64 }
+			struct point { x: f64, y: f64 }
+			struct point { x: f64, z: f64 }
+		)"sv);
+
+		std::unordered_set<ASTNode::Reference, StructuralHash, StructuralEqual> unique{};
+		for (const auto& statement : module->as<ModuleNode>().statements) {
+			unique.insert(statement.get());
+		}
+		EXPECT_EQ(unique.size(), 2);
+	}
+}  // namespace soul::ast::visitors::ut
@@ -5,15 +5,43 @@
 #include "ast/ast.h"
 #include "ast/visitors/compare.h"
 #include "ast/visitors/stringify.h"
+#include "fixtures.h"
 
-#include <string>
+#include <memory>
 
 namespace soul::ast::visitors
 {
 	using namespace soul::ast;
 
-	class CopyVisitorTest : public ::testing::Test
+	class CopyVisitorTest : public soul::ut::ModuleFixture
 	{
+		protected:
+		/**
+		 * @brief Replaces the integer literals of a given value (and nothing else).
+		 */
+		class ReplaceLiteralVisitor final : public CopyVisitor
+		{
+			private:
+			i64 _from;
+			i64 _to;
+
+			public:
+			ReplaceLiteralVisitor(i64 from, i64 to)
+				: CopyVisitor(CopyVisitor::Options::ShareUnchanged), _from(from), _to(to)
+			{
+			}
+
+			protected:
+			using CopyVisitor::visit;
+			void visit(const LiteralNode& node) override
+			{
+				if (node.literal_type == LiteralNode::Type::Int32 && node.value == Value{ _from }) {
+					_current_clone = typed(LiteralNode::create(Value{ _to }, node.literal_type), node);
+					return;
+				}
+				CopyVisitor::visit(node);
+			}
+		};
 	};
 
 	TEST_F(CopyVisitorTest, All)
@@ -26,11 +54,13 @@ namespace soul::ast::visitors
 		auto struct_declaration = StructDeclarationNode::create("my_struct", std::move(struct_declaration_members));
 
 		auto if_node_true_statements = ASTNode::Dependencies{};
-		if_node_true_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Decrement));
+		if_node_true_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Decrement));
 		auto if_node_false_statements = ASTNode::Dependencies{};
-		if_node_false_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Increment));
+		if_node_false_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Increment));
 
 		auto if_node = IfNode::create(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean),
 		                              BlockNode::create(std::move(if_node_true_statements)),
@@ -39,11 +69,12 @@ namespace soul::ast::visitors
 		auto for_loop_initialization = VariableDeclarationNode::create(
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), false);
 		auto for_loop_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
 		                         ASTNode::Operator::LessEqual);
-		auto for_loop_update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                         ASTNode::Operator::Increment);
+		auto for_loop_update
+			= UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                        ASTNode::Operator::Increment);
 		auto for_loop_statements = ASTNode::Dependencies{};
 		for_loop_statements.push_back(std::move(if_node));
 
@@ -80,4 +111,87 @@ namespace soul::ast::visitors
 		const auto& result_module = copy_visitor.cloned();
 		ASSERT_TRUE(CompareVisitor(expected_module.get(), result_module.get()));
 	}
+
+	TEST_F(CopyVisitorTest, ShareUnchanged_CopiesOnlyModifiedPaths)
+	{
+		auto       input    = parse();
+		const auto original = parse();
+
+		ReplaceLiteralVisitor replace_visitor{ 123, 321 };
+		replace_visitor.accept(input.get());
+		auto result = replace_visitor.cloned();
+		ASSERT_TRUE(result);
+
+		// Input is left intact...
+		EXPECT_TRUE(CompareVisitor(original.get(), input.get()));
+
+		// ...while nodes on the path from the replaced literal to the root are copied, and the rest is shared.
+		const auto& input_statements  = input->as<ModuleNode>().statements;
+		const auto& result_statements = result->as<ModuleNode>().statements;
+		ASSERT_EQ(result_statements.size(), input_statements.size());
+		EXPECT_NE(result.get(), input.get());
+		EXPECT_EQ(result_statements[0].get(), input_statements[0].get());
+		EXPECT_TRUE(result_statements[0]->is_shared());
+		EXPECT_EQ(result_statements[1].get(), input_statements[1].get());
+		EXPECT_NE(result_statements[2].get(), input_statements[2].get());
+
+		const auto& input_function  = input_statements[2]->as<FunctionDeclarationNode>();
+		const auto& result_function = result_statements[2]->as<FunctionDeclarationNode>();
+		const auto& input_body      = input_function.statements->as<BlockNode>().statements;
+		const auto& result_body     = result_function.statements->as<BlockNode>().statements;
+		ASSERT_EQ(result_body.size(), 5);
+		for (std::size_t index = 0; index < 4; ++index) {
+			EXPECT_EQ(result_body[index].get(), input_body[index].get());
+		}
+		EXPECT_NE(result_body[4].get(), input_body[4].get());
+		EXPECT_EQ(result_body[4]->as<ReturnNode>().expression->as<LiteralNode>().value, Value{ i64{ 321 } });
+
+		// Shared nodes outlive the input tree.
+		const auto expected = [&] {
+			CopyVisitor copy_visitor{};
+			copy_visitor.accept(result.get());
+			return copy_visitor.cloned();
+		}();
+		input.reset();
+		EXPECT_FALSE(result_statements[0]->is_shared());
+		EXPECT_TRUE(CompareVisitor(expected.get(), result.get()));
+	}
+
+	TEST_F(CopyVisitorTest, ShareUnchanged_SharesUnmodifiedTree)
+	{
+		const auto input = parse();
+
+		CopyVisitor copy_visitor{ CopyVisitor::Options::ShareUnchanged };
+		copy_visitor.accept(input.get());
+		const auto result = copy_visitor.cloned();
+		EXPECT_EQ(result.get(), input.get());
+		EXPECT_TRUE(input->is_shared());
+	}
+
+	TEST_F(CopyVisitorTest, ShareUnchanged_RetainsArena)
+	{
+		const auto expected = parse();
+
+		auto arena = std::make_shared<ASTArena>();
+		auto input = [&] {
+			ASTArena::Scope arena_scope{ arena };
+			return parse();
+		}();
+		std::weak_ptr handle = arena;
+		arena.reset();
+
+		ReplaceLiteralVisitor replace_visitor{ 123, 321 };
+		replace_visitor.accept(input.get());
+		auto result = replace_visitor.cloned();
+		ASSERT_TRUE(result);
+		EXPECT_EQ(result->as<ModuleNode>().arena, handle.lock());
+
+		// Shared statements are owned by the arena of the input module, thus it is kept alive by the result.
+		input.reset();
+		EXPECT_FALSE(handle.expired());
+
+		ReplaceLiteralVisitor restore_visitor{ 321, 123 };
+		restore_visitor.accept(result.get());
+		EXPECT_TRUE(CompareVisitor(expected.get(), restore_visitor.cloned().get()));
+	}
 }  // namespace soul::ast::visitors
@@ -120,6 +120,12 @@ namespace soul::ast::visitors::ut
 		ASSERT_TRUE(expected_module);
 
 		verify(expected_module.get(), result_module.get());
+
+		// Target is shared (instead of being copied) by both sides of the assignment.
+		for (const auto& statement : result_module->as<ModuleNode>().statements) {
+			const auto& assignment = statement->as<BinaryNode>();
+			EXPECT_EQ(assignment.lhs.get(), assignment.rhs->as<BinaryNode>().lhs.get());
+		}
 	}
 
 	TEST_F(DesugarVisitorTest, ForLoop)
@@ -129,12 +135,13 @@ namespace soul::ast::visitors::ut
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), true);
 
 		auto for_loop_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
 		                         ASTNode::Operator::Less);
 
-		auto for_loop_update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                         ASTNode::Operator::Increment);
+		auto for_loop_update
+			= UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                        ASTNode::Operator::Increment);
 
 		auto for_loop_statements = ASTNode::Dependencies{};
 		for_loop_statements.push_back(VariableDeclarationNode::create(
@@ -157,7 +164,7 @@ namespace soul::ast::visitors::ut
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), true);
 
 		auto while_node_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
 		                         ASTNode::Operator::Less);
 
@@ -165,8 +172,9 @@ namespace soul::ast::visitors::ut
 		while_node_statements.reserve(2);
 		while_node_statements.push_back(VariableDeclarationNode::create(
 			"inner", "f32", LiteralNode::create(Value{ 3.14 }, LiteralNode::Type::Float32), false));
-		while_node_statements.push_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Increment));
+		while_node_statements.push_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Increment));
 
 		auto while_node
 			= WhileNode::create(std::move(while_node_condition), BlockNode::create(std::move(while_node_statements)));
@@ -3,11 +3,38 @@
 #include <gtest/gtest.h>
 
 #include "ast/ast.h"
+#include "ast/visitors/rewrite.h"
+#include "ast/visitors/type_discoverer.h"
+#include "ast/visitors/type_resolver.h"
+#include "common/source_buffer.h"
+#include "parser/parser.h"
+
+#include <string>
+#include <string_view>
 
 namespace soul::ast::visitors::ut
 {
+	using namespace std::string_view_literals;
+
 	class ErrorCollectorTest : public ::testing::Test
 	{
+		protected:
+		/**
+		 * @brief Replaces each ErrorNode with a literal.
+		 */
+		class FixErrorsVisitor final : public RewriteVisitor
+		{
+			protected:
+			using RewriteVisitor::visit;
+			void visit(ErrorNode&) override { replace(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean)); }
+		};
+
+		static std::size_t collect_errors(ASTNode::Reference root)
+		{
+			ErrorCollectorVisitor error_collector{};
+			error_collector.accept(root);
+			return error_collector.errors().size();
+		}
 	};
 
 	TEST_F(ErrorCollectorTest, NothingToCollect)
@@ -20,11 +47,13 @@ namespace soul::ast::visitors::ut
 		auto struct_declaration = StructDeclarationNode::create("my_struct", std::move(struct_declaration_members));
 
 		auto if_node_true_statements = ASTNode::Dependencies{};
-		if_node_true_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Decrement));
+		if_node_true_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Decrement));
 		auto if_node_false_statements = ASTNode::Dependencies{};
-		if_node_false_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Increment));
+		if_node_false_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Increment));
 
 		auto if_node = IfNode::create(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean),
 		                              BlockNode::create(std::move(if_node_true_statements)),
@@ -33,11 +62,12 @@ namespace soul::ast::visitors::ut
 		auto for_loop_initialization = VariableDeclarationNode::create(
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), false);
 		auto for_loop_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
 		                         ASTNode::Operator::LessEqual);
-		auto for_loop_update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                         ASTNode::Operator::Increment);
+		auto for_loop_update
+			= UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                        ASTNode::Operator::Increment);
 		auto for_loop_statements = ASTNode::Dependencies{};
 		for_loop_statements.push_back(std::move(if_node));
 
@@ -80,8 +110,9 @@ namespace soul::ast::visitors::ut
 		auto struct_declaration = StructDeclarationNode::create("my_struct", std::move(struct_declaration_members));
 
 		auto if_node_true_statements = ASTNode::Dependencies{};
-		if_node_true_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Decrement));
+		if_node_true_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Decrement));
 		auto if_node_false_statements = ASTNode::Dependencies{};
 		if_node_false_statements.emplace_back(
 			UnaryNode::create(ErrorNode::create("if_false_unary_expr_error"), ASTNode::Operator::Increment));
@@ -93,11 +124,12 @@ namespace soul::ast::visitors::ut
 		auto for_loop_initialization = VariableDeclarationNode::create(
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), false);
 		auto for_loop_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         ErrorNode::create("for_loop_condition_binary_rhs_expr_error"),
 		                         ASTNode::Operator::LessEqual);
-		auto for_loop_update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                         ASTNode::Operator::Increment);
+		auto for_loop_update
+			= UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                        ASTNode::Operator::Increment);
 		auto for_loop_statements = ASTNode::Dependencies{};
 		for_loop_statements.push_back(std::move(if_node));
 
@@ -156,8 +188,9 @@ namespace soul::ast::visitors::ut
 		auto struct_declaration = StructDeclarationNode::create("my_struct", std::move(struct_declaration_members));
 
 		auto if_node_true_statements = ASTNode::Dependencies{};
-		if_node_true_statements.emplace_back(UnaryNode::create(
-			LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier), ASTNode::Operator::Decrement));
+		if_node_true_statements.emplace_back(
+			UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                      ASTNode::Operator::Decrement));
 		auto if_node_false_statements = ASTNode::Dependencies{};
 		if_node_false_statements.emplace_back(
 			UnaryNode::create(ErrorNode::create("if_false_unary_expr_error"), ASTNode::Operator::Increment));
@@ -169,11 +202,12 @@ namespace soul::ast::visitors::ut
 		auto for_loop_initialization = VariableDeclarationNode::create(
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), false);
 		auto for_loop_condition
-			= BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                         ErrorNode::create("for_loop_condition_binary_rhs_expr_error"),
 		                         ASTNode::Operator::LessEqual);
-		auto for_loop_update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                         ASTNode::Operator::Increment);
+		auto for_loop_update
+			= UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                        ASTNode::Operator::Increment);
 		auto for_loop_statements = ASTNode::Dependencies{};
 		for_loop_statements.push_back(std::move(if_node));
 
@@ -224,4 +258,83 @@ namespace soul::ast::visitors::ut
 		}
 	}
 
+	TEST_F(ErrorCollectorTest, ErrorCount_Created)
+	{
+		auto block_statements = ASTNode::Dependencies{};
+		block_statements.emplace_back(ErrorNode::create("first_error"));
+		block_statements.emplace_back(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean));
+		block_statements.emplace_back(
+			UnaryNode::create(ErrorNode::create("second_error"), ASTNode::Operator::LogicalNot));
+		auto if_node = IfNode::create(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean),
+		                              BlockNode::create(std::move(block_statements)));
+
+		auto module_statements = ASTNode::Dependencies{};
+		module_statements.push_back(std::move(if_node));
+		module_statements.push_back(ReturnNode::create());
+		auto module = ModuleNode::create("error_collector_module", std::move(module_statements));
+
+		EXPECT_TRUE(module->has_errors());
+		EXPECT_EQ(module->errors(), 2);
+		EXPECT_EQ(module->errors(), collect_errors(module.get()));
+
+		const auto& statements = module->as<ModuleNode>().statements;
+		EXPECT_EQ(statements[0]->errors(), 2);
+		EXPECT_FALSE(statements[0]->as<IfNode>().condition->has_errors());
+		EXPECT_FALSE(statements[1]->has_errors());
+	}
+
+	TEST_F(ErrorCollectorTest, ErrorCount_Rewritten)
+	{
+		auto module = parser::Parser::parse("error_collector_module", SourceBuffer::from_string(std::string(R"(
+			fn main(a: i32) :: i32 {
+				let b: i32 = a + 1.0;
+				let c: i32 = a + true;
+				return a + 1;
+			}
+		)"sv)));
+		ASSERT_FALSE(module->has_errors());
+
+		TypeDiscovererVisitor type_discoverer{};
+		type_discoverer.accept(module);
+		ASSERT_FALSE(module->has_errors());
+
+		TypeResolverVisitor type_resolver{ type_discoverer.discovered_types() };
+		type_resolver.accept(module);
+		EXPECT_TRUE(module->has_errors());
+		EXPECT_EQ(module->errors(), collect_errors(module.get()));
+
+		FixErrorsVisitor fix_errors{};
+		fix_errors.accept(module);
+		EXPECT_FALSE(module->has_errors());
+		EXPECT_EQ(collect_errors(module.get()), 0);
+	}
+
+	TEST_F(ErrorCollectorTest, ErrorsPastDepth)
+	{
+		auto expression = ErrorNode::create("deep_error");
+		for (std::size_t index = 0; index < 16; ++index) {
+			expression = UnaryNode::create(std::move(expression), ASTNode::Operator::LogicalNot);
+		}
+
+		ErrorCollectorVisitor error_collector{ 4 };
+		error_collector.accept(expression.get());
+
+		EXPECT_TRUE(error_collector.errors().empty());
+		EXPECT_FALSE(error_collector.is_valid());
+	}
+
+	TEST_F(ErrorCollectorTest, ErrorCount_Stale)
+	{
+		auto expression = UnaryNode::create(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean),
+		                                    ASTNode::Operator::LogicalNot);
+		auto root       = UnaryNode::create(std::move(expression), ASTNode::Operator::LogicalNot);
+
+		// NOTE: Modifying the tree without updating the ancestors (see ASTNode::update_errors) leaves the count stale.
+		auto& inner      = root->as<UnaryNode>().expression->as<UnaryNode>();
+		inner.expression = ErrorNode::create("stale_error");
+		inner.update_errors();
+		ASSERT_FALSE(root->has_errors());
+
+		EXPECT_DEBUG_DEATH(collect_errors(root.get()), "stale");
+	}
 }  // namespace soul::ast::visitors::ut
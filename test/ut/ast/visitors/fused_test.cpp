@@ -0,0 +1,130 @@
+#include "ast/visitors/fused.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/error_collector.h"
+#include "ast/visitors/statistics.h"
+#include "fixtures.h"
+
+#include <string_view>
+#include <vector>
+
+namespace soul::ast::visitors::ut
+{
+	using namespace std::string_view_literals;
+
+	class FusedVisitorTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		/**
+		 * @brief Records the kinds of the entered and left nodes.
+		 */
+		struct RecorderPass
+		{
+			std::vector<ASTNode::Kind> entered{};
+			std::vector<ASTNode::Kind> left{};
+
+			void enter(const ASTNode& node) { entered.push_back(node.kind()); }
+			void leave(const ASTNode& node) { left.push_back(node.kind()); }
+		};
+
+		/**
+		 * @brief Counts the literals and the identifiers among them.
+		 */
+		struct LiteralCounterPass
+		{
+			std::size_t literals    = 0;
+			std::size_t identifiers = 0;
+
+			void visit(const LiteralNode& node)
+			{
+				++literals;
+				identifiers += node.literal_type == LiteralNode::Type::Identifier;
+			}
+		};
+	};
+
+	TEST_F(FusedVisitorTest, MatchesDefaultTraverseVisitor)
+	{
+		const auto module = parse();
+
+		soul::ut::RecorderVisitor recorder_visitor{};
+		recorder_visitor.accept(module.get());
+
+		RecorderPass       recorder{};
+		LiteralCounterPass literal_counter{};
+		FusedVisitor       fused{ recorder, literal_counter };
+		fused.accept(module.get());
+
+		EXPECT_GT(recorder.entered.size(), 1);
+		EXPECT_EQ(recorder.entered, recorder_visitor.kinds);
+		ASSERT_EQ(recorder.left.size(), recorder.entered.size());
+		EXPECT_EQ(recorder.left.back(), ASTNode::Kind::ModuleNode);
+		EXPECT_EQ(literal_counter.literals, recorder_visitor.literals);
+		EXPECT_GT(literal_counter.identifiers, 0);
+		EXPECT_LT(literal_counter.identifiers, literal_counter.literals);
+	}
+
+	TEST_F(FusedVisitorTest, MatchesErrorCollectorVisitor)
+	{
+		const auto module = parse(R"(
+			fn main(a: i32) :: i32 {
+				let b: i32 = ;
+				return a +;
+			}
+			let c: i32 = (;
+		)"sv);
+		ASSERT_TRUE(module->has_errors());
+
+		ErrorCollectorVisitor error_collector{};
+		error_collector.accept(module.get());
+		StatisticsVisitor statistics{};
+		statistics.accept(module.get());
+
+		ErrorCollectorVisitor fused_error_collector{};
+		StatisticsVisitor     fused_statistics{};
+		LiteralCounterPass    literal_counter{};
+		FusedVisitor          fused{ literal_counter, fused_error_collector, fused_statistics };
+		fused.accept(module.get());
+
+		EXPECT_EQ(fused_error_collector.errors(), error_collector.errors());
+		EXPECT_EQ(fused_error_collector.errors().size(), module->errors());
+		EXPECT_FALSE(fused_error_collector.is_valid());
+		EXPECT_EQ(fused_statistics.count(), statistics.count());
+		EXPECT_EQ(fused_statistics.depth(), statistics.depth());
+		EXPECT_EQ(fused_statistics.count(ASTNode::Kind::ErrorNode), module->errors());
+		EXPECT_EQ(fused_statistics.count(ASTNode::Kind::LiteralNode), literal_counter.literals);
+	}
+
+	TEST_F(FusedVisitorTest, MatchesErrorCollectorVisitor_MaxDepth)
+	{
+		const auto module = parse(R"(
+			let a: i32 = ;
+			fn main() :: i32 {
+				return 1 +;
+			}
+		)"sv);
+		ASSERT_TRUE(module->has_errors());
+
+		ErrorCollectorVisitor error_collector{ 3 };
+		error_collector.accept(module.get());
+
+		ErrorCollectorVisitor fused_error_collector{ 3 };
+		FusedVisitor{ fused_error_collector }.accept(module.get());
+
+		EXPECT_EQ(fused_error_collector.errors(), error_collector.errors());
+		EXPECT_LT(fused_error_collector.errors().size(), module->errors());
+		EXPECT_FALSE(fused_error_collector.is_valid());
+	}
+
+	TEST_F(FusedVisitorTest, Null)
+	{
+		RecorderPass recorder{};
+		FusedVisitor fused{ recorder };
+		fused.accept(nullptr);
+
+		EXPECT_TRUE(recorder.entered.empty());
+		EXPECT_TRUE(recorder.left.empty());
+	}
+}  // namespace soul::ast::visitors::ut
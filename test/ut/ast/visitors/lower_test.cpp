@@ -309,13 +309,13 @@ namespace soul::ast::visitors::ut
 			k_variable_name, "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), true);
 
 		auto while_node_condition
-			= BinaryNode::create(LiteralNode::create(Value{ k_variable_name }, LiteralNode::Type::Identifier),
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ k_variable_name } }, LiteralNode::Type::Identifier),
 		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
 		                         ASTNode::Operator::Less);
 		auto while_node_statements = ASTNode::Dependencies{};
 		while_node_statements.emplace_back(BinaryNode::create(
-			LiteralNode::create(Value{ k_variable_name }, LiteralNode::Type::Identifier),
-			BinaryNode::create(LiteralNode::create(Value{ k_variable_name }, LiteralNode::Type::Identifier),
+			LiteralNode::create(Value{ Symbol{ k_variable_name } }, LiteralNode::Type::Identifier),
+			BinaryNode::create(LiteralNode::create(Value{ Symbol{ k_variable_name } }, LiteralNode::Type::Identifier),
 		                       LiteralNode::create(Value{ 1 }, LiteralNode::Type::Int32),
 		                       ASTNode::Operator::Add),
 			ASTNode::Operator::Assign));
@@ -430,16 +430,16 @@ namespace soul::ast::visitors::ut
 		function_declaration_statements.reserve(4);
 		function_declaration_statements.emplace_back(VariableDeclarationNode::create(
 			k_first_variable_name, "i32", LiteralNode::create(Value{ 1 }, LiteralNode::Type::Int32), true));
-		function_declaration_statements.emplace_back(
-			BinaryNode::create(LiteralNode::create(Value{ k_first_variable_name }, LiteralNode::Type::Identifier),
-		                       LiteralNode::create(Value{ 3 }, LiteralNode::Type::Int32),
-		                       ASTNode::Operator::Assign));
+		function_declaration_statements.emplace_back(BinaryNode::create(
+			LiteralNode::create(Value{ Symbol{ k_first_variable_name } }, LiteralNode::Type::Identifier),
+			LiteralNode::create(Value{ 3 }, LiteralNode::Type::Int32),
+			ASTNode::Operator::Assign));
 		function_declaration_statements.emplace_back(VariableDeclarationNode::create(
 			k_second_variable_name, "i32", LiteralNode::create(Value{ 5 }, LiteralNode::Type::Int32), false));
-		function_declaration_statements.emplace_back(
-			BinaryNode::create(LiteralNode::create(Value{ k_second_variable_name }, LiteralNode::Type::Identifier),
-		                       LiteralNode::create(Value{ k_first_variable_name }, LiteralNode::Type::Identifier),
-		                       ASTNode::Operator::Assign));
+		function_declaration_statements.emplace_back(BinaryNode::create(
+			LiteralNode::create(Value{ Symbol{ k_second_variable_name } }, LiteralNode::Type::Identifier),
+			LiteralNode::create(Value{ Symbol{ k_first_variable_name } }, LiteralNode::Type::Identifier),
+			ASTNode::Operator::Assign));
 
 		auto function_declaration_parameters = ASTNode::Dependencies{};
 		auto function_declaration
@@ -485,9 +485,10 @@ namespace soul::ast::visitors::ut
 		function_declaration_statements.emplace_back(VariableDeclarationNode::create(
 			k_second_variable_name,
 			"i32",
-			BinaryNode::create(LiteralNode::create(Value{ k_first_variable_name }, LiteralNode::Type::Identifier),
-		                       LiteralNode::create(Value{ k_first_variable_name }, LiteralNode::Type::Identifier),
-		                       ASTNode::Operator::Mul),
+			BinaryNode::create(
+				LiteralNode::create(Value{ Symbol{ k_first_variable_name } }, LiteralNode::Type::Identifier),
+				LiteralNode::create(Value{ Symbol{ k_first_variable_name } }, LiteralNode::Type::Identifier),
+				ASTNode::Operator::Mul),
 			false));
 
 		auto function_declaration_parameters = ASTNode::Dependencies{};
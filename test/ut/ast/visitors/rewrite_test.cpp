@@ -0,0 +1,88 @@
+#include "ast/visitors/rewrite.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/compare.h"
+#include "ast/visitors/copy.h"
+#include "ast/visitors/desugar.h"
+#include "fixtures.h"
+
+namespace soul::ast::visitors::ut
+{
+	class RewriteVisitorTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		static ASTNode::Dependency copy(ASTNode::Reference root)
+		{
+			CopyVisitor copy_visitor{};
+			copy_visitor.accept(root);
+			return copy_visitor.cloned();
+		}
+	};
+
+	TEST_F(RewriteVisitorTest, Reference_LeavesOriginalIntact)
+	{
+		const auto module   = parse();
+		const auto original = copy(module.get());
+
+		DesugarVisitor desugar_visitor{};
+		desugar_visitor.accept(module.get());
+		const auto result = desugar_visitor.cloned();
+		ASSERT_TRUE(result);
+
+		EXPECT_TRUE(CompareVisitor(original.get(), module.get()));
+		EXPECT_FALSE(CompareVisitor(original.get(), result.get()));
+	}
+
+	TEST_F(RewriteVisitorTest, Dependency_RewritesInPlace)
+	{
+		auto expected = [] {
+			const auto module = parse();
+
+			DesugarVisitor desugar_visitor{};
+			desugar_visitor.accept(module.get());
+			return desugar_visitor.cloned();
+		}();
+
+		auto        module     = parse();
+		const auto* module_ptr = module.get();
+
+		DesugarVisitor desugar_visitor{};
+		desugar_visitor.accept(module);
+		EXPECT_FALSE(desugar_visitor.cloned());
+
+		// Module itself is mutated (not replaced), while the loop within it is.
+		EXPECT_EQ(module.get(), module_ptr);
+		EXPECT_TRUE(CompareVisitor(expected.get(), module.get()));
+	}
+
+	TEST_F(RewriteVisitorTest, Dependency_DetachesSharedNodes)
+	{
+		const auto module   = parse();
+		const auto original = copy(module.get());
+
+		auto           shared = module->share();
+		DesugarVisitor desugar_visitor{};
+		desugar_visitor.accept(shared);
+
+		// Shared nodes are copied before being rewritten, thus the other tree is left intact.
+		EXPECT_NE(shared.get(), module.get());
+		EXPECT_TRUE(CompareVisitor(original.get(), module.get()));
+		EXPECT_FALSE(CompareVisitor(original.get(), shared.get()));
+	}
+
+	TEST_F(RewriteVisitorTest, Dependency_ReplacesRoot)
+	{
+		auto root = ForLoopNode::create(nullptr, nullptr, nullptr, BlockNode::create({}));
+
+		DesugarVisitor desugar_visitor{};
+		desugar_visitor.accept(root);
+		ASSERT_TRUE(root);
+		ASSERT_TRUE(root->is<BlockNode>());
+
+		const auto& statements = root->as<BlockNode>().statements;
+		ASSERT_EQ(statements.size(), 1);
+		EXPECT_TRUE(statements[0]->is<WhileNode>());
+	}
+}  // namespace soul::ast::visitors::ut
@@ -0,0 +1,192 @@
+#include "ast/visitors/serialize.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/compare.h"
+#include "ast/visitors/stringify.h"
+#include "common/source_buffer.h"
+#include "parser/parser.h"
+
+#include <filesystem>
+#include <source_location>
+#include <string_view>
+
+namespace soul::ast::visitors::ut
+{
+	using namespace soul::types;
+	using namespace std::string_view_literals;
+
+	class SerializeTest : public ::testing::Test
+	{
+		protected:
+		static std::string serialize(ASTNode::Reference root)
+		{
+			SerializeVisitor serialize_visitor{};
+			serialize_visitor.accept(root);
+			return serialize_visitor.bytes();
+		}
+
+		static std::string stringify(ASTNode::Reference root)
+		{
+			StringifyVisitor stringify_visitor{ StringifyVisitor::Options::PrintTypes };
+			stringify_visitor.accept(root);
+			return stringify_visitor.string();
+		}
+
+		static ASTNode::Dependency build_module()
+		{
+			auto struct_declaration = StructDeclarationNode::create(
+				"point",
+				[] {
+					ASTNode::Dependencies parameters{};
+					parameters.emplace_back(VariableDeclarationNode::create("x", "f64", nullptr, false));
+					parameters.emplace_back(VariableDeclarationNode::create("y", "f64", nullptr, false));
+					return parameters;
+				}());
+			struct_declaration->type = Type{ StructType{ { PrimitiveType::Kind::Float64, PrimitiveType::Kind::Float64 } } };
+
+			ASTNode::Dependencies statements{};
+			statements.emplace_back(VariableDeclarationNode::create(
+				"negative", "i64", LiteralNode::create(Value{ -1234567L }, LiteralNode::Type::Int64), true));
+			statements.emplace_back(VariableDeclarationNode::create(
+				"pi", "f64", LiteralNode::create(Value{ 3.14159 }, LiteralNode::Type::Float64), false));
+			statements.emplace_back(
+				UnaryNode::create(LiteralNode::create(Value{ true }, LiteralNode::Type::Boolean), ASTNode::Operator::LogicalNot));
+			statements.emplace_back(CastNode::create(
+				LiteralNode::create(Value{ Value::Variant{ std::in_place_type<char>, 'c' } }, LiteralNode::Type::Char),
+				"i32"));
+			statements.emplace_back(WhileNode::create(
+				BinaryNode::create(LiteralNode::create(Value{ Symbol{ "negative" } }, LiteralNode::Type::Identifier),
+			                       LiteralNode::create(Value{ 0L }, LiteralNode::Type::Int64),
+			                       ASTNode::Operator::Less),
+				BlockNode::create([] {
+					ASTNode::Dependencies loop_statements{};
+					loop_statements.emplace_back(LoopControlNode::create(LoopControlNode::Type::Continue));
+					return loop_statements;
+				}())));
+			statements.emplace_back(IfNode::create(
+				LiteralNode::create(Value{ false }, LiteralNode::Type::Boolean), BlockNode::create({}), nullptr));
+			statements.emplace_back(ForLoopNode::create(nullptr, nullptr, nullptr, BlockNode::create({})));
+			statements.emplace_back(ErrorNode::create("unexpected token"));
+
+			auto function_call = FunctionCallNode::create("print", [] {
+				ASTNode::Dependencies parameters{};
+				parameters.emplace_back(LiteralNode::create(Value{ "zażółć" }, LiteralNode::Type::String));
+				return parameters;
+			}());
+			function_call->type = Type{ PrimitiveType::Kind::Void };
+			statements.emplace_back(std::move(function_call));
+			statements.emplace_back(ReturnNode::create());
+
+			auto function_declaration      = FunctionDeclarationNode::create("main", "void", {}, BlockNode::create(std::move(statements)));
+			function_declaration->type     = Type{ Type::Variant{ ArrayType{ Type{ PrimitiveType::Kind::Int32 } } } };
+
+			ASTNode::Dependencies module_statements{};
+			module_statements.emplace_back(std::move(struct_declaration));
+			module_statements.emplace_back(std::move(function_declaration));
+			return ModuleNode::create("serialize_module", std::move(module_statements));
+		}
+	};
+
+	TEST_F(SerializeTest, RoundTrip)
+	{
+		const auto expected_module = build_module();
+
+		const auto bytes  = serialize(expected_module.get());
+		const auto result = SerializeVisitor::deserialize(bytes);
+		ASSERT_TRUE(result);
+
+		CompareVisitor compare{ expected_module.get(), result.get() };
+		EXPECT_TRUE(compare) << "expected: " << stringify(expected_module.get()) << '\n'
+							 << "but got: " << stringify(result.get());
+		EXPECT_EQ(stringify(expected_module.get()), stringify(result.get()));
+		EXPECT_EQ(bytes, serialize(result.get()));
+	}
+
+	TEST_F(SerializeTest, RoundTrip_ParserCases)
+	{
+		static const auto k_base_directory
+			= std::filesystem::path{ std::source_location::current().file_name() }.parent_path().parent_path().parent_path()
+		    / "parser" / "cases";
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(k_base_directory)) {
+			if (entry.path().extension() != ".soul") {
+				continue;
+			}
+			const auto input = SourceBuffer::map(entry.path());
+			ASSERT_TRUE(input.has_value()) << "failed to read: " << entry.path();
+
+			const auto expected_module = parser::Parser::parse("test_module", *input);
+			const auto result          = SerializeVisitor::deserialize(serialize(expected_module.get()));
+			ASSERT_TRUE(result) << entry.path();
+			EXPECT_EQ(stringify(expected_module.get()), stringify(result.get())) << entry.path();
+		}
+	}
+
+	TEST_F(SerializeTest, Deserialize_Malformed)
+	{
+		const auto bytes = serialize(build_module().get());
+
+		for (std::size_t size = 0; size < bytes.size(); ++size) {
+			EXPECT_FALSE(SerializeVisitor::deserialize(std::string_view{ bytes }.substr(0, size))) << "size: " << size;
+		}
+		EXPECT_FALSE(SerializeVisitor::deserialize(bytes + '\0'));
+		EXPECT_FALSE(SerializeVisitor::deserialize("\xFF"sv));
+		EXPECT_FALSE(SerializeVisitor::deserialize(std::string(16, '\x80')));
+	}
+
+	TEST_F(SerializeTest, SerializedAST_Statements)
+	{
+		const auto expected_module = build_module();
+		const auto bytes           = serialize(expected_module.get());
+
+		const auto serialized = SerializedAST::open(bytes);
+		ASSERT_TRUE(serialized.has_value());
+		ASSERT_TRUE(serialized->is_module());
+		EXPECT_EQ(serialized->module_name(), Symbol{ "serialize_module" });
+
+		const auto& expected_statements = expected_module->as<ModuleNode>().statements;
+		ASSERT_EQ(serialized->statement_count(), expected_statements.size());
+		// NOTE: Statements are read in reverse order, to ensure that these do not depend on each other.
+		for (auto index = serialized->statement_count(); index-- > 0;) {
+			const auto statement = serialized->deserialize_statement(index);
+			ASSERT_TRUE(statement) << "index: " << index;
+			EXPECT_TRUE(CompareVisitor(expected_statements[index].get(), statement.get())) << "index: " << index;
+		}
+		EXPECT_FALSE(serialized->deserialize_statement(serialized->statement_count()));
+
+		const auto result = serialized->deserialize();
+		ASSERT_TRUE(result);
+		EXPECT_TRUE(CompareVisitor(expected_module.get(), result.get()));
+	}
+
+	TEST_F(SerializeTest, SerializedAST_NotModule)
+	{
+		const auto expected = ReturnNode::create(LiteralNode::create(Value{ 1L }, LiteralNode::Type::Int64));
+
+		const auto serialized = SerializedAST::open(serialize(expected.get()));
+		ASSERT_TRUE(serialized.has_value());
+		EXPECT_FALSE(serialized->is_module());
+		EXPECT_EQ(serialized->statement_count(), 0);
+		EXPECT_FALSE(serialized->deserialize_statement(0));
+
+		const auto result = serialized->deserialize();
+		ASSERT_TRUE(result);
+		EXPECT_TRUE(CompareVisitor(expected.get(), result.get()));
+	}
+
+	TEST_F(SerializeTest, SerializedAST_Malformed)
+	{
+		const auto bytes = serialize(build_module().get());
+
+		for (std::size_t size = 0; size < bytes.size(); ++size) {
+			const auto serialized = SerializedAST::open(std::string_view{ bytes }.substr(0, size));
+			if (serialized) {
+				// NOTE: Truncation might be detected only once the nodes are read.
+				EXPECT_FALSE(serialized->deserialize()) << "size: " << size;
+			}
+		}
+		EXPECT_FALSE(SerializedAST::open(""sv));
+		EXPECT_FALSE(SerializedAST::open("\xFF\xFF\xFF\xFF"sv));
+	}
+}  // namespace soul::ast::visitors::ut
@@ -0,0 +1,56 @@
+#include "ast/visitors/static_traverse.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "fixtures.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace soul::ast::visitors::ut
+{
+	class StaticTraverseVisitorTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		/**
+		 * @brief Records the kinds of the visited nodes, in order, and counts the (mutably visited) literals.
+		 */
+		class StaticRecorder final : public StaticTraverseVisitor<StaticRecorder>
+		{
+			public:
+			std::vector<ASTNode::Kind> kinds{};
+			std::size_t                mutable_literals = 0;
+
+			void accept(ASTNode::Reference node)
+			{
+				if (node) {
+					kinds.push_back(node->kind());
+				}
+				StaticTraverseVisitor::accept(node);
+			}
+
+			protected:
+			friend StaticTraverseVisitor;
+			using StaticTraverseVisitor::visit;
+			void visit(LiteralNode&) { ++mutable_literals; }
+		};
+	};
+
+	TEST_F(StaticTraverseVisitorTest, MatchesDefaultTraverseVisitor)
+	{
+		const auto module = parse();
+
+		soul::ut::RecorderVisitor virtual_recorder{};
+		virtual_recorder.accept(module.get());
+
+		StaticRecorder static_recorder{};
+		static_recorder.accept(module.get());
+
+		EXPECT_GT(static_recorder.kinds.size(), 1);
+		EXPECT_EQ(static_recorder.kinds, virtual_recorder.kinds);
+		EXPECT_EQ(static_recorder.mutable_literals, virtual_recorder.literals);
+		EXPECT_EQ(static_recorder.mutable_literals,
+		          std::ranges::count(static_recorder.kinds, ASTNode::Kind::LiteralNode));
+	}
+}  // namespace soul::ast::visitors::ut
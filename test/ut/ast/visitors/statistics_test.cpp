@@ -0,0 +1,59 @@
+#include "ast/visitors/statistics.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "fixtures.h"
+
+namespace soul::ast::visitors::ut
+{
+	class StatisticsVisitorTest : public soul::ut::ModuleFixture
+	{
+	};
+
+	TEST_F(StatisticsVisitorTest, Counts)
+	{
+		// Tree is: -(1) + 2
+		const auto root = BinaryNode::create(
+			UnaryNode::create(LiteralNode::create(Value{ i64{ 1 } }, LiteralNode::Type::Int64), ASTNode::Operator::Sub),
+			LiteralNode::create(Value{ i64{ 2 } }, LiteralNode::Type::Int64),
+			ASTNode::Operator::Add);
+
+		StatisticsVisitor statistics{};
+		statistics.accept(root.get());
+
+		EXPECT_EQ(statistics.count(), 4);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::BinaryNode), 1);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::UnaryNode), 1);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::LiteralNode), 2);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::ModuleNode), 0);
+		EXPECT_EQ(statistics.depth(), 3);
+	}
+
+	TEST_F(StatisticsVisitorTest, Accumulates)
+	{
+		const auto module = parse();
+
+		StatisticsVisitor statistics{};
+		statistics.accept(module.get());
+		const auto count = statistics.count();
+		const auto depth = statistics.depth();
+		EXPECT_GT(count, depth);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::ModuleNode), 1);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::ErrorNode), 0);
+
+		statistics.accept(module.get());
+		EXPECT_EQ(statistics.count(), 2 * count);
+		EXPECT_EQ(statistics.count(ASTNode::Kind::ModuleNode), 2);
+		EXPECT_EQ(statistics.depth(), depth);
+	}
+
+	TEST_F(StatisticsVisitorTest, Null)
+	{
+		StatisticsVisitor statistics{};
+		statistics.accept(nullptr);
+
+		EXPECT_EQ(statistics.count(), 0);
+		EXPECT_EQ(statistics.depth(), 0);
+	}
+}  // namespace soul::ast::visitors::ut
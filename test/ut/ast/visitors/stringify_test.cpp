@@ -0,0 +1,162 @@
+#include "ast/visitors/stringify.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "fixtures.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace soul::ast::visitors::ut
+{
+	class StringifyVisitorTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		/** @brief Returns module with a given number of (small) functions. */
+		static ASTNode::Dependency parse_repeated(std::size_t count)
+		{
+			std::string script{};
+			for (std::size_t index = 0; index < count; ++index) {
+				script += "fn f(a: i32) :: i32 { let mut sum: i64 = 0; while (sum < 10) { sum += 1; }; return a; }\n";
+			}
+			return parse(script);
+		}
+
+		static std::string stringify(ASTNode::Reference root, StringifyVisitor::Options options)
+		{
+			StringifyVisitor stringify_visitor{ options };
+			stringify_visitor.accept(root);
+			return stringify_visitor.string();
+		}
+	};
+
+	TEST_F(StringifyVisitorTest, Sink_MatchesString)
+	{
+		const auto module   = parse();
+		const auto expected = stringify(module.get(), StringifyVisitor::Options::PrintTypes);
+
+		std::string result{};
+		const auto  sink = [&](std::string_view chunk) {
+			result += chunk;
+			return true;
+		};
+
+		StringifyVisitor stringify_visitor{ sink, StringifyVisitor::Options::PrintTypes };
+		stringify_visitor.accept(module.get());
+
+		EXPECT_EQ(result, expected);
+		EXPECT_TRUE(stringify_visitor.string().empty());
+	}
+
+	TEST_F(StringifyVisitorTest, Sink_Chunks)
+	{
+		const auto module   = parse_repeated(1024);
+		const auto expected = stringify(module.get(), StringifyVisitor::Options::None);
+		ASSERT_GT(expected.size(), 4 * StringifyVisitor::k_chunk_size);
+
+		std::vector<std::size_t> chunk_sizes{};
+		std::string              result{};
+		const auto               sink = [&](std::string_view chunk) {
+			chunk_sizes.push_back(chunk.size());
+			result += chunk;
+			return true;
+		};
+
+		StringifyVisitor stringify_visitor{ sink };
+		stringify_visitor.accept(module.get());
+
+		EXPECT_EQ(result, expected);
+		EXPECT_GT(chunk_sizes.size(), 4);
+		// NOTE: Chunk is handed over once it exceeds the chunk size, thus only by the length of a single write.
+		EXPECT_LT(std::ranges::max(chunk_sizes), StringifyVisitor::k_chunk_size + 256);
+	}
+
+	TEST_F(StringifyVisitorTest, Compact)
+	{
+		const auto module = parse();
+
+		static constexpr auto k_compact_options = static_cast<StringifyVisitor::Options>(
+			StringifyVisitor::Options::PrintTypes | StringifyVisitor::Options::Compact);
+
+		const auto indented = stringify(module.get(), StringifyVisitor::Options::PrintTypes);
+		const auto compact  = stringify(module.get(), k_compact_options);
+
+		EXPECT_LT(compact.size(), indented.size());
+		EXPECT_EQ(compact.find('\n'), std::string::npos);
+		EXPECT_EQ(compact.find("\": "), std::string::npos);
+		EXPECT_TRUE(compact.starts_with(R"({"node":"module_declaration","type":)"));
+
+		// NOTE: Apart from the whitespace, both of the representations are the same.
+		auto strip = [](std::string string) {
+			bool is_quoted = false;
+			std::erase_if(string, [&](char c) {
+				is_quoted ^= c == '"';
+				return !is_quoted && (c == ' ' || c == '\n');
+			});
+			return string;
+		};
+		EXPECT_EQ(strip(indented), compact);
+	}
+
+	TEST_F(StringifyVisitorTest, Null)
+	{
+		EXPECT_EQ(stringify(nullptr, StringifyVisitor::Options::None), "null");
+
+		std::string result{};
+		const auto  sink = [&](std::string_view chunk) {
+			result += chunk;
+			return true;
+		};
+
+		StringifyVisitor stringify_visitor{ sink };
+		stringify_visitor.accept(nullptr);
+		EXPECT_EQ(result, "null");
+	}
+
+	TEST_F(StringifyVisitorTest, Sink_Failure)
+	{
+		const auto module = parse_repeated(1024);
+
+		std::size_t      chunks = 0;
+		StringifyVisitor stringify_visitor{ [&](std::string_view) { return ++chunks > 1; } };
+		stringify_visitor.accept(module.get());
+
+		// NOTE: Once the sink fails, the rest of the representation is dropped.
+		EXPECT_TRUE(stringify_visitor.has_failed());
+		EXPECT_EQ(chunks, 1);
+	}
+
+	TEST_F(StringifyVisitorTest, FileSink)
+	{
+		const auto module   = parse();
+		const auto expected = stringify(module.get(), StringifyVisitor::Options::None);
+
+		std::FILE* file = std::tmpfile();
+		ASSERT_NE(file, nullptr);
+		StringifyVisitor stringify_visitor{ StringifyVisitor::file_sink(file) };
+		stringify_visitor.accept(module.get());
+		EXPECT_FALSE(stringify_visitor.has_failed());
+
+		std::string result(expected.size(), '\0');
+		std::rewind(file);
+		EXPECT_EQ(std::fread(result.data(), sizeof(char), result.size(), file), expected.size());
+		EXPECT_EQ(result, expected);
+		std::fclose(file);
+
+		// NOTE: Short writes (here, into a stream opened only for reading) are reported as well.
+		const auto path = std::filesystem::temp_directory_path() / "stringify_file_sink_test.json";
+		std::fclose(std::fopen(path.string().c_str(), "w"));
+		std::FILE* read_only = std::fopen(path.string().c_str(), "r");
+		ASSERT_NE(read_only, nullptr);
+		StringifyVisitor read_only_visitor{ StringifyVisitor::file_sink(read_only) };
+		read_only_visitor.accept(module.get());
+		EXPECT_TRUE(read_only_visitor.has_failed());
+		std::fclose(read_only);
+		std::filesystem::remove(path);
+	}
+}  // namespace soul::ast::visitors::ut
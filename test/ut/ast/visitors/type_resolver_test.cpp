@@ -200,7 +200,10 @@ namespace soul::ast::visitors::ut
 	{
 		auto block_node_statements = ASTNode::Dependencies{};
 		block_node_statements.emplace_back(VariableDeclarationNode::create(
-			"in_scope", "f32", LiteralNode::create(Value{ "before_scope" }, LiteralNode::Type::Identifier), false));
+			"in_scope",
+			"f32",
+			LiteralNode::create(Value{ Symbol{ "before_scope" } }, LiteralNode::Type::Identifier),
+			false));
 
 		auto module_statements = ASTNode::Dependencies{};
 		module_statements.reserve(3);
@@ -246,7 +249,7 @@ namespace soul::ast::visitors::ut
 			{
 				ASSERT_TRUE(as_in_scope_variable.expression->is<LiteralNode>());
 				const auto& as_literal = as_in_scope_variable.expression->as<LiteralNode>();
-				EXPECT_EQ(as_literal.value, Value{ "before_scope" });
+				EXPECT_EQ(as_literal.value, Value{ Symbol{ "before_scope" } });
 				EXPECT_EQ(as_literal.literal_type, LiteralNode::Type::Identifier);
 				EXPECT_EQ(as_literal.type, PrimitiveType::Kind::Float32);
 			}
@@ -323,11 +326,12 @@ namespace soul::ast::visitors::ut
 		auto initialization = VariableDeclarationNode::create(
 			"index", "i32", LiteralNode::create(Value{ 0 }, LiteralNode::Type::Int32), true);
 
-		auto condition = BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                    LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
-		                                    ASTNode::Operator::Less);
+		auto condition
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
+		                         ASTNode::Operator::Less);
 
-		auto update = UnaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
+		auto update = UnaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
 		                                ASTNode::Operator::Increment);
 
 		auto for_loop_statements = ASTNode::Dependencies{};
@@ -375,7 +379,7 @@ namespace soul::ast::visitors::ut
 			ASSERT_TRUE(as_condition.lhs->is<LiteralNode>());
 			const auto& as_lhs = as_condition.lhs->as<LiteralNode>();
 			EXPECT_EQ(as_lhs.type, PrimitiveType::Kind::Int32);
-			EXPECT_EQ(as_lhs.value, Value{ "index" });
+			EXPECT_EQ(as_lhs.value, Value{ Symbol{ "index" } });
 			EXPECT_EQ(as_lhs.literal_type, LiteralNode::Type::Identifier);
 
 			ASSERT_TRUE(as_condition.rhs->is<LiteralNode>());
@@ -393,7 +397,7 @@ namespace soul::ast::visitors::ut
 			ASSERT_TRUE(as_update.expression->is<LiteralNode>());
 			const auto& as_value = as_update.expression->as<LiteralNode>();
 			EXPECT_EQ(as_value.type, PrimitiveType::Kind::Int32);
-			EXPECT_EQ(as_value.value, Value{ "index" });
+			EXPECT_EQ(as_value.value, Value{ Symbol{ "index" } });
 			EXPECT_EQ(as_value.literal_type, LiteralNode::Type::Identifier);
 		}
 
@@ -411,9 +415,10 @@ namespace soul::ast::visitors::ut
 
 	TEST_F(TypeResolverTest, ForLoop_ConditionNotBool)
 	{
-		auto condition = BinaryNode::create(LiteralNode::create(Value{ "index" }, LiteralNode::Type::Identifier),
-		                                    LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
-		                                    ASTNode::Operator::Add);
+		auto condition
+			= BinaryNode::create(LiteralNode::create(Value{ Symbol{ "index" } }, LiteralNode::Type::Identifier),
+		                         LiteralNode::create(Value{ 10 }, LiteralNode::Type::Int32),
+		                         ASTNode::Operator::Add);
 		auto for_loop
 			= ForLoopNode::create(nullptr, std::move(condition), nullptr, BlockNode::create(ASTNode::Dependencies{}));
 		auto module_statements = ASTNode::Dependencies{};
@@ -539,7 +544,7 @@ namespace soul::ast::visitors::ut
 		function_declaration_parameters.emplace_back(VariableDeclarationNode::create("c", "chr", nullptr, false));
 		auto function_declaration_statements = ASTNode::Dependencies{};
 		function_declaration_statements.emplace_back(VariableDeclarationNode::create(
-			"d", "chr", LiteralNode::create(Value{ "c" }, LiteralNode::Type::Identifier), false));
+			"d", "chr", LiteralNode::create(Value{ Symbol{ "c" } }, LiteralNode::Type::Identifier), false));
 		auto function_declaration
 			= FunctionDeclarationNode::create("my_function",
 		                                      "str",
@@ -602,7 +607,7 @@ namespace soul::ast::visitors::ut
 		{
 			ASSERT_TRUE(as_variable_declaration.expression->is<LiteralNode>());
 			const auto& as_literal = as_variable_declaration.expression->as<LiteralNode>();
-			EXPECT_EQ(as_literal.value, Value{ "c" });
+			EXPECT_EQ(as_literal.value, Value{ Symbol{ "c" } });
 			EXPECT_EQ(as_literal.literal_type, LiteralNode::Type::Identifier);
 			EXPECT_EQ(as_literal.type, PrimitiveType::Kind::Char);
 		}
@@ -766,7 +771,7 @@ namespace soul::ast::visitors::ut
 				case LiteralNode::Type::Float64:
 					return Value{ 10.0 };
 				case LiteralNode::Type::Identifier:
-					return Value{ "index" };
+					return Value{ Symbol{ "index" } };
 				case LiteralNode::Type::Int32:
 					return Value{ 1 };
 				case LiteralNode::Type::Int64:
@@ -834,7 +839,8 @@ namespace soul::ast::visitors::ut
 		static constexpr auto k_variable_name = "undeclared_variable";
 
 		auto module_statements = ASTNode::Dependencies{};
-		module_statements.emplace_back(LiteralNode::create(Value{ k_variable_name }, LiteralNode::Type::Identifier));
+		module_statements.emplace_back(
+			LiteralNode::create(Value{ Symbol{ k_variable_name } }, LiteralNode::Type::Identifier));
 		auto expected_module = ModuleNode::create("resolve_module", std::move(module_statements));
 
 		auto result_module = resolve(expected_module.get());
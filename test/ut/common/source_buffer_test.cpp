@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "common/source_buffer.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace soul::ut
+{
+	using namespace std::string_view_literals;
+
+	class SourceBufferTest : public ::testing::Test
+	{
+		protected:
+		std::filesystem::path _path = std::filesystem::temp_directory_path() / "soul_source_buffer_test.soul";
+
+		protected:
+		void write_file(std::string_view contents)
+		{
+			std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+			file << contents;
+		}
+
+		void TearDown() override { std::filesystem::remove(_path); }
+	};
+
+	TEST_F(SourceBufferTest, Map)
+	{
+		static constexpr auto k_contents = "fn main() :: void {}\n"sv;
+		write_file(k_contents);
+
+		const auto buffer = SourceBuffer::map(_path);
+		ASSERT_TRUE(buffer.has_value()) << buffer.error().message();
+		EXPECT_TRUE((*buffer)->is_mapped());
+		EXPECT_EQ((*buffer)->view(), k_contents);
+		EXPECT_EQ((*buffer)->path(), _path);
+	}
+
+	TEST_F(SourceBufferTest, Map_EmptyFile)
+	{
+		write_file(""sv);
+
+		const auto buffer = SourceBuffer::map(_path);
+		ASSERT_TRUE(buffer.has_value()) << buffer.error().message();
+		EXPECT_TRUE((*buffer)->view().empty());
+	}
+
+	TEST_F(SourceBufferTest, Map_MissingFile)
+	{
+		const auto buffer = SourceBuffer::map(_path.replace_extension(".missing"));
+		ASSERT_FALSE(buffer.has_value());
+		EXPECT_EQ(buffer.error(), std::errc::no_such_file_or_directory);
+	}
+
+	TEST_F(SourceBufferTest, FromString)
+	{
+		static constexpr auto k_contents = "let a: i32 = 5;"sv;
+
+		const auto buffer = SourceBuffer::from_string(std::string(k_contents), "generated.soul");
+		EXPECT_FALSE(buffer->is_mapped());
+		EXPECT_EQ(buffer->view(), k_contents);
+		EXPECT_EQ(buffer->path(), "generated.soul");
+	}
+}  // namespace soul::ut
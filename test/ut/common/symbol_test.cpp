@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "common/symbol.h"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace soul::ut
+{
+	using namespace std::string_view_literals;
+
+	class SymbolTest : public ::testing::Test
+	{
+	};
+
+	TEST_F(SymbolTest, Empty)
+	{
+		const Symbol symbol{};
+		EXPECT_TRUE(symbol.empty());
+		EXPECT_EQ(symbol.id(), 0);
+		EXPECT_EQ(symbol.view(), ""sv);
+		EXPECT_EQ(symbol, Symbol{ ""sv });
+	}
+
+	TEST_F(SymbolTest, Interning)
+	{
+		const Symbol first{ "symbol_test_first"sv };
+		const Symbol second{ std::string("symbol_test_second") };
+		EXPECT_FALSE(first.empty());
+		EXPECT_NE(first, second);
+		EXPECT_EQ(first.view(), "symbol_test_first"sv);
+		EXPECT_EQ(second.view(), "symbol_test_second"sv);
+
+		const auto count = Symbol::count();
+		EXPECT_EQ(first, Symbol{ "symbol_test_first" });
+		EXPECT_EQ(first.id(), Symbol{ std::string("symbol_test_first") }.id());
+		EXPECT_EQ(count, Symbol::count());
+	}
+
+	TEST_F(SymbolTest, TryIntern)
+	{
+		const auto size   = Symbol::size();
+		const auto symbol = Symbol::try_intern("symbol_test_try_intern"sv);
+		ASSERT_TRUE(symbol.has_value());
+		EXPECT_EQ(*symbol, Symbol{ "symbol_test_try_intern"sv });
+		EXPECT_EQ(symbol->view(), "symbol_test_try_intern"sv);
+		EXPECT_EQ(Symbol::size(), size + "symbol_test_try_intern"sv.size());
+		EXPECT_EQ(Symbol::try_intern(""sv), Symbol{});
+	}
+
+	TEST_F(SymbolTest, OrderedByName)
+	{
+		// Interned in the reverse order, thus the ids are ordered the other way around.
+		const Symbol b{ "symbol_test_ordered_b"sv };
+		const Symbol a{ "symbol_test_ordered_a"sv };
+		EXPECT_LT(b.id(), a.id());
+		EXPECT_LT(a, b);
+		EXPECT_EQ(a <=> Symbol{ "symbol_test_ordered_a"sv }, std::strong_ordering::equal);
+	}
+
+	TEST_F(SymbolTest, Concurrent)
+	{
+		static constexpr std::size_t k_thread_count = 4;
+		static constexpr std::size_t k_name_count   = 512;
+
+		std::vector<std::vector<Symbol>> symbols(k_thread_count);
+		{
+			std::vector<std::jthread> threads;
+			for (std::size_t thread = 0; thread < k_thread_count; ++thread) {
+				threads.emplace_back([&symbols, thread] {
+					for (std::size_t index = 0; index < k_name_count; ++index) {
+						symbols[thread].emplace_back("symbol_test_concurrent_" + std::to_string(index));
+					}
+				});
+			}
+		}
+
+		for (std::size_t index = 0; index < k_name_count; ++index) {
+			EXPECT_EQ(symbols[0][index].view(), "symbol_test_concurrent_" + std::to_string(index));
+			for (std::size_t thread = 1; thread < k_thread_count; ++thread) {
+				EXPECT_EQ(symbols[0][index], symbols[thread][index]);
+			}
+		}
+	}
+}  // namespace soul::ut
@@ -0,0 +1,113 @@
+#include "compiler/compilation_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "ast/visitors/compare.h"
+#include "ast/visitors/serialize.h"
+#include "fixtures.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace soul::compiler::ut
+{
+	using namespace soul::ast;
+	using namespace soul::ast::visitors;
+	using namespace std::string_view_literals;
+
+	class CompilationCacheTest : public soul::ut::ModuleFixture
+	{
+		protected:
+		std::filesystem::path _directory = std::filesystem::temp_directory_path() / "soul_compilation_cache_test";
+
+		protected:
+		void SetUp() override { std::filesystem::remove_all(_directory); }
+		void TearDown() override { std::filesystem::remove_all(_directory); }
+	};
+
+	TEST_F(CompilationCacheTest, Compile_StoresAndLoads)
+	{
+		CompilationCache cache{ _directory };
+		const auto       source = SourceBuffer::from_string(std::string(k_script));
+
+		ASSERT_FALSE(cache.load("cache_module", source));
+		const auto compiled = cache.compile("cache_module", source);
+		ASSERT_TRUE(compiled);
+		EXPECT_TRUE(std::filesystem::exists(cache.entry_path(k_script)));
+
+		const auto loaded = cache.load("other_module", source);
+		ASSERT_TRUE(loaded);
+		ASSERT_TRUE(loaded->is<ModuleNode>());
+		EXPECT_EQ(loaded->as<ModuleNode>().name, "other_module");
+		EXPECT_EQ(loaded->as<ModuleNode>().source, source);
+
+		loaded->as<ModuleNode>().name = "cache_module";
+		EXPECT_TRUE(CompareVisitor(compiled.get(), loaded.get()));
+		EXPECT_EQ(stringify(compiled.get()), stringify(loaded.get()));
+	}
+
+	TEST_F(CompilationCacheTest, Load_ModifiedScript)
+	{
+		CompilationCache cache{ _directory };
+		std::ignore = cache.compile("cache_module", SourceBuffer::from_string(std::string(k_script)));
+
+		auto modified_script = std::string(k_script);
+		modified_script.back() = ' ';
+		EXPECT_NE(cache.entry_path(k_script), cache.entry_path(modified_script));
+		EXPECT_FALSE(cache.load("cache_module", SourceBuffer::from_string(std::move(modified_script))));
+	}
+
+	TEST_F(CompilationCacheTest, Load_CollidingEntry)
+	{
+		CompilationCache cache{ _directory };
+		std::ignore = cache.compile("cache_module", SourceBuffer::from_string(std::string(k_script)));
+
+		// Script of the same size, whose entry (e.g. due to colliding hashes) belongs to the other script.
+		auto other_script = std::string(k_script);
+		other_script[1]   = '#';
+		std::filesystem::copy_file(cache.entry_path(k_script), cache.entry_path(other_script));
+		EXPECT_FALSE(cache.load("cache_module", SourceBuffer::from_string(std::move(other_script))));
+	}
+
+	TEST_F(CompilationCacheTest, Store_TooDeep)
+	{
+		auto expression = LiteralNode::create(Value{ i64{ 1 } }, LiteralNode::Type::Int64);
+		for (std::size_t depth = 0; depth <= SerializeVisitor::k_max_depth; ++depth) {
+			expression = UnaryNode::create(std::move(expression), ASTNode::Operator::Sub);
+		}
+		ASTNode::Dependencies statements{};
+		statements.emplace_back(std::move(expression));
+		const auto module = ModuleNode::create("cache_module", std::move(statements));
+
+		CompilationCache cache{ _directory };
+		EXPECT_FALSE(cache.store(module.get(), "deep"sv));
+		EXPECT_FALSE(std::filesystem::exists(cache.entry_path("deep"sv)));
+	}
+
+	TEST_F(CompilationCacheTest, Load_CorruptedEntry)
+	{
+		CompilationCache cache{ _directory };
+		const auto       source   = SourceBuffer::from_string(std::string(k_script));
+		const auto       compiled = cache.compile("cache_module", source);
+
+		const auto entry_size = std::filesystem::file_size(cache.entry_path(k_script));
+		std::filesystem::resize_file(cache.entry_path(k_script), entry_size - 1);
+		EXPECT_FALSE(cache.load("cache_module", source));
+
+		// Compiling falls back to the whole pipeline, which replaces the corrupted entry.
+		const auto recompiled = cache.compile("cache_module", source);
+		EXPECT_EQ(stringify(compiled.get()), stringify(recompiled.get()));
+		EXPECT_EQ(std::filesystem::file_size(cache.entry_path(k_script)), entry_size);
+		EXPECT_TRUE(cache.load("cache_module", source));
+	}
+
+	TEST_F(CompilationCacheTest, Compile_InvalidScriptIsNotStored)
+	{
+		static constexpr auto k_invalid_script = "fn main() :: i32 { return unknown_variable; }"sv;
+
+		CompilationCache cache{ _directory };
+		std::ignore = cache.compile("cache_module", SourceBuffer::from_string(std::string(k_invalid_script)));
+		EXPECT_FALSE(std::filesystem::exists(cache.entry_path(k_invalid_script)));
+	}
+}  // namespace soul::compiler::ut
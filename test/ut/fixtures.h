@@ -0,0 +1,73 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "ast/ast.h"
+#include "ast/visitors/default_traverse.h"
+#include "ast/visitors/stringify.h"
+#include "common/source_buffer.h"
+#include "parser/parser.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace soul::ut
+{
+	/**
+	 * @brief Records the kinds of the visited nodes, in order, and counts the literals among them.
+	 */
+	class RecorderVisitor final : public ast::visitors::DefaultTraverseVisitor
+	{
+		public:
+		std::vector<ast::ASTNode::Kind> kinds{};
+		std::size_t                     literals = 0;
+
+		void accept(ast::ASTNode::Reference node) override
+		{
+			if (node) {
+				kinds.push_back(node->kind());
+			}
+			DefaultTraverseVisitor::accept(node);
+		}
+
+		protected:
+		using DefaultTraverseVisitor::visit;
+		void visit(const ast::LiteralNode&) override { ++literals; }
+	};
+
+	/**
+	 * @brief Base fixture of the tests, which operate on parsed modules.
+	 */
+	class ModuleFixture : public ::testing::Test
+	{
+		protected:
+		/** @brief Script, which exercises most of the (non-erroneous) nodes; its types can be resolved as well. */
+		static constexpr std::string_view k_script = R"(
+			struct point { x: f64, y: f64 }
+			fn call(lhs: i32, rhs: i32) :: i32 { return lhs + rhs; }
+			fn main(a: i32) :: i32 {
+				let mut sum: i32 = 0;
+				for (i: i32 = 0; i < 10; i += 1) { sum += i; continue; };
+				while (sum > 0) { sum -= 1; break; };
+				if (sum < 1) { return call(sum, cast<i32>(sum)); } else { return a; };
+				return 123;
+			}
+		)";
+
+		/** @brief Parses a given script into a module. */
+		static ast::ASTNode::Dependency parse(std::string_view script = k_script)
+		{
+			return parser::Parser::parse("test_module", SourceBuffer::from_string(std::string(script)));
+		}
+
+		/** @brief Returns the (sub-) tree stringified alongside its types. */
+		static std::string stringify(ast::ASTNode::Reference root)
+		{
+			ast::visitors::StringifyVisitor stringify_visitor{ ast::visitors::StringifyVisitor::Options::PrintTypes };
+			stringify_visitor.accept(root);
+			return stringify_visitor.string();
+		}
+	};
+}  // namespace soul::ut
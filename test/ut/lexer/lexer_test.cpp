@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include "common/symbol.h"
 #include "lexer/lexer.h"
 
 #include <array>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <utility>
 
 namespace soul::lexer::ut
 {
@@ -25,15 +29,15 @@ namespace soul::lexer::ut
 		const auto            result_tokens  = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::LiteralIdentifier, "my_identifier"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::LiteralIdentifier, "invalid_variable"sv, SourceLocation{ 1, 14 }),
-			Token(Token::Type::LiteralIdentifier, "this_should_work"sv, SourceLocation{ 1, 32 }),
+			Token(Token::Type::LiteralIdentifier, "my_identifier"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "invalid_variable"sv, 14),
+			Token(Token::Type::LiteralIdentifier, "this_should_work"sv, 32),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, k_expected_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, k_expected_tokens[index].offset);
 		}
 	}
 
@@ -44,30 +48,70 @@ namespace soul::lexer::ut
 		const auto result_tokens = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::KeywordBreak, "break"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::KeywordCast, "cast"sv, SourceLocation{ 1, 6 }),
-			Token(Token::Type::KeywordContinue, "continue"sv, SourceLocation{ 1, 11 }),
-			Token(Token::Type::KeywordElse, "else"sv, SourceLocation{ 1, 20 }),
-			Token(Token::Type::KeywordFalse, "false"sv, SourceLocation{ 1, 25 }),
-			Token(Token::Type::KeywordFn, "fn"sv, SourceLocation{ 1, 31 }),
-			Token(Token::Type::KeywordFor, "for"sv, SourceLocation{ 1, 34 }),
-			Token(Token::Type::KeywordIf, "if"sv, SourceLocation{ 1, 38 }),
-			Token(Token::Type::KeywordLet, "let"sv, SourceLocation{ 1, 41 }),
-			Token(Token::Type::KeywordMut, "mut"sv, SourceLocation{ 1, 45 }),
-			Token(Token::Type::KeywordNative, "native"sv, SourceLocation{ 1, 49 }),
-			Token(Token::Type::KeywordReturn, "return"sv, SourceLocation{ 1, 56 }),
-			Token(Token::Type::KeywordStruct, "struct"sv, SourceLocation{ 1, 63 }),
-			Token(Token::Type::KeywordTrue, "true"sv, SourceLocation{ 1, 70 }),
-			Token(Token::Type::KeywordWhile, "while"sv, SourceLocation{ 1, 75 }),
+			Token(Token::Type::KeywordBreak, "break"sv, 0),
+			Token(Token::Type::KeywordCast, "cast"sv, 6),
+			Token(Token::Type::KeywordContinue, "continue"sv, 11),
+			Token(Token::Type::KeywordElse, "else"sv, 20),
+			Token(Token::Type::KeywordFalse, "false"sv, 25),
+			Token(Token::Type::KeywordFn, "fn"sv, 31),
+			Token(Token::Type::KeywordFor, "for"sv, 34),
+			Token(Token::Type::KeywordIf, "if"sv, 38),
+			Token(Token::Type::KeywordLet, "let"sv, 41),
+			Token(Token::Type::KeywordMut, "mut"sv, 45),
+			Token(Token::Type::KeywordNative, "native"sv, 49),
+			Token(Token::Type::KeywordReturn, "return"sv, 56),
+			Token(Token::Type::KeywordStruct, "struct"sv, 63),
+			Token(Token::Type::KeywordTrue, "true"sv, 70),
+			Token(Token::Type::KeywordWhile, "while"sv, 75),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 
+	TEST_F(LexerTest, Literals_KeywordLookalikes)
+	{
+		static constexpr auto k_input_string = "breaks fo iff Let mutable i16 f128 structs whilst e r _if"sv;
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::LiteralIdentifier, "breaks"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "fo"sv, 7),
+			Token(Token::Type::LiteralIdentifier, "iff"sv, 10),
+			Token(Token::Type::LiteralIdentifier, "Let"sv, 14),
+			Token(Token::Type::LiteralIdentifier, "mutable"sv, 18),
+			Token(Token::Type::LiteralIdentifier, "i16"sv, 26),
+			Token(Token::Type::LiteralIdentifier, "f128"sv, 30),
+			Token(Token::Type::LiteralIdentifier, "structs"sv, 35),
+			Token(Token::Type::LiteralIdentifier, "whilst"sv, 43),
+			Token(Token::Type::LiteralIdentifier, "e"sv, 50),
+			Token(Token::Type::LiteralIdentifier, "r"sv, 52),
+			Token(Token::Type::LiteralIdentifier, "_if"sv, 54),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
+	}
+
+	TEST_F(LexerTest, Literals_IdentifiersAreNotInterned)
+	{
+		static constexpr auto k_input_string = "lexer_test_first let lexer_test_second lexer_test_first"sv;
+		const auto            count          = Symbol::count();
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		// Identifiers are interned by the Parser, once (and if) these make it into the AST.
+		ASSERT_EQ(result_tokens.size(), 4);
+		EXPECT_EQ(result_tokens[0].data, "lexer_test_first"sv);
+		EXPECT_EQ(result_tokens[2].data, "lexer_test_second"sv);
+		EXPECT_EQ(Symbol::count(), count);
+	}
+
 	TEST_F(LexerTest, SpecialCharacters)
 	{
 		static constexpr auto k_input_string
@@ -75,49 +119,77 @@ namespace soul::lexer::ut
 		const auto result_tokens = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::SymbolAmpersand, "&"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::SymbolAmpersandAmpersand, "&&"sv, SourceLocation{ 1, 2 }),
-			Token(Token::Type::SymbolBang, "!"sv, SourceLocation{ 1, 5 }),
-			Token(Token::Type::SymbolBangEqual, "!="sv, SourceLocation{ 1, 7 }),
-			Token(Token::Type::SymbolBraceLeft, "{"sv, SourceLocation{ 1, 10 }),
-			Token(Token::Type::SymbolBraceRight, "}"sv, SourceLocation{ 1, 12 }),
-			Token(Token::Type::SymbolBracketLeft, "["sv, SourceLocation{ 1, 14 }),
-			Token(Token::Type::SymbolBracketRight, "]"sv, SourceLocation{ 1, 16 }),
-			Token(Token::Type::SymbolCaret, "^"sv, SourceLocation{ 1, 18 }),
-			Token(Token::Type::SymbolColon, ":"sv, SourceLocation{ 1, 20 }),
-			Token(Token::Type::SymbolColonColon, "::"sv, SourceLocation{ 1, 22 }),
-			Token(Token::Type::SymbolComma, ","sv, SourceLocation{ 1, 25 }),
-			Token(Token::Type::SymbolDot, "."sv, SourceLocation{ 1, 27 }),
-			Token(Token::Type::SymbolEqual, "="sv, SourceLocation{ 1, 29 }),
-			Token(Token::Type::SymbolEqualEqual, "=="sv, SourceLocation{ 1, 31 }),
-			Token(Token::Type::SymbolGreater, ">"sv, SourceLocation{ 1, 34 }),
-			Token(Token::Type::SymbolGreaterEqual, ">="sv, SourceLocation{ 1, 36 }),
-			Token(Token::Type::SymbolLess, "<"sv, SourceLocation{ 1, 39 }),
-			Token(Token::Type::SymbolLessEqual, "<="sv, SourceLocation{ 1, 41 }),
-			Token(Token::Type::SymbolMinus, "-"sv, SourceLocation{ 1, 44 }),
-			Token(Token::Type::SymbolMinusEqual, "-="sv, SourceLocation{ 1, 46 }),
-			Token(Token::Type::SymbolMinusMinus, "--"sv, SourceLocation{ 1, 49 }),
-			Token(Token::Type::SymbolPercent, "%"sv, SourceLocation{ 1, 52 }),
-			Token(Token::Type::SymbolPercentEqual, "%="sv, SourceLocation{ 1, 54 }),
-			Token(Token::Type::SymbolParenLeft, "("sv, SourceLocation{ 1, 57 }),
-			Token(Token::Type::SymbolParenRight, ")"sv, SourceLocation{ 1, 59 }),
-			Token(Token::Type::SymbolPipe, "|"sv, SourceLocation{ 1, 61 }),
-			Token(Token::Type::SymbolPipePipe, "||"sv, SourceLocation{ 1, 63 }),
-			Token(Token::Type::SymbolPlus, "+"sv, SourceLocation{ 1, 66 }),
-			Token(Token::Type::SymbolPlusEqual, "+="sv, SourceLocation{ 1, 68 }),
-			Token(Token::Type::SymbolPlusPlus, "++"sv, SourceLocation{ 1, 71 }),
-			Token(Token::Type::SymbolQuestionMark, "?"sv, SourceLocation{ 1, 74 }),
-			Token(Token::Type::SymbolSemicolon, ";"sv, SourceLocation{ 1, 76 }),
-			Token(Token::Type::SymbolSlash, "/"sv, SourceLocation{ 1, 78 }),
-			Token(Token::Type::SymbolSlashEqual, "/="sv, SourceLocation{ 1, 80 }),
-			Token(Token::Type::SymbolStar, "*"sv, SourceLocation{ 1, 83 }),
-			Token(Token::Type::SymbolStarEqual, "*="sv, SourceLocation{ 1, 85 }),
+			Token(Token::Type::SymbolAmpersand, "&"sv, 0),
+			Token(Token::Type::SymbolAmpersandAmpersand, "&&"sv, 2),
+			Token(Token::Type::SymbolBang, "!"sv, 5),
+			Token(Token::Type::SymbolBangEqual, "!="sv, 7),
+			Token(Token::Type::SymbolBraceLeft, "{"sv, 10),
+			Token(Token::Type::SymbolBraceRight, "}"sv, 12),
+			Token(Token::Type::SymbolBracketLeft, "["sv, 14),
+			Token(Token::Type::SymbolBracketRight, "]"sv, 16),
+			Token(Token::Type::SymbolCaret, "^"sv, 18),
+			Token(Token::Type::SymbolColon, ":"sv, 20),
+			Token(Token::Type::SymbolColonColon, "::"sv, 22),
+			Token(Token::Type::SymbolComma, ","sv, 25),
+			Token(Token::Type::SymbolDot, "."sv, 27),
+			Token(Token::Type::SymbolEqual, "="sv, 29),
+			Token(Token::Type::SymbolEqualEqual, "=="sv, 31),
+			Token(Token::Type::SymbolGreater, ">"sv, 34),
+			Token(Token::Type::SymbolGreaterEqual, ">="sv, 36),
+			Token(Token::Type::SymbolLess, "<"sv, 39),
+			Token(Token::Type::SymbolLessEqual, "<="sv, 41),
+			Token(Token::Type::SymbolMinus, "-"sv, 44),
+			Token(Token::Type::SymbolMinusEqual, "-="sv, 46),
+			Token(Token::Type::SymbolMinusMinus, "--"sv, 49),
+			Token(Token::Type::SymbolPercent, "%"sv, 52),
+			Token(Token::Type::SymbolPercentEqual, "%="sv, 54),
+			Token(Token::Type::SymbolParenLeft, "("sv, 57),
+			Token(Token::Type::SymbolParenRight, ")"sv, 59),
+			Token(Token::Type::SymbolPipe, "|"sv, 61),
+			Token(Token::Type::SymbolPipePipe, "||"sv, 63),
+			Token(Token::Type::SymbolPlus, "+"sv, 66),
+			Token(Token::Type::SymbolPlusEqual, "+="sv, 68),
+			Token(Token::Type::SymbolPlusPlus, "++"sv, 71),
+			Token(Token::Type::SymbolQuestionMark, "?"sv, 74),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 76),
+			Token(Token::Type::SymbolSlash, "/"sv, 78),
+			Token(Token::Type::SymbolSlashEqual, "/="sv, 80),
+			Token(Token::Type::SymbolStar, "*"sv, 83),
+			Token(Token::Type::SymbolStarEqual, "*="sv, 85),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
+	}
+
+	TEST_F(LexerTest, SpecialCharacters_LongestMatch)
+	{
+		static constexpr auto k_input_string = "+++=:::===!==&&&||| @"sv;
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::SymbolPlusPlus, "++"sv, 0),
+			Token(Token::Type::SymbolPlusEqual, "+="sv, 2),
+			Token(Token::Type::SymbolColonColon, "::"sv, 4),
+			Token(Token::Type::SymbolColon, ":"sv, 6),
+			Token(Token::Type::SymbolEqualEqual, "=="sv, 7),
+			Token(Token::Type::SymbolEqual, "="sv, 9),
+			Token(Token::Type::SymbolBangEqual, "!="sv, 10),
+			Token(Token::Type::SymbolEqual, "="sv, 12),
+			Token(Token::Type::SymbolAmpersandAmpersand, "&&"sv, 13),
+			Token(Token::Type::SymbolAmpersand, "&"sv, 15),
+			Token(Token::Type::SymbolPipePipe, "||"sv, 16),
+			Token(Token::Type::SymbolPipe, "|"sv, 18),
+			Token(Token::Type::SpecialError, "unrecognized token"sv, 20),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 
@@ -128,26 +200,62 @@ namespace soul::lexer::ut
 		const auto result_tokens = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::LiteralFloat, "0.0"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::LiteralFloat, "7.52"sv, SourceLocation{ 1, 4 }),
-			Token(Token::Type::LiteralInteger, "4098"sv, SourceLocation{ 1, 9 }),
-			Token(Token::Type::LiteralFloat, "4098.0"sv, SourceLocation{ 1, 14 }),
-			Token(Token::Type::LiteralFloat, "-8192.32"sv, SourceLocation{ 1, 21 }),
-			Token(Token::Type::LiteralFloat, "1000000000000.0"sv, SourceLocation{ 1, 30 }),
-			Token(Token::Type::LiteralInteger, "0"sv, SourceLocation{ 1, 46 }),
-			Token(Token::Type::LiteralInteger, "54"sv, SourceLocation{ 1, 48 }),
-			Token(Token::Type::LiteralInteger, "1024"sv, SourceLocation{ 1, 51 }),
-			Token(Token::Type::LiteralFloat, "-0.01"sv, SourceLocation{ 1, 56 }),
-			Token(Token::Type::LiteralFloat, "5.47"sv, SourceLocation{ 1, 62 }),
-			Token(Token::Type::LiteralInteger, "-8192"sv, SourceLocation{ 1, 67 }),
-			Token(Token::Type::LiteralInteger, "1000000000000"sv, SourceLocation{ 1, 73 }),
+			Token(Token::Type::LiteralFloat, "0.0"sv, 0),
+			Token(Token::Type::LiteralFloat, "7.52"sv, 4),
+			Token(Token::Type::LiteralInteger, "4098"sv, 9),
+			Token(Token::Type::LiteralFloat, "4098.0"sv, 14),
+			Token(Token::Type::LiteralFloat, "-8192.32"sv, 21),
+			Token(Token::Type::LiteralFloat, "1000000000000.0"sv, 30),
+			Token(Token::Type::LiteralInteger, "0"sv, 46),
+			Token(Token::Type::LiteralInteger, "54"sv, 48),
+			Token(Token::Type::LiteralInteger, "1024"sv, 51),
+			Token(Token::Type::LiteralFloat, "-0.01"sv, 56),
+			Token(Token::Type::LiteralFloat, "5.47"sv, 62),
+			Token(Token::Type::LiteralInteger, "-8192"sv, 67),
+			Token(Token::Type::LiteralInteger, "1000000000000"sv, 73),
+		};
+		static constexpr std::array k_expected_values
+			= { 0.0, 7.52, 4098.0, 4098.0, -8192.32, 1000000000000.0, 0.0, 54.0, 1024.0, -0.01, 5.47, -8192.0, 1e12 };
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+			if (result_tokens[index].type == Token::Type::LiteralInteger) {
+				EXPECT_EQ(static_cast<i64>(k_expected_values[index]), result_tokens[index].integer);
+			} else {
+				EXPECT_DOUBLE_EQ(k_expected_values[index], result_tokens[index].floating);
+			}
+		}
+	}
+
+	TEST_F(LexerTest, Literals_NumbersSyntax)
+	{
+		static constexpr auto k_input_string = "+5 1-2 3.x 4. 9223372036854775807 9223372036854775808"sv;
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		// Signs are part of a number only at its start and a decimal point only if followed by a digit.
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::LiteralInteger, "+5"sv, 0),
+			Token(Token::Type::LiteralInteger, "1"sv, 3),
+			Token(Token::Type::LiteralInteger, "-2"sv, 4),
+			Token(Token::Type::LiteralInteger, "3"sv, 7),
+			Token(Token::Type::SymbolDot, "."sv, 8),
+			Token(Token::Type::LiteralIdentifier, "x"sv, 9),
+			Token(Token::Type::LiteralInteger, "4"sv, 11),
+			Token(Token::Type::SymbolDot, "."sv, 12),
+			Token(Token::Type::LiteralInteger, "9223372036854775807"sv, 14),
+			Token(Token::Type::SpecialError, "integer literal is out of range"sv, 34),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
+		EXPECT_EQ(5, result_tokens[0].integer);
+		EXPECT_EQ(-2, result_tokens[2].integer);
+		EXPECT_EQ(std::numeric_limits<i64>::max(), result_tokens[8].integer);
 	}
 
 	TEST_F(LexerTest, Literals_Strings)
@@ -156,15 +264,15 @@ namespace soul::lexer::ut
 		const auto            result_tokens  = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::LiteralString, "my_value"sv, SourceLocation{ 1, 2 }),
-			Token(Token::Type::LiteralString, "no space after previous one"sv, SourceLocation{ 1, 12 }),
-			Token(Token::Type::LiteralString, "520"sv, SourceLocation{ 1, 42 }),
+			Token(Token::Type::LiteralString, "my_value"sv, 0),
+			Token(Token::Type::LiteralString, "no space after previous one"sv, 10),
+			Token(Token::Type::LiteralString, "520"sv, 40),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 
@@ -177,7 +285,51 @@ namespace soul::lexer::ut
 		EXPECT_EQ(result_tokens[0],
 		          Token(Token::Type::SpecialError,
 		                "unterminated string literal; did you forget '\"'?",
-		                SourceLocation{ 1, 0 }));
+		                0));
+	}
+
+	TEST_F(LexerTest, Literals_Unicode)
+	{
+		static constexpr auto k_input_string = "let zażółć = \"héllo, 世界\";\n"
+		                                       "\"aaaaaaaaaaaaaaaaaaaaaaaaébbbbbbbbbbbbbbbbbbbbbbbb\""sv;
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		// Offsets are in bytes, not characters.
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::KeywordLet, "let"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "zażółć"sv, 4),
+			Token(Token::Type::SymbolEqual, "="sv, 15),
+			Token(Token::Type::LiteralString, "héllo, 世界"sv, 17),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 33),
+			Token(Token::Type::LiteralString, "aaaaaaaaaaaaaaaaaaaaaaaaébbbbbbbbbbbbbbbbbbbbbbbb"sv, 35),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
+	}
+
+	TEST_F(LexerTest, Literals_Unicode_InvalidSequences)
+	{
+		// Stray byte, overlong encoding of '/' and an encoded surrogate.
+		static constexpr auto k_input_string = "ab\xFF" "cd \"x\xC0\xAF" "y\" \"\xED\xA0\x80\""sv;
+		const auto            result_tokens  = Lexer::tokenize(k_input_string);
+
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::LiteralIdentifier, "ab"sv, 0),
+			Token(Token::Type::SpecialError, "invalid UTF-8 sequence"sv, 2),
+			Token(Token::Type::LiteralIdentifier, "cd"sv, 3),
+			Token(Token::Type::SpecialError, "string literal is not a valid UTF-8 sequence"sv, 6),
+			Token(Token::Type::SpecialError, "string literal is not a valid UTF-8 sequence"sv, 13),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
 	}
 
 	TEST_F(LexerTest, Compressed)
@@ -186,19 +338,19 @@ namespace soul::lexer::ut
 		const auto            result_tokens  = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::KeywordLet, "let"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::LiteralIdentifier, "variable"sv, SourceLocation{ 1, 4 }),
-			Token(Token::Type::SymbolColon, ":"sv, SourceLocation{ 1, 12 }),
-			Token(Token::Type::LiteralIdentifier, "int"sv, SourceLocation{ 1, 13 }),
-			Token(Token::Type::SymbolEqual, "="sv, SourceLocation{ 1, 16 }),
-			Token(Token::Type::LiteralInteger, "320"sv, SourceLocation{ 1, 17 }),
-			Token(Token::Type::SymbolSemicolon, ";"sv, SourceLocation{ 1, 20 }),
+			Token(Token::Type::KeywordLet, "let"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "variable"sv, 4),
+			Token(Token::Type::SymbolColon, ":"sv, 12),
+			Token(Token::Type::LiteralIdentifier, "int"sv, 13),
+			Token(Token::Type::SymbolEqual, "="sv, 16),
+			Token(Token::Type::LiteralInteger, "320"sv, 17),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 20),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 
@@ -209,33 +361,33 @@ namespace soul::lexer::ut
 		const auto result_tokens = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::KeywordFn, "fn"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::LiteralIdentifier, "main"sv, SourceLocation{ 1, 3 }),
-			Token(Token::Type::SymbolParenLeft, "("sv, SourceLocation{ 1, 7 }),
-			Token(Token::Type::LiteralIdentifier, "some_var"sv, SourceLocation{ 1, 8 }),
-			Token(Token::Type::SymbolColon, ":"sv, SourceLocation{ 1, 17 }),
-			Token(Token::Type::LiteralIdentifier, "int"sv, SourceLocation{ 1, 19 }),
-			Token(Token::Type::SymbolParenRight, ")"sv, SourceLocation{ 1, 22 }),
-			Token(Token::Type::SymbolColonColon, "::"sv, SourceLocation{ 1, 24 }),
-			Token(Token::Type::LiteralIdentifier, "void"sv, SourceLocation{ 1, 27 }),
-			Token(Token::Type::SymbolBraceLeft, "{"sv, SourceLocation{ 1, 32 }),
-			Token(Token::Type::KeywordLet, "let"sv, SourceLocation{ 2, 1 }),
-			Token(Token::Type::LiteralIdentifier, "my_variable"sv, SourceLocation{ 2, 5 }),
-			Token(Token::Type::SymbolColon, ":"sv, SourceLocation{ 2, 17 }),
-			Token(Token::Type::LiteralIdentifier, "str"sv, SourceLocation{ 2, 19 }),
-			Token(Token::Type::SymbolEqual, "="sv, SourceLocation{ 2, 23 }),
-			Token(Token::Type::LiteralString, "my_string"sv, SourceLocation{ 2, 27 }),
-			Token(Token::Type::SymbolSemicolon, ";"sv, SourceLocation{ 2, 36 }),
-			Token(Token::Type::KeywordReturn, "return"sv, SourceLocation{ 3, 1 }),
-			Token(Token::Type::LiteralInteger, "0"sv, SourceLocation{ 3, 8 }),
-			Token(Token::Type::SymbolSemicolon, ";"sv, SourceLocation{ 3, 9 }),
-			Token(Token::Type::SymbolBraceRight, "}"sv, SourceLocation{ 4, 0 }),
+			Token(Token::Type::KeywordFn, "fn"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "main"sv, 3),
+			Token(Token::Type::SymbolParenLeft, "("sv, 7),
+			Token(Token::Type::LiteralIdentifier, "some_var"sv, 8),
+			Token(Token::Type::SymbolColon, ":"sv, 17),
+			Token(Token::Type::LiteralIdentifier, "int"sv, 19),
+			Token(Token::Type::SymbolParenRight, ")"sv, 22),
+			Token(Token::Type::SymbolColonColon, "::"sv, 24),
+			Token(Token::Type::LiteralIdentifier, "void"sv, 27),
+			Token(Token::Type::SymbolBraceLeft, "{"sv, 32),
+			Token(Token::Type::KeywordLet, "let"sv, 36),
+			Token(Token::Type::LiteralIdentifier, "my_variable"sv, 40),
+			Token(Token::Type::SymbolColon, ":"sv, 52),
+			Token(Token::Type::LiteralIdentifier, "str"sv, 54),
+			Token(Token::Type::SymbolEqual, "="sv, 58),
+			Token(Token::Type::LiteralString, "my_string"sv, 60),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 71),
+			Token(Token::Type::KeywordReturn, "return"sv, 74),
+			Token(Token::Type::LiteralInteger, "0"sv, 81),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 82),
+			Token(Token::Type::SymbolBraceRight, "}"sv, 84),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 
@@ -252,15 +404,146 @@ namespace soul::lexer::ut
 		const auto            result_tokens  = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::SymbolSemicolon, ";"sv, SourceLocation{ 1, 1 }),
-			Token(Token::Type::SymbolPlus, "+"sv, SourceLocation{ 3, 0 }),
-			Token(Token::Type::SymbolPlusEqual, "+="sv, SourceLocation{ 4, 0 }),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 1),
+			Token(Token::Type::SymbolPlus, "+"sv, 4),
+			Token(Token::Type::SymbolPlusEqual, "+="sv, 26),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
+	}
+
+	TEST_F(LexerTest, LongWhitespacesAndComments)
+	{
+		// Runs long enough to span multiple blocks when scanned with SIMD instructions.
+		const auto input_string = "#" + std::string(70, '=') + "\n" + std::string(40, ' ') + "let\n\n"
+		                        + std::string(20, '\t') + "mut" + std::string(33, ' ')
+		                        + "# this comment spans multiple blocks as well, even with a \t tab inside\r;";
+		const auto result_tokens = Lexer::tokenize(input_string);
+
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::KeywordLet, "let"sv, 112),
+			Token(Token::Type::KeywordMut, "mut"sv, 137),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 244),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
+		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
+		}
+	}
+
+	TEST_F(LexerTest, Parallel)
+	{
+		std::string input_string;
+		for (std::size_t index = 0; index < 64; ++index) {
+			input_string += "# comment with a \"quote and # hash\n";
+			input_string += "let string_" + std::to_string(index) + ": str = \"multi\nline # \r string\";\n";
+			input_string += "\tlet value: f32 = -" + std::to_string(index) + ".5;\f\r\n";
+			input_string += "if (value >= 2) { value += 1; } # trailing \"comment\"\n";
+		}
+		input_string += "let unterminated = \"string\n;\n";
+
+		const auto expected_tokens = Lexer::tokenize(input_string);
+		for (const auto thread_count : { 2UZ, 3UZ, 8UZ }) {
+			const auto result_tokens = Lexer::tokenize_parallel(input_string, thread_count, 16);
+			ASSERT_EQ(expected_tokens.size(), result_tokens.size());
+			for (size_t index = 0; index < expected_tokens.size(); ++index) {
+				EXPECT_EQ(expected_tokens[index], result_tokens[index]);
+				EXPECT_EQ(expected_tokens[index].offset, result_tokens[index].offset);
+			}
+		}
+	}
+
+	TEST_F(LexerTest, Relex)
+	{
+		static constexpr auto k_input_string
+			= "fn main() :: void\n{\n\tlet a: i32 = -5; # comment\n\tlet b: str = \"text\";\n\ta += 2.5;\n}"sv;
+
+		struct TestCase
+		{
+			TextEdit    edit;
+			std::size_t max_removed;
+		};
+		const std::array k_test_cases = {
+			TestCase{ TextEdit{ .offset = 7, .length = 0, .replacement = "_name"sv }, 3 },    // Extends identifier.
+			TestCase{ TextEdit{ .offset = 36, .length = 0, .replacement = "1"sv }, 3 },       // Extends number.
+			TestCase{ TextEdit{ .offset = 35, .length = 0, .replacement = " "sv }, 3 },       // Splits sign and number.
+			TestCase{ TextEdit{ .offset = 38, .length = 1, .replacement = ";"sv }, 3 },       // Uncomments.
+			TestCase{ TextEdit{ .offset = 21, .length = 0, .replacement = "# "sv }, 64 },    // Comments out.
+			TestCase{ TextEdit{ .offset = 62, .length = 1, .replacement = ""sv }, 64 },      // Unterminates string.
+			TestCase{ TextEdit{ .offset = 17, .length = 1, .replacement = "\n\n"sv }, 2 },  // Changes whitespace.
+			TestCase{ TextEdit{ .offset = 0, .length = 0, .replacement = "let "sv }, 2 },     // Prepends.
+			TestCase{ TextEdit{ .offset = 82, .length = 0, .replacement = " x"sv }, 2 },      // Appends.
+			TestCase{ TextEdit{ .offset = 0, .length = 82, .replacement = ""sv }, 64 },      // Clears.
+		};
+
+		const auto previous_tokens = Lexer::tokenize(k_input_string);
+		ASSERT_EQ(k_input_string.size(), 82);
+		for (const auto& [edit, max_removed] : k_test_cases) {
+			auto input_string = std::string(k_input_string);
+			input_string.replace(edit.offset, edit.length, edit.replacement);
+			const auto expected_tokens = Lexer::tokenize(input_string);
+
+			const auto delta = Lexer::relex(previous_tokens, input_string, edit);
+			EXPECT_LE(delta.removed, max_removed) << input_string;
+
+			auto result_tokens = previous_tokens;
+			delta.apply(result_tokens, input_string);
+			ASSERT_EQ(expected_tokens.size(), result_tokens.size()) << input_string;
+			for (size_t index = 0; index < expected_tokens.size(); ++index) {
+				EXPECT_EQ(expected_tokens[index], result_tokens[index]) << input_string;
+				EXPECT_EQ(expected_tokens[index].offset, result_tokens[index].offset) << input_string;
+				EXPECT_EQ(expected_tokens[index].data.data(), result_tokens[index].data.data()) << input_string;
+			}
+		}
+
+		// Edits preceding the first token.
+		const std::array k_leading_test_cases = {
+			std::pair{ " foo"sv, TextEdit{ .offset = 0, .length = 0, .replacement = "x"sv } },
+			std::pair{ "  foo"sv, TextEdit{ .offset = 1, .length = 1, .replacement = "x "sv } },
+			std::pair{ "# comment\nfoo"sv, TextEdit{ .offset = 0, .length = 1, .replacement = ""sv } },
+			std::pair{ "# comment\nfoo"sv, TextEdit{ .offset = 9, .length = 1, .replacement = " "sv } },
+		};
+		for (const auto& [script, edit] : k_leading_test_cases) {
+			const auto previous_leading_tokens = Lexer::tokenize(script);
+			auto       input_string            = std::string(script);
+			input_string.replace(edit.offset, edit.length, edit.replacement);
+			const auto expected_tokens = Lexer::tokenize(input_string);
+
+			auto result_tokens = previous_leading_tokens;
+			Lexer::relex(previous_leading_tokens, input_string, edit).apply(result_tokens, input_string);
+			ASSERT_EQ(expected_tokens.size(), result_tokens.size()) << input_string;
+			for (size_t index = 0; index < expected_tokens.size(); ++index) {
+				EXPECT_EQ(expected_tokens[index], result_tokens[index]) << input_string;
+				EXPECT_EQ(expected_tokens[index].offset, result_tokens[index].offset) << input_string;
+			}
+		}
+	}
+
+	TEST_F(LexerTest, Relex_Typing)
+	{
+		// Types the script one character at a time, which passes through plenty of invalid intermediate states.
+		static constexpr auto k_input_string
+			= "fn main() :: void {\n\tlet a: str = \"text # not a comment\";\n\ta -= -2.5; # comment\n\t$\n}\n"sv;
+
+		std::string        input_string;
+		std::vector<Token> tokens;
+		for (u32 offset = 0; offset < k_input_string.size(); ++offset) {
+			const TextEdit edit{ .offset = offset, .length = 0, .replacement = k_input_string.substr(offset, 1) };
+			input_string += edit.replacement;
+			Lexer::relex(tokens, input_string, edit).apply(tokens, input_string);
+
+			const auto expected_tokens = Lexer::tokenize(input_string);
+			ASSERT_EQ(expected_tokens.size(), tokens.size()) << input_string;
+			for (size_t index = 0; index < expected_tokens.size(); ++index) {
+				ASSERT_EQ(expected_tokens[index], tokens[index]) << input_string;
+				ASSERT_EQ(expected_tokens[index].offset, tokens[index].offset) << input_string;
+			}
 		}
 	}
 
@@ -270,20 +553,20 @@ namespace soul::lexer::ut
 		const auto            result_tokens  = Lexer::tokenize(k_input_string);
 
 		static constexpr std::array k_expected_tokens = {
-			Token(Token::Type::LiteralIdentifier, "bool"sv, SourceLocation{ 1, 0 }),
-			Token(Token::Type::LiteralIdentifier, "chr"sv, SourceLocation{ 1, 5 }),
-			Token(Token::Type::LiteralIdentifier, "f32"sv, SourceLocation{ 1, 9 }),
-			Token(Token::Type::LiteralIdentifier, "f64"sv, SourceLocation{ 1, 13 }),
-			Token(Token::Type::LiteralIdentifier, "i32"sv, SourceLocation{ 1, 17 }),
-			Token(Token::Type::LiteralIdentifier, "i64"sv, SourceLocation{ 1, 21 }),
-			Token(Token::Type::LiteralIdentifier, "str"sv, SourceLocation{ 1, 25 }),
-			Token(Token::Type::LiteralIdentifier, "void"sv, SourceLocation{ 1, 29 }),
+			Token(Token::Type::LiteralIdentifier, "bool"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "chr"sv, 5),
+			Token(Token::Type::LiteralIdentifier, "f32"sv, 9),
+			Token(Token::Type::LiteralIdentifier, "f64"sv, 13),
+			Token(Token::Type::LiteralIdentifier, "i32"sv, 17),
+			Token(Token::Type::LiteralIdentifier, "i64"sv, 21),
+			Token(Token::Type::LiteralIdentifier, "str"sv, 25),
+			Token(Token::Type::LiteralIdentifier, "void"sv, 29),
 		};
 
 		ASSERT_EQ(k_expected_tokens.size(), result_tokens.size());
 		for (size_t index = 0; index < k_expected_tokens.size(); ++index) {
 			EXPECT_EQ(k_expected_tokens[index], result_tokens[index]);
-			EXPECT_EQ(k_expected_tokens[index].location, result_tokens[index].location);
+			EXPECT_EQ(k_expected_tokens[index].offset, result_tokens[index].offset);
 		}
 	}
 }  // namespace soul::lexer::ut
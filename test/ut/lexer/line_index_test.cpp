@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "lexer/lexer.h"
+#include "lexer/line_index.h"
+
+#include <string>
+#include <string_view>
+
+namespace soul::lexer::ut
+{
+	using namespace std::string_view_literals;
+
+	class LineIndexTest : public ::testing::Test
+	{
+	};
+
+	TEST_F(LineIndexTest, EmptyString)
+	{
+		const LineIndex index{ ""sv };
+		EXPECT_EQ(index.line_count(), 1);
+		EXPECT_EQ(index.location(0), SourceLocation(1, 0));
+	}
+
+	TEST_F(LineIndexTest, NewlineKinds)
+	{
+		static constexpr auto k_input_string = "ab\ncd\r\nef\fg"sv;
+		const LineIndex       index{ k_input_string };
+
+		EXPECT_EQ(index.line_count(), 5);
+		EXPECT_EQ(index.location(0), SourceLocation(1, 0));
+		EXPECT_EQ(index.location(2), SourceLocation(1, 2));
+		EXPECT_EQ(index.location(3), SourceLocation(2, 0));
+		EXPECT_EQ(index.location(5), SourceLocation(2, 2));
+		EXPECT_EQ(index.location(6), SourceLocation(3, 0));
+		EXPECT_EQ(index.location(7), SourceLocation(4, 0));
+		EXPECT_EQ(index.location(10), SourceLocation(5, 0));
+		EXPECT_EQ(index.location(11), SourceLocation(5, 1));
+	}
+
+	TEST_F(LineIndexTest, MatchesScanning)
+	{
+		// Lines long enough to span multiple blocks when scanned with SIMD instructions.
+		std::string input_string;
+		for (std::size_t line = 0; line < 16; ++line) {
+			input_string += std::string(line * 7, ' ') + "let value_" + std::to_string(line) + " = " + std::to_string(line);
+			input_string += line % 3 == 0 ? "\r\n" : "\n";
+		}
+		const LineIndex index{ input_string };
+
+		u32 row    = 1;
+		u32 column = 0;
+		for (u32 offset = 0; offset < input_string.size(); ++offset) {
+			EXPECT_EQ(index.location(offset), SourceLocation(row, column));
+			if (input_string[offset] == '\n' || input_string[offset] == '\r') {
+				row++;
+				column = 0;
+			} else {
+				column++;
+			}
+		}
+		EXPECT_EQ(index.line_count(), row);
+	}
+
+	TEST_F(LineIndexTest, TokenLocations)
+	{
+		static constexpr auto k_input_string = "fn main() :: void\n{\n\tlet a: str = \"text\";\n}"sv;
+		const auto            tokens         = Lexer::tokenize(k_input_string);
+		const LineIndex       index{ k_input_string };
+
+		ASSERT_EQ(tokens.size(), 15);
+		EXPECT_EQ(index.location(tokens[0].offset), SourceLocation(1, 0));    // fn
+		EXPECT_EQ(index.location(tokens[7].offset), SourceLocation(3, 1));    // let
+		EXPECT_EQ(index.location(tokens[12].offset), SourceLocation(3, 14));  // "text"
+		EXPECT_EQ(index.location(tokens[14].offset), SourceLocation(4, 0));   // }
+	}
+}  // namespace soul::lexer::ut
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "lexer/lexer.h"
+#include "lexer/token_buffer.h"
+
+#include <array>
+#include <string_view>
+
+namespace soul::lexer::ut
+{
+	using namespace std::string_view_literals;
+
+	class TokenBufferTest : public ::testing::Test
+	{
+	};
+
+	TEST_F(TokenBufferTest, EmptyString)
+	{
+		const auto buffer = TokenBuffer::tokenize(""sv);
+		ASSERT_TRUE(buffer.empty());
+		EXPECT_EQ(buffer.begin(), buffer.end());
+	}
+
+	TEST_F(TokenBufferTest, MatchesTokenize)
+	{
+		static constexpr auto k_input_string
+			= "fn main() :: void\n{\n\tlet a: i32 = 5; # comment\n\ta += 2.5;\r\n\tif (a >= 2) { return; }\n}"sv;
+		const auto expected_tokens = Lexer::tokenize(k_input_string);
+		const auto buffer          = TokenBuffer::tokenize(k_input_string);
+
+		ASSERT_EQ(expected_tokens.size(), buffer.size());
+		auto it = buffer.begin();
+		for (TokenBuffer::Index index = 0; index < buffer.size(); ++index, ++it) {
+			EXPECT_EQ(expected_tokens[index], buffer[index]);
+			EXPECT_EQ(expected_tokens[index].offset, buffer.offset(index));
+			EXPECT_EQ(expected_tokens[index], *it);
+			EXPECT_EQ(expected_tokens[index].offset, (*it).offset);
+			if (expected_tokens[index].type == Token::Type::LiteralInteger) {
+				EXPECT_EQ(expected_tokens[index].integer, buffer[index].integer);
+			} else if (expected_tokens[index].type == Token::Type::LiteralFloat) {
+				EXPECT_EQ(expected_tokens[index].floating, buffer[index].floating);
+			}
+		}
+		EXPECT_EQ(it, buffer.end());
+	}
+
+	TEST_F(TokenBufferTest, Strings)
+	{
+		static constexpr auto k_input_string = "let a = \"first\";\n\"multi\nline\" \"unterminated"sv;
+		const auto            buffer         = TokenBuffer::tokenize(k_input_string);
+
+		// Offset of a string points at its opening quote, even though the quotes are not part of its data.
+		static constexpr std::array k_expected_tokens = {
+			Token(Token::Type::KeywordLet, "let"sv, 0),
+			Token(Token::Type::LiteralIdentifier, "a"sv, 4),
+			Token(Token::Type::SymbolEqual, "="sv, 6),
+			Token(Token::Type::LiteralString, "first"sv, 8),
+			Token(Token::Type::SymbolSemicolon, ";"sv, 15),
+			Token(Token::Type::LiteralString, "multi\nline"sv, 17),
+			Token(Token::Type::SpecialError, "unterminated string literal; did you forget '\"'?"sv, 30),
+		};
+
+		ASSERT_EQ(k_expected_tokens.size(), buffer.size());
+		for (TokenBuffer::Index index = 0; index < buffer.size(); ++index) {
+			EXPECT_EQ(k_expected_tokens[index], buffer[index]);
+			EXPECT_EQ(k_expected_tokens[index].offset, buffer[index].offset);
+		}
+	}
+}  // namespace soul::lexer::ut
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "lexer/lexer.h"
+#include "lexer/token_buffer.h"
+#include "lexer/token_stream.h"
+
+#include <array>
+#include <string_view>
+
+namespace soul::lexer::ut
+{
+	using namespace std::string_view_literals;
+
+	class TokenStreamTest : public ::testing::Test
+	{
+	};
+
+	TEST_F(TokenStreamTest, EmptyString)
+	{
+		TokenStream stream{ ""sv };
+		ASSERT_TRUE(stream.empty());
+		EXPECT_EQ(stream.current().type, Token::Type::SpecialEndOfFile);
+		EXPECT_EQ(stream.advance().type, Token::Type::SpecialEndOfFile);
+		EXPECT_FALSE(stream.previous().has_value());
+		EXPECT_TRUE(stream.errors().empty());
+	}
+
+	TEST_F(TokenStreamTest, MatchesTokenize)
+	{
+		static constexpr auto k_input_string = "fn main() :: void\n{\n\tlet a: i32 = 5; # comment\n\ta += 2;\n}"sv;
+		const auto            expected_tokens = Lexer::tokenize(k_input_string);
+
+		TokenStream stream{ k_input_string };
+		for (const auto& expected_token : expected_tokens) {
+			ASSERT_FALSE(stream.empty());
+			const auto token = stream.advance();
+			EXPECT_EQ(expected_token, token);
+			EXPECT_EQ(expected_token.offset, token.offset);
+			EXPECT_EQ(expected_token, stream.previous());
+		}
+		ASSERT_TRUE(stream.empty());
+
+		const auto& last_token = expected_tokens.back();
+		EXPECT_EQ(stream.current().offset, last_token.offset + last_token.data.size());
+	}
+
+	TEST_F(TokenStreamTest, Lookahead)
+	{
+		static constexpr auto k_input_string = "a b c d e"sv;
+		const auto            tokens         = Lexer::tokenize(k_input_string);
+
+		TokenStream stream{ tokens };
+		EXPECT_EQ(stream.peek(3).data, "d"sv);
+		EXPECT_EQ(stream.peek(0).data, "a"sv);
+		EXPECT_EQ(stream.advance().data, "a"sv);
+		EXPECT_EQ(stream.peek(3).data, "e"sv);
+		EXPECT_EQ(stream.current().data, "b"sv);
+		stream.skip_all();
+		EXPECT_TRUE(stream.empty());
+		EXPECT_EQ(stream.peek(2).type, Token::Type::SpecialEndOfFile);
+		ASSERT_TRUE(stream.previous().has_value());
+		EXPECT_EQ(stream.previous()->data, "e"sv);
+	}
+
+	TEST_F(TokenStreamTest, Errors)
+	{
+		static constexpr auto k_input_string = "let a = $; let b = \"unterminated"sv;
+
+		TokenStream stream{ k_input_string };
+		EXPECT_TRUE(stream.errors().empty());
+		stream.skip_all();
+
+		static constexpr std::array k_expected_errors = {
+			Token(Token::Type::SpecialError, "unrecognized token"sv, 8),
+			Token(Token::Type::SpecialError, "unterminated string literal; did you forget '\"'?"sv, 19),
+		};
+		ASSERT_EQ(k_expected_errors.size(), stream.errors().size());
+		for (size_t index = 0; index < k_expected_errors.size(); ++index) {
+			EXPECT_EQ(k_expected_errors[index], stream.errors()[index]);
+			EXPECT_EQ(k_expected_errors[index].offset, stream.errors()[index].offset);
+		}
+	}
+
+	TEST_F(TokenStreamTest, TokenBuffer)
+	{
+		static constexpr auto k_input_string = "let a: str = \"text\"; $ b += 2.5;"sv;
+		const auto            buffer         = TokenBuffer::tokenize(k_input_string);
+
+		TokenStream expected_stream{ k_input_string };
+		expected_stream.skip_all();
+
+		TokenStream stream{ buffer };
+		ASSERT_EQ(expected_stream.errors().size(), stream.errors().size());
+		EXPECT_EQ(expected_stream.errors()[0], stream.errors()[0]);
+
+		TokenStream lexer_stream{ k_input_string };
+		while (!lexer_stream.empty()) {
+			ASSERT_FALSE(stream.empty());
+			EXPECT_EQ(lexer_stream.current_type(), stream.current_type());
+			EXPECT_EQ(lexer_stream.peek(1), stream.peek(1));
+			const auto expected_token = lexer_stream.advance();
+			const auto token          = stream.advance();
+			EXPECT_EQ(expected_token, token);
+			EXPECT_EQ(expected_token.offset, token.offset);
+			EXPECT_EQ(expected_token, stream.previous());
+		}
+		ASSERT_TRUE(stream.empty());
+		EXPECT_EQ(stream.current().offset, lexer_stream.current().offset);
+		EXPECT_EQ(stream.advance().type, Token::Type::SpecialEndOfFile);
+	}
+}  // namespace soul::lexer::ut
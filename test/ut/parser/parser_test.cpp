@@ -1,12 +1,13 @@
 #include <gtest/gtest.h>
 
 #include "ast/visitors/stringify.h"
+#include "common/source_buffer.h"
 #include "lexer/lexer.h"
+#include "lexer/token_buffer.h"
 #include "parser/parser.h"
 
 #include <filesystem>
 #include <fstream>
-#include <optional>
 #include <set>
 #include <source_location>
 
@@ -25,31 +26,6 @@ namespace soul::parser::ut
 
 	class ParserTest : public ::testing::TestWithParam<Case>
 	{
-		protected:
-		std::optional<std::string> read_file(const std::filesystem::path& path)
-		try {
-			static constexpr auto k_read_size = std::size_t{ 4096 };
-
-			std::ifstream stream(path, std::ios::in | std::ios::binary);
-			stream.exceptions(std::ios::badbit);
-			if (stream.fail()) {
-				return std::nullopt;
-			}
-
-			// Read the data.
-			std::string data;  // @TODO: Reserve size.
-			std::string buffer(k_read_size, '\0');
-			while (stream.read(&buffer[0], k_read_size)) {
-				data.append(buffer, 0, stream.gcount());
-			}
-			data.append(buffer, 0, stream.gcount());
-			stream.close();
-
-			return data;
-		} catch (std::exception& e) {
-			return std::nullopt;
-		}
-
 		public:
 		static std::vector<Case> generate_cases()
 		{
@@ -89,10 +65,10 @@ namespace soul::parser::ut
 	{
 		const auto& param = GetParam();
 
-		const auto input = read_file(param.script_path);
-		ASSERT_TRUE(input.has_value()) << "failed to read: " << param.script_path;
+		const auto input = SourceBuffer::map(param.script_path);
+		ASSERT_TRUE(input.has_value()) << "failed to read: " << param.script_path << ", " << input.error().message();
 
-		const auto tokens      = Lexer::tokenize(*input);  // NOLINT(bugprone-unchecked-optional-access)
+		const auto tokens      = Lexer::tokenize((*input)->view());
 		const auto result_tree = Parser::parse("test_module", tokens);
 
 		StringifyVisitor stringify;
@@ -109,8 +85,45 @@ namespace soul::parser::ut
 				GTEST_FAIL() << "Failed to regenerate cases, because: " << e.what();
 			}
 
-		const auto expected_output = read_file(param.expected_output_path);
+		const auto expected_output = SourceBuffer::map(param.expected_output_path);
+		ASSERT_TRUE(expected_output.has_value()) << "failed to read: " << param.expected_output_path;
+		ASSERT_EQ((*expected_output)->view(), stringify.string());
+	}
+
+	TEST_P(ParserTest, AllCases_Streaming)
+	{
+		const auto& param = GetParam();
+
+		const auto input = SourceBuffer::map(param.script_path);
+		ASSERT_TRUE(input.has_value()) << "failed to read: " << param.script_path << ", " << input.error().message();
+
+		const auto result_tree = Parser::parse("test_module", *input);
+		ASSERT_TRUE(result_tree->is<ast::ModuleNode>());
+		EXPECT_EQ(*input, result_tree->as<ast::ModuleNode>().source);
+
+		StringifyVisitor stringify;
+		stringify.accept(result_tree.get());
+
+		const auto expected_output = SourceBuffer::map(param.expected_output_path);
+		ASSERT_TRUE(expected_output.has_value()) << "failed to read: " << param.expected_output_path;
+		ASSERT_EQ((*expected_output)->view(), stringify.string());
+	}
+
+	TEST_P(ParserTest, AllCases_TokenBuffer)
+	{
+		const auto& param = GetParam();
+
+		const auto input = SourceBuffer::map(param.script_path);
+		ASSERT_TRUE(input.has_value()) << "failed to read: " << param.script_path << ", " << input.error().message();
+
+		const auto tokens      = TokenBuffer::tokenize((*input)->view());
+		const auto result_tree = Parser::parse("test_module", tokens);
+
+		StringifyVisitor stringify;
+		stringify.accept(result_tree.get());
+
+		const auto expected_output = SourceBuffer::map(param.expected_output_path);
 		ASSERT_TRUE(expected_output.has_value()) << "failed to read: " << param.expected_output_path;
-		ASSERT_EQ(expected_output.value(), stringify.string());  // NOLINT(bugprone-unchecked-optional-access)
+		ASSERT_EQ((*expected_output)->view(), stringify.string());
 	}
 }  // namespace soul::parser::ut